@@ -0,0 +1,20 @@
+#include "profiler.h"
+#include <cstdlib>
+#include <new>
+
+// Замена глобальных operator new / operator delete для счетчика выделений профилировщика.
+// Остальные формы (массивы, nothrow) по стандарту вызывают эти.
+// Подключается только в приложение: библиотека расчета не должна подменять
+// распределитель памяти вызывающей программы.
+
+void *operator new(std::size_t size) {
+    Profiler::countAllocation();
+    if (void *pointer = std::malloc(size != 0 ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept { std::free(pointer); }
@@ -1,9 +1,12 @@
 #include "filehandler.h"
+#include "profiler.h"
+#include "projectreader.h"
+#include "projectwriter.h"
 #include "sapr.h"
-#include <QDateTime>
 #include <QFile>
 #include <QMessageBox>
 #include <QTextStream>
+#include <sstream>
 
 bool FileHandler::saveProject(Sapr *sapr, const QString &fileName) {
   QFile file(fileName);
@@ -12,21 +15,17 @@ bool FileHandler::saveProject(Sapr *sapr, const QString &fileName) {
     return false;
   }
 
+  // Расчетные данные записывает ProjectWriter: не измененные экземпляры
+  // подконструкций открытого файла остаются одной строкой в [Instances]
+  std::ostringstream project;
+  ProjectWriter::write(project, sapr->currentProject());
+
   QTextStream out(&file);
   out.setEncoding(QStringConverter::Utf8);
-
-  // Save header
-  out << "# SAPR Project File\n";
-  out << "# Generated on "
-      << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss") << "\n\n";
-
-  // Save anchor states
-  out << "[Anchors]\n";
-  out << "Left=" << (sapr->getLeftAnchor() ? "true" : "false") << "\n";
-  out << "Right=" << (sapr->getRightAnchor() ? "true" : "false") << "\n\n";
+  out << QString::fromStdString(project.str());
 
   // Save display settings
-  out << "[Display]\n";
+  out << "\n[Display]\n";
   if (sapr->schemaWidget) {
     out << "NodeNumbers="
         << (sapr->schemaWidget->getShowNodeNumbers() ? "true" : "false")
@@ -41,59 +40,14 @@ bool FileHandler::saveProject(Sapr *sapr, const QString &fileName) {
     out << "BarForces="
         << (sapr->schemaWidget->getShowBarForces() ? "true" : "false") << "\n";
   }
-  out << "\n";
-
-  // Save bars
-  out << "[Bars]\n";
-  out << "Count=" << sapr->getBarCount() << "\n";
-  for (int i = 0; i < sapr->getBarCount(); i++) {
-    out << "Bar" << i + 1 << "=";
-    if (sapr->getBarLength(i) == "") {
-      out << "1" << ",";
-    } else {
-      out << sapr->getBarLength(i) << ",";
-    }
-    if (sapr->getBarSurface(i) == "") {
-      out << "1" << ",";
-    } else {
-      out << sapr->getBarSurface(i) << ",";
-    }
-    if (sapr->getBarElasticModulus(i) == "") {
-      out << "1" << ",";
-    } else {
-      out << sapr->getBarElasticModulus(i) << ",";
-    }
-
-    if (sapr->getBarTensileStrength(i) == "") {
-      out << "1" << "\n";
-    } else {
-      out << sapr->getBarTensileStrength(i) << "\n";
-    }
-  }
-  out << "\n";
-
-  // Save node forces
-  out << "[NodeForces]\n";
-  QVector<double> nodeForces = sapr->getAllNodeForces();
-  out << "Count=" << nodeForces.size() << "\n";
-  for (int i = 0; i < nodeForces.size(); i++) {
-    out << "Node" << i + 1 << "=" << nodeForces[i] << "\n";
-  }
-  out << "\n";
-
-  // Save bar forces
-  out << "[BarForces]\n";
-  QVector<double> barForces = sapr->getAllBarForces();
-  out << "Count=" << barForces.size() << "\n";
-  for (int i = 0; i < barForces.size(); i++) {
-    out << "Bar" << i + 1 << "=" << barForces[i] << "\n";
-  }
 
   file.close();
   return true;
 }
 
 bool FileHandler::loadProject(Sapr *sapr, const QString &fileName) {
+  ProfileScope profile("FileHandler::loadProject");
+
   QFile file(fileName);
   if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
     QMessageBox::warning(nullptr, "Ошибка", "Не удалось открыть файл");
@@ -114,6 +68,7 @@ bool FileHandler::loadProject(Sapr *sapr, const QString &fileName) {
   bool anchorsLoaded = false;
   bool displayLoaded = false;
   bool barsLoaded = false;
+  bool needsReader = false; // Экземпляры подконструкций или общие материалы
 
   while (!in.atEnd()) {
     QString line = in.readLine().trimmed();
@@ -129,6 +84,8 @@ bool FileHandler::loadProject(Sapr *sapr, const QString &fileName) {
 
       // Start new section
       section = line.mid(1, line.length() - 2);
+      needsReader = needsReader || section == "Instances" ||
+                    section == "Materials" || section == "Sections";
       values.clear();
       continue;
     }
@@ -148,6 +105,30 @@ bool FileHandler::loadProject(Sapr *sapr, const QString &fileName) {
 
   file.close();
 
+  // Стержни экземпляров подконструкций в [Bars] не перечисляются, а стержни
+  // с общими материалами и сечениями ссылаются на них по имени: проект
+  // разворачивает ProjectReader, окно получает значения всех стержней и сил
+  if (needsReader) {
+    SaprProject project;
+    std::string error;
+    if (!ProjectReader::load(std::filesystem::u8path(fileName.toStdString()),
+                             project, &error)) {
+      QMessageBox::warning(nullptr, "Ошибка", QString::fromStdString(error));
+      return false;
+    }
+    auto text = [](double value) { return QString::number(value, 'g', 17); };
+    for (int i = 0; i < static_cast<int>(project.bars.size()); i++) {
+      const SaprProject::Bar &bar = project.bars[i];
+      sapr->setBarProperties(i, text(bar.L), text(bar.A), text(bar.E),
+                             text(bar.sigma_allow), text(bar.rho));
+    }
+    loadedNodeForces = QVector<double>(project.nodeForces.begin(),
+                                       project.nodeForces.end());
+    loadedBarForces = QVector<double>(project.barForces.begin(),
+                                      project.barForces.end());
+    sapr->loadedProject = std::move(project);
+  }
+
   // Apply the loaded forces
   if (!loadedNodeForces.isEmpty()) {
     sapr->setNodeForces(loadedNodeForces);
@@ -200,8 +181,10 @@ void FileHandler::processSection(const QString &section,
         int barIndex = it.key().mid(3).toInt() - 1;
         QStringList barData = it.value().split(',');
         if (barIndex >= 0 && barData.size() >= 4) {
+          // Плотность (пятое поле) необязательна для старых файлов
           sapr->setBarProperties(barIndex, barData[0], barData[1], barData[2],
-                                 barData[3]);
+                                 barData[3],
+                                 barData.size() >= 5 ? barData[4] : QString());
         }
       }
     }
@@ -1,8 +1,28 @@
 #include <QApplication>
+#include <QCoreApplication>
+#include <QStringList>
 #include <qapplication.h>
+#include "commandline.h"
 #include "sapr.h"
+#include <string>
+#include <vector>
 
 int main(int argc, char *argv[]) {
+    // Режимы без окна (--batch, --export, --merge, --solve-mapped) выполняет sapr_core;
+    // QCoreApplication нужен только для получения аргументов в Юникоде на всех платформах
+    for (int i = 1; i < argc; i++) {
+        QString arg(argv[i]);
+        if (arg == "--batch" || arg == "--export" || arg == "--merge" ||
+            arg == "--solve-mapped") {
+            QCoreApplication app(argc, argv);
+            std::vector<std::string> args;
+            for (const QString &value : app.arguments()) {
+                args.push_back(value.toStdString());
+            }
+            return CommandLine::run(args);
+        }
+    }
+
     QApplication app(argc, argv);
 
     Sapr window;
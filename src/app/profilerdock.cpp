@@ -0,0 +1,97 @@
+#include "profilerdock.h"
+#include "profiler.h"
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <filesystem>
+
+ProfilerDock::ProfilerDock(QWidget *parent) : QDockWidget("Профилировщик", parent) {
+    setObjectName("ProfilerDock");
+
+    QWidget *content = new QWidget(this);
+    QVBoxLayout *layout = new QVBoxLayout(content);
+
+    QHBoxLayout *controls = new QHBoxLayout();
+    recordCheck = new QCheckBox("Запись");
+    recordCheck->setChecked(Profiler::enabled());
+    QPushButton *clearButton = new QPushButton("Сбросить");
+    QPushButton *saveButton = new QPushButton("Сохранить трассу...");
+    controls->addWidget(recordCheck);
+    controls->addStretch();
+    controls->addWidget(clearButton);
+    controls->addWidget(saveButton);
+    layout->addLayout(controls);
+
+    // Сводка содержит по строке на фазу, поэтому обычная таблица с элементами достаточна
+    table = new QTableWidget(0, 7);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setHorizontalHeaderLabels(QStringList()
+                                     << "Фаза" << "Вызовов" << "Всего (мс)" << "Среднее (мс)"
+                                     << "Макс (мс)" << "Последнее (мс)" << "Выделений");
+    table->verticalHeader()->hide();
+    layout->addWidget(table);
+
+    setWidget(content);
+
+    connect(recordCheck, &QCheckBox::toggled, this,
+            [](bool checked) { Profiler::instance().setEnabled(checked); });
+    connect(clearButton, &QPushButton::clicked, this, [this]() {
+        Profiler::instance().clear();
+        refresh();
+    });
+    connect(saveButton, &QPushButton::clicked, this, &ProfilerDock::saveTrace);
+
+    // Сводка обновляется только пока панель видна
+    refreshTimer = new QTimer(this);
+    refreshTimer->setInterval(500);
+    connect(refreshTimer, &QTimer::timeout, this, &ProfilerDock::refresh);
+    connect(this, &QDockWidget::visibilityChanged, this, [this](bool visible) {
+        if (visible) {
+            refresh();
+            refreshTimer->start();
+        } else {
+            refreshTimer->stop();
+        }
+    });
+}
+
+void ProfilerDock::refresh() {
+    std::vector<Profiler::Summary> rows = Profiler::instance().summary();
+
+    table->setRowCount(static_cast<int>(rows.size()));
+    for (int i = 0; i < static_cast<int>(rows.size()); i++) {
+        const Profiler::Summary &row = rows[i];
+        double mean = row.count > 0 ? row.total / row.count : 0.0;
+        QStringList values;
+        values << QString::fromStdString(row.name) << QString::number(row.count)
+               << QString::number(row.total, 'f', 3) << QString::number(mean, 'f', 3)
+               << QString::number(row.max, 'f', 3) << QString::number(row.last, 'f', 3)
+               << QString::number(row.allocations);
+        for (int column = 0; column < values.size(); column++) {
+            QTableWidgetItem *item = table->item(i, column);
+            if (!item) {
+                item = new QTableWidgetItem();
+                table->setItem(i, column, item);
+            }
+            item->setText(values[column]);
+        }
+    }
+    table->resizeColumnsToContents();
+}
+
+void ProfilerDock::saveTrace() {
+    QString fileName = QFileDialog::getSaveFileName(this, "Сохранить трассу", "",
+                                                    "Chrome Trace (*.json)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    try {
+        Profiler::instance().saveChromeTrace(std::filesystem::path(fileName.toStdWString()));
+    } catch (const std::exception &e) {
+        QMessageBox::critical(this, "Ошибка", e.what());
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef PROFILERDOCK_H
+#define PROFILERDOCK_H
+
+#include <QCheckBox>
+#include <QDockWidget>
+#include <QTableWidget>
+#include <QTimer>
+
+// Панель профилировщика: сводка по фазам (вызовы, время, выделения памяти),
+// включение записи, сброс и сохранение трассы Chrome
+class ProfilerDock : public QDockWidget {
+    Q_OBJECT
+
+public:
+    explicit ProfilerDock(QWidget *parent = nullptr);
+
+private:
+    QCheckBox *recordCheck = nullptr;
+    QTableWidget *table = nullptr;
+    QTimer *refreshTimer = nullptr;
+
+    void refresh();
+    void saveTrace();
+};
+
+#endif // PROFILERDOCK_H
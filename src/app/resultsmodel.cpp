@@ -0,0 +1,212 @@
+#include "resultsmodel.h"
+#include <QBrush>
+#include <QColor>
+#include <QHeaderView>
+#include <algorithm>
+#include <cmath>
+
+NodeResultsModel::NodeResultsModel(QObject *parent) : QAbstractTableModel(parent) {}
+
+void NodeResultsModel::setSolution(const Solution *newSolution) {
+    beginResetModel();
+    solution = newSolution;
+    endResetModel();
+}
+
+int NodeResultsModel::rowCount(const QModelIndex &parent) const {
+    return (parent.isValid() || !solution) ? 0 : solution->nodeCount();
+}
+
+int NodeResultsModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : 6;
+}
+
+QVariant NodeResultsModel::data(const QModelIndex &index, int role) const {
+    if (!solution || !index.isValid() || index.row() >= solution->nodeCount()) {
+        return QVariant();
+    }
+
+    int i = index.row();
+    int nodeCount = solution->nodeCount();
+    bool isAnchor = (i == 0 && solution->leftAnchor) ||
+                    (i == nodeCount - 1 && solution->rightAnchor);
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case 0:
+            return QString::number(i + 1);
+        case 1:
+            return QString::number(solution->coordinates[i], 'f', 3);
+        case 2:
+            return QString::number(solution->displacements[i], 'e', 6);
+        case 3:
+            return QString::number(solution->nodalStresses[i], 'e', 6);
+        case 4:
+            // Реакция опоры определена только в заделках
+            return isAnchor ? QString::number(solution->reactions[i], 'e', 6) : QString("—");
+        case 5:
+            if (isAnchor) {
+                return QString("ЗАДЕЛКА");
+            }
+            return std::abs(solution->displacements[i]) < 1e-10 ? QString("Неподвижен")
+                                                               : QString("Свободен");
+        }
+    } else if (role == Qt::BackgroundRole && index.column() == 5) {
+        if (isAnchor) {
+            return QBrush(QColor(200, 200, 200));
+        }
+        return std::abs(solution->displacements[i]) < 1e-10 ? QBrush(QColor(173, 216, 230))
+                                                           : QBrush(QColor(144, 238, 144));
+    }
+    return QVariant();
+}
+
+QVariant NodeResultsModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    if (orientation == Qt::Vertical) {
+        return section + 1;
+    }
+    static const char *const titles[] = {"Узел",            "Координата (м)", "Перемещение (м)",
+                                         "Напряжение (Па)", "Реакция (Н)",    "Статус"};
+    return (section >= 0 && section < 6) ? QString(titles[section]) : QVariant();
+}
+
+StrengthResultsModel::StrengthResultsModel(QObject *parent) : QAbstractTableModel(parent) {}
+
+void StrengthResultsModel::setSolution(const Solution *newSolution) {
+    beginResetModel();
+    solution = newSolution;
+    rebuildRows();
+    endResetModel();
+}
+
+void StrengthResultsModel::setOverloadedOnly(bool enabled) {
+    if (overloadedOnly == enabled) {
+        return;
+    }
+    beginResetModel();
+    overloadedOnly = enabled;
+    rebuildRows();
+    endResetModel();
+}
+
+int StrengthResultsModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(rows.size());
+}
+
+int StrengthResultsModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant StrengthResultsModel::data(const QModelIndex &index, int role) const {
+    if (!solution || !index.isValid() || index.row() >= static_cast<int>(rows.size())) {
+        return QVariant();
+    }
+
+    const StrengthCheck &check = solution->strength[rows[index.row()]];
+    bool overloaded = check.utilization > 1.0;
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case Rod:
+            return QString::number(check.rod + 1);
+        case MaxStress:
+            return QString::number(check.maxStress, 'e', 6);
+        case Allowed:
+            return QString::number(check.allowedStress, 'e', 6);
+        case Utilization:
+            return QString::number(check.utilization, 'f', 3);
+        case Reserve:
+            return std::isinf(check.reserveFactor) ? QString("∞")
+                                                   : QString::number(check.reserveFactor, 'f', 3);
+        case Critical:
+            return QString::number(check.criticalCoordinate, 'f', 3);
+        case Status:
+            return overloaded ? QString("ПРЕВЫШЕНИЕ!") : QString("НОРМА");
+        }
+    } else if (index.column() == Status) {
+        if (role == Qt::BackgroundRole) {
+            return overloaded ? QBrush(QColor(255, 0, 0)) : QBrush(QColor(144, 238, 144));
+        }
+        if (role == Qt::ForegroundRole && overloaded) {
+            return QBrush(QColor(255, 255, 255));
+        }
+    }
+    return QVariant();
+}
+
+QVariant StrengthResultsModel::headerData(int section, Qt::Orientation orientation,
+                                          int role) const {
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    if (orientation == Qt::Vertical) {
+        return section + 1;
+    }
+    static const char *const titles[] = {"Стержень", "max |σ| (Па)",        "Допустимое (Па)",
+                                         "Использование", "Запас", "Опасное сечение (м)",
+                                         "Статус"};
+    return (section >= 0 && section < ColumnCount) ? QString(titles[section]) : QVariant();
+}
+
+void StrengthResultsModel::sort(int column, Qt::SortOrder order) {
+    beginResetModel();
+    sortColumn = column;
+    sortOrder = order;
+    sortRows();
+    endResetModel();
+}
+
+void StrengthResultsModel::rebuildRows() {
+    rows.clear();
+    if (!solution) {
+        return;
+    }
+    for (const StrengthCheck &check : solution->strength) {
+        if (!overloadedOnly || check.utilization > 1.0) {
+            rows.push_back(check.rod);
+        }
+    }
+    sortRows();
+}
+
+void StrengthResultsModel::sortRows() {
+    if (!solution) {
+        return;
+    }
+
+    // Ключ сортировки столбца; статус упорядочивается так же, как использование
+    auto key = [this](int rod) {
+        const StrengthCheck &check = solution->strength[rod];
+        switch (sortColumn) {
+        case MaxStress:
+            return check.maxStress;
+        case Allowed:
+            return check.allowedStress;
+        case Utilization:
+        case Status:
+            return check.utilization;
+        case Reserve:
+            return check.reserveFactor;
+        case Critical:
+            return check.criticalCoordinate;
+        default:
+            return static_cast<double>(rod);
+        }
+    };
+
+    if (sortOrder == Qt::AscendingOrder) {
+        std::stable_sort(rows.begin(), rows.end(),
+                         [&](int a, int b) { return key(a) < key(b); });
+    } else {
+        std::stable_sort(rows.begin(), rows.end(),
+                         [&](int a, int b) { return key(a) > key(b); });
+    }
+}
+
+void resizeColumnsFromSample(QTableView *view, int sampleRows) {
+    view->horizontalHeader()->setResizeContentsPrecision(sampleRows);
+    view->resizeColumnsToContents();
+}
@@ -0,0 +1,68 @@
+#ifndef RESULTSMODEL_H
+#define RESULTSMODEL_H
+
+#include "solution.h"
+#include <QAbstractTableModel>
+#include <QTableView>
+#include <vector>
+
+// Модели таблиц результатов поверх массивов Solution. Элементы таблицы не создаются:
+// текст ячейки формируется в data() только для видимых строк, поэтому объем памяти
+// и время обновления не зависят от числа узлов. Solution принадлежит окну; после
+// его замены нужно снова вызвать setSolution().
+
+// Узлы: номер, координата, перемещение, напряжение, реакция, статус
+class NodeResultsModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    explicit NodeResultsModel(QObject *parent = nullptr);
+
+    void setSolution(const Solution *solution);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+private:
+    const Solution *solution = nullptr;
+};
+
+// Проверка прочности по стержням. Строки отображаются через таблицу номеров,
+// поэтому фильтр превышений и сортировка не копируют результаты.
+class StrengthResultsModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column { Rod, MaxStress, Allowed, Utilization, Reserve, Critical, Status, ColumnCount };
+
+    explicit StrengthResultsModel(QObject *parent = nullptr);
+
+    void setSolution(const Solution *solution);
+    void setOverloadedOnly(bool overloadedOnly); // Только строки с коэффициентом > 1
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+private:
+    const Solution *solution = nullptr;
+    bool overloadedOnly = false;
+    int sortColumn = Rod;
+    Qt::SortOrder sortOrder = Qt::AscendingOrder;
+    std::vector<int> rows; // Номера стержней в порядке отображения
+
+    void rebuildRows();
+    void sortRows();
+};
+
+// Ширина столбцов по заголовку, видимым строкам и не более чем sampleRows остальным,
+// а не по всем строкам таблицы
+void resizeColumnsFromSample(QTableView *view, int sampleRows = 100);
+
+#endif // RESULTSMODEL_H
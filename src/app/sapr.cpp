@@ -1,13 +1,30 @@
 #include "sapr.h"
 #include "filehandler.h"
+#include "materiallibrary.h"
+#include "profiler.h"
+#include "profilerdock.h"
+#include "rodsystemdynamics.h"
+#include "rodsystemoptimizer.h"
+#include "rodsystemstochastic.h"
+#include "solutionexporter.h"
 #include "ui_sapr.h"
 #include <QApplication>
+#include <QDialog>
+#include <QDialogButtonBox>
 #include <QDoubleValidator>
 #include <QFileDialog>
+#include <QHeaderView>
 #include <QLabel>
+#include <QMenu>
+#include <QMenuBar>
 #include <QMessageBox>
 #include <QPainter>
 #include <QPushButton>
+#include <QTableWidget>
+#include <QVBoxLayout>
+#include <filesystem>
+#include <fstream>
+#include <limits>
 
 // Public getters for FileHandler
 bool Sapr::getLeftAnchor() const { return ui->checkBoxLeft->isChecked(); }
@@ -31,11 +48,16 @@ QString Sapr::getBarTensileStrength(int index) const {
                                                                : "";
 }
 
+QString Sapr::getBarDensity(int index) const {
+    return (index >= 0 && index < densityEdits.size()) ? densityEdits[index]->text() : "";
+}
+
 // Public setters for FileHandler
 void Sapr::setLeftAnchor(bool anchored) { ui->checkBoxLeft->setChecked(anchored); }
 void Sapr::setRightAnchor(bool anchored) { ui->checkBoxRight->setChecked(anchored); }
 
 void Sapr::clearAllBars() {
+    loadedProject = SaprProject();
     while (barCount > 0) {
         removeBar(0);
     }
@@ -44,7 +66,8 @@ void Sapr::clearAllBars() {
 void Sapr::addBar() { on_BarsAdd_clicked(); }
 
 void Sapr::setBarProperties(int index, const QString &length, const QString &surface,
-                            const QString &elasticModulus, const QString &tensileStrength) {
+                            const QString &elasticModulus, const QString &tensileStrength,
+                            const QString &density) {
     if (index >= 0 && index < barCount) {
         if (index < lengthEdits.size())
             lengthEdits[index]->setText(length);
@@ -54,11 +77,85 @@ void Sapr::setBarProperties(int index, const QString &length, const QString &sur
             elasticModulusEdits[index]->setText(elasticModulus);
         if (index < tensileStrengthEdits.size())
             tensileStrengthEdits[index]->setText(tensileStrength);
+        if (index < densityEdits.size() && !density.isEmpty())
+            densityEdits[index]->setText(density);
     }
 }
 
 void Sapr::setNodeForces(const QVector<double> &forces) { savedNodeForces = forces; }
 
+namespace {
+
+// Значение поля окна: прочитанное из файла, если поле показывает именно его (не изменялось),
+// иначе разобранный текст поля; пустое поле - empty, нечисловое - invalid
+double fieldValue(const QString &text, const double *loaded, char format, int precision,
+                  double empty, double invalid) {
+    if (loaded && text == QString::number(*loaded, format, precision)) {
+        return *loaded;
+    }
+    if (text.isEmpty()) {
+        return empty;
+    }
+    bool ok;
+    double value = text.toDouble(&ok);
+    return ok ? value : invalid;
+}
+
+} // namespace
+
+SaprProject Sapr::currentProject() {
+    SaprProject project;
+    project.leftAnchor = getLeftAnchor();
+    project.rightAnchor = getRightAnchor();
+    project.substructures = loadedProject.substructures;
+    project.instances = loadedProject.instances;
+    project.materials = loadedProject.materials;
+    project.sections = loadedProject.sections;
+
+    // Поля стержней заполняются при открытии с 17 значащими цифрами, силы показываются
+    // с тремя знаками после запятой: не измененные поля сохраняют прочитанные значения
+    // точно, и ProjectWriter узнает в них экземпляры подконструкций. Пустые поля
+    // записываются теми же значениями, что и раньше (1, плотность стали)
+    project.bars.resize(barCount);
+    for (int i = 0; i < barCount; i++) {
+        const SaprProject::Bar *loaded = i < static_cast<int>(loadedProject.bars.size())
+                                             ? &loadedProject.bars[i]
+                                             : nullptr;
+        SaprProject::Bar &bar = project.bars[i];
+        bar.L = fieldValue(getBarLength(i), loaded ? &loaded->L : nullptr, 'g', 17, 1.0, 0.0);
+        bar.A = fieldValue(getBarSurface(i), loaded ? &loaded->A : nullptr, 'g', 17, 1.0, 0.0);
+        bar.E = fieldValue(getBarElasticModulus(i), loaded ? &loaded->E : nullptr, 'g', 17, 1.0,
+                           0.0);
+        bar.sigma_allow = fieldValue(getBarTensileStrength(i),
+                                     loaded ? &loaded->sigma_allow : nullptr, 'g', 17, 1.0, 200e6);
+        bar.rho = fieldValue(getBarDensity(i), loaded ? &loaded->rho : nullptr, 'g', 17, 7850.0,
+                             7850.0);
+        // Ссылки на библиотеку; ProjectWriter пишет имя записи, только если значения
+        // стержня с ней совпадают, иначе - значения стержня
+        if (loaded) {
+            bar.material = loaded->material;
+            bar.section = loaded->section;
+        }
+    }
+
+    auto forces = [](const QVector<QLineEdit *> &edits, const std::vector<double> &loaded,
+                     int size) {
+        std::vector<double> values(size, 0.0);
+        for (int i = 0; i < size && i < edits.size(); i++) {
+            if (edits[i]) {
+                values[i] = fieldValue(edits[i]->text(),
+                                       i < static_cast<int>(loaded.size()) ? &loaded[i] : nullptr,
+                                       'f', 3, 0.0, 0.0);
+            }
+        }
+        return values;
+    };
+    project.nodeForces = forces(nodeForcesEdits, loadedProject.nodeForces,
+                                barCount > 0 ? barCount + 1 : 0);
+    project.barForces = forces(barForcesEdits, loadedProject.barForces, barCount);
+    return project;
+}
+
 void Sapr::setBarForces(const QVector<double> &forces) { savedBarForces = forces; }
 
 Sapr::Sapr(QWidget *parent)
@@ -198,10 +295,23 @@ Sapr::Sapr(QWidget *parent)
     schemaLayout->addWidget(schemaContainer);
 
     setupResultsTables();
+
+    // Панель профилировщика скрыта по умолчанию и открывается из меню "Вид"
+    ProfilerDock *profilerDock = new ProfilerDock(this);
+    addDockWidget(Qt::RightDockWidgetArea, profilerDock);
+    profilerDock->hide();
+    QMenu *viewMenu = menuBar()->addMenu("Вид");
+    viewMenu->addAction(profilerDock->toggleViewAction());
+
+    QMenu *libraryMenu = menuBar()->addMenu("Библиотека");
+    QAction *libraryAction = libraryMenu->addAction("Материалы и сечения...");
+    connect(libraryAction, &QAction::triggered, this, &Sapr::editLibrary);
 }
 
 bool firstAdd = true;
 void Sapr::on_BarsAdd_clicked() {
+    ProfileScope profile("Sapr::on_BarsAdd_clicked");
+
     saveNodeForces();
     saveBarForces();
 
@@ -213,6 +323,7 @@ void Sapr::on_BarsAdd_clicked() {
         headerSurface = new QLabel("Площадь (A)");
         headerElasticModulus = new QLabel("Модуль упр. (E)");
         headerTensileStrength = new QLabel("Допустимые напряжения (σ)");
+        headerDensity = new QLabel("Плотность (ρ)");
 
         headerNumber->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
         headerLength->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
@@ -220,6 +331,7 @@ void Sapr::on_BarsAdd_clicked() {
         headerSurface->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
         headerElasticModulus->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
         headerTensileStrength->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
+        headerDensity->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
         headerAction->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
 
         // Set word wrap for labels with spaces
@@ -227,6 +339,7 @@ void Sapr::on_BarsAdd_clicked() {
         headerSurface->setWordWrap(true);
         headerElasticModulus->setWordWrap(true);
         headerTensileStrength->setWordWrap(true);
+        headerDensity->setWordWrap(true);
 
         headerNumber->setMinimumWidth(30);
         headerLength->setMinimumWidth(30);
@@ -234,6 +347,7 @@ void Sapr::on_BarsAdd_clicked() {
         headerSurface->setMinimumWidth(30);
         headerElasticModulus->setMinimumWidth(30);
         headerTensileStrength->setMinimumWidth(30);
+        headerDensity->setMinimumWidth(30);
         headerAction->setMinimumWidth(30);
 
         ui->BarsGrid->addWidget(headerNumber, 0, 0);
@@ -242,7 +356,8 @@ void Sapr::on_BarsAdd_clicked() {
         ui->BarsGrid->addWidget(headerSurface, 0, 3);
         ui->BarsGrid->addWidget(headerElasticModulus, 0, 4);
         ui->BarsGrid->addWidget(headerTensileStrength, 0, 5);
-        ui->BarsGrid->addWidget(headerAction, 0, 6);
+        ui->BarsGrid->addWidget(headerDensity, 0, 6);
+        ui->BarsGrid->addWidget(headerAction, 0, 7);
 
         ui->BarsGrid->setRowStretch(0, 0);
 
@@ -259,6 +374,7 @@ void Sapr::on_BarsAdd_clicked() {
     QLineEdit *surfaceEdit = new QLineEdit();
     QLineEdit *elasticModulusEdit = new QLineEdit();
     QLineEdit *tensileStrengthEdit = new QLineEdit();
+    QLineEdit *densityEdit = new QLineEdit();
     QLabel *startPointLabel = new QLabel("0.0");
     QPushButton *deleteButton = new QPushButton("Удалить");
 
@@ -280,6 +396,10 @@ void Sapr::on_BarsAdd_clicked() {
     tensileStrengthEdit->setValidator(tensileStrengthValidator);
     tensileStrengthEdit->setPlaceholderText("Па");
 
+    QDoubleValidator *densityValidator = new QDoubleValidator(0.0, 100000.0, 3, densityEdit);
+    densityEdit->setValidator(densityValidator);
+    densityEdit->setPlaceholderText("кг/м³");
+
     deleteButton->setStyleSheet("QPushButton { background-color: #ff6b6b; color: white; border: "
                                 "none; padding: 2px 8px; font-size: 11px; }"
                                 "QPushButton:hover { background-color: #ff5252; }");
@@ -290,6 +410,7 @@ void Sapr::on_BarsAdd_clicked() {
     surfaceEdits.append(surfaceEdit);
     elasticModulusEdits.append(elasticModulusEdit);
     tensileStrengthEdits.append(tensileStrengthEdit);
+    densityEdits.append(densityEdit);
     startPointLabels.append(startPointLabel);
     deleteButtons.append(deleteButton);
 
@@ -304,6 +425,7 @@ void Sapr::on_BarsAdd_clicked() {
     surfaceEdit->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
     elasticModulusEdit->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
     tensileStrengthEdit->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
+    densityEdit->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
     startPointLabel->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
     deleteButton->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Fixed);
 
@@ -312,6 +434,7 @@ void Sapr::on_BarsAdd_clicked() {
     surfaceEdit->setMinimumHeight(30);
     elasticModulusEdit->setMinimumHeight(30);
     tensileStrengthEdit->setMinimumHeight(30);
+    densityEdit->setMinimumHeight(30);
     startPointLabel->setMinimumHeight(30);
     deleteButton->setMinimumHeight(30);
 
@@ -320,6 +443,7 @@ void Sapr::on_BarsAdd_clicked() {
     surfaceEdit->setMinimumWidth(50);
     elasticModulusEdit->setMinimumWidth(50);
     tensileStrengthEdit->setMinimumWidth(50);
+    densityEdit->setMinimumWidth(50);
     startPointLabel->setMinimumWidth(50);
     deleteButton->setMinimumWidth(60);
 
@@ -329,7 +453,8 @@ void Sapr::on_BarsAdd_clicked() {
     ui->BarsGrid->addWidget(surfaceEdit, row, 3);
     ui->BarsGrid->addWidget(elasticModulusEdit, row, 4);
     ui->BarsGrid->addWidget(tensileStrengthEdit, row, 5);
-    ui->BarsGrid->addWidget(deleteButton, row, 6);
+    ui->BarsGrid->addWidget(densityEdit, row, 6);
+    ui->BarsGrid->addWidget(deleteButton, row, 7);
 
     ui->BarsGrid->setRowStretch(row, 0);
 
@@ -401,6 +526,37 @@ void Sapr::removeBar(int index) {
     if (index < 0 || index >= numberLabels.size())
         return;
 
+    // Прочитанные стержни сдвигаются вместе с окном; экземпляр подконструкции
+    // с удаленным стержнем больше не записывается компактно
+    if (index < static_cast<int>(loadedProject.bars.size())) {
+        loadedProject.bars.erase(loadedProject.bars.begin() + index);
+    }
+    if (index < static_cast<int>(loadedProject.barForces.size())) {
+        loadedProject.barForces.erase(loadedProject.barForces.begin() + index);
+    }
+    // Силы в узлах остаются на своих номерах, как savedNodeForces ниже
+    std::vector<double> &loadedNodeForces = loadedProject.nodeForces;
+    for (int node = index; node <= index + 1; node++) {
+        if (node < static_cast<int>(loadedNodeForces.size())) {
+            loadedNodeForces[node] = 0.0;
+        }
+    }
+    if (!loadedNodeForces.empty()) {
+        loadedNodeForces.pop_back();
+    }
+    std::vector<SaprProject::Instance> instances;
+    for (SaprProject::Instance instance : loadedProject.instances) {
+        int size = static_cast<int>(loadedProject.substructures[instance.substructure].bars.size());
+        if (index >= instance.firstBar && index < instance.firstBar + size) {
+            continue;
+        }
+        if (instance.firstBar > index) {
+            instance.firstBar--;
+        }
+        instances.push_back(instance);
+    }
+    loadedProject.instances = instances;
+
     saveNodeForces();
     saveBarForces();
 
@@ -411,6 +567,7 @@ void Sapr::removeBar(int index) {
     delete surfaceEdits[index];
     delete elasticModulusEdits[index];
     delete tensileStrengthEdits[index];
+    delete densityEdits[index];
     delete deleteButtons[index];
 
     // Remove from vectors
@@ -420,6 +577,7 @@ void Sapr::removeBar(int index) {
     surfaceEdits.remove(index);
     elasticModulusEdits.remove(index);
     tensileStrengthEdits.remove(index);
+    densityEdits.remove(index);
     deleteButtons.remove(index);
 
     barCount--;
@@ -431,6 +589,7 @@ void Sapr::removeBar(int index) {
         delete headerSurface;
         delete headerElasticModulus;
         delete headerTensileStrength;
+        delete headerDensity;
         delete headerStartPoint;
         delete headerAction;
         headerNumber = nullptr;
@@ -438,6 +597,7 @@ void Sapr::removeBar(int index) {
         headerSurface = nullptr;
         headerElasticModulus = nullptr;
         headerTensileStrength = nullptr;
+        headerDensity = nullptr;
         headerStartPoint = nullptr;
         headerAction = nullptr;
         firstAdd = true;
@@ -503,7 +663,8 @@ void Sapr::removeBar(int index) {
         ui->BarsGrid->addWidget(headerSurface, 0, 3);
         ui->BarsGrid->addWidget(headerElasticModulus, 0, 4);
         ui->BarsGrid->addWidget(headerTensileStrength, 0, 5);
-        ui->BarsGrid->addWidget(headerAction, 0, 4);
+        ui->BarsGrid->addWidget(headerDensity, 0, 6);
+        ui->BarsGrid->addWidget(headerAction, 0, 7);
 
         for (int i = 0; i < numberLabels.size(); i++) {
             int row = i + 1;
@@ -518,7 +679,8 @@ void Sapr::removeBar(int index) {
             ui->BarsGrid->addWidget(surfaceEdits[i], row, 3);
             ui->BarsGrid->addWidget(elasticModulusEdits[i], row, 4);
             ui->BarsGrid->addWidget(tensileStrengthEdits[i], row, 5);
-            ui->BarsGrid->addWidget(deleteButtons[i], row, 6);
+            ui->BarsGrid->addWidget(densityEdits[i], row, 6);
+            ui->BarsGrid->addWidget(deleteButtons[i], row, 7);
 
             ui->BarsGrid->setRowStretch(row, 0);
         }
@@ -582,6 +744,8 @@ void Sapr::setupNodeForcesHeaders() {
 }
 
 void Sapr::updateNodeForces(bool skipSave) {
+    ProfileScope profile("Sapr::updateNodeForces");
+
     // Safety check
     if (!nodeForcesGrid)
         return;
@@ -975,15 +1139,33 @@ void Sapr::setupResultsTables() {
     QVBoxLayout *tableLayout = new QVBoxLayout(ui->TableTab);
 
     // Таблица перемещений и усилий
-    resultsTable = new QTableWidget();
+    // Таблицы отображают Solution через модели: ячейки не создаются заранее
+    nodeResultsModel = new NodeResultsModel(this);
+    resultsTable = new QTableView();
+    resultsTable->setModel(nodeResultsModel);
     resultsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     tableLayout->addWidget(new QLabel("<h3>Результаты расчетов</h3>"));
     tableLayout->addWidget(resultsTable);
 
-    // Таблица напряжений
-    stressTable = new QTableWidget();
+    // Таблица проверки прочности по стержням
+    strengthResultsModel = new StrengthResultsModel(this);
+    stressTable = new QTableView();
+    stressTable->setModel(strengthResultsModel);
     stressTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    stressTable->setSortingEnabled(true);
+    stressTable->sortByColumn(StrengthResultsModel::Rod, Qt::AscendingOrder);
     tableLayout->addWidget(new QLabel("<h3>Напряжения и проверка прочности</h3>"));
+
+    // Фильтр и сортировка работают по сохраненным результатам, без повторного расчета
+    QHBoxLayout *stressControls = new QHBoxLayout();
+    overloadedOnlyCheck = new QCheckBox("Только превышения");
+    sortByUtilizationCheck = new QCheckBox("Сортировать по коэффициенту использования");
+    connect(overloadedOnlyCheck, &QCheckBox::toggled, this, &Sapr::fillStressTable);
+    connect(sortByUtilizationCheck, &QCheckBox::toggled, this, &Sapr::fillStressTable);
+    stressControls->addWidget(overloadedOnlyCheck);
+    stressControls->addWidget(sortByUtilizationCheck);
+    stressControls->addStretch();
+    tableLayout->addLayout(stressControls);
     tableLayout->addWidget(stressTable);
 
     // Кнопка для выполнения расчетов
@@ -992,9 +1174,89 @@ void Sapr::setupResultsTables() {
                                    "font-weight: bold; padding: 8px; }");
     connect(calculateButton, &QPushButton::clicked, this, &Sapr::performCalculations);
     tableLayout->addWidget(calculateButton);
+
+    // Кнопка динамического расчета (собственные частоты и переходный процесс)
+    QPushButton *dynamicsButton = new QPushButton("Динамический расчет");
+    dynamicsButton->setStyleSheet("QPushButton { background-color: #2196F3; color: white; "
+                                  "font-weight: bold; padding: 8px; }");
+    connect(dynamicsButton, &QPushButton::clicked, this, &Sapr::performDynamicAnalysis);
+    tableLayout->addWidget(dynamicsButton);
+
+    // Кнопка подбора сечений минимальной массы
+    QPushButton *optimizeButton = new QPushButton("Оптимизация сечений");
+    optimizeButton->setStyleSheet("QPushButton { background-color: #FF9800; color: white; "
+                                  "font-weight: bold; padding: 8px; }");
+    connect(optimizeButton, &QPushButton::clicked, this, &Sapr::performOptimization);
+    tableLayout->addWidget(optimizeButton);
+
+    // Кнопка вероятностного расчета (разброс свойств и нагрузок)
+    QPushButton *monteCarloButton = new QPushButton("Вероятностный расчет");
+    monteCarloButton->setStyleSheet("QPushButton { background-color: #9C27B0; color: white; "
+                                    "font-weight: bold; padding: 8px; }");
+    connect(monteCarloButton, &QPushButton::clicked, this, &Sapr::performMonteCarlo);
+    tableLayout->addWidget(monteCarloButton);
+
+    // Кнопка экспорта последнего результата расчета
+    QPushButton *exportButton = new QPushButton("Экспорт результатов");
+    exportButton->setStyleSheet("QPushButton { background-color: #607D8B; color: white; "
+                                "font-weight: bold; padding: 8px; }");
+    connect(exportButton, &QPushButton::clicked, this, &Sapr::exportResults);
+    tableLayout->addWidget(exportButton);
     tableLayout->addStretch();
 }
 
+void Sapr::validateBars() {
+    // Проверка базовых условий
+    if (barCount == 0) {
+        throw std::runtime_error("Нет стержней для расчета");
+    }
+
+    if (!ui->checkBoxLeft->isChecked() && !ui->checkBoxRight->isChecked()) {
+        throw std::runtime_error("Система должна иметь хотя бы одну заделку");
+    }
+
+    // Проверяем данные стержней
+    for (int i = 0; i < barCount; i++) {
+        double L = getLengthValue(i);
+        double A = getSurfaceValue(i);
+        double E = getElasticModulusValue(i);
+
+        if (L <= 0)
+            throw std::runtime_error(QString("Стержень %1: длина должна быть положительной")
+                                         .arg(i + 1)
+                                         .toStdString());
+        if (A <= 0)
+            throw std::runtime_error(QString("Стержень %1: площадь должна быть положительной")
+                                         .arg(i + 1)
+                                         .toStdString());
+        if (E <= 0)
+            throw std::runtime_error(
+                QString("Стержень %1: модуль упругости должен быть положительным")
+                    .arg(i + 1)
+                    .toStdString());
+    }
+}
+
+void Sapr::fillCalculator(RodSystemCalculator &calc) {
+    // Устанавливаем параметры стержней
+    for (int i = 0; i < barCount; i++) {
+        double L = getLengthValue(i);
+        double A = getSurfaceValue(i);
+        double E = getElasticModulusValue(i);
+        double sigma_allow = getTensileStrengthValue(i);
+        double q = getBarForces(i);
+
+        calc.setRod(i + 1, L, A, E, q, sigma_allow);
+        calc.setRodDensity(i + 1, getDensityValue(i));
+    }
+
+    // Устанавливаем сосредоточенные силы
+    QVector<double> nodeForces = getAllNodeForces();
+    for (int i = 0; i < nodeForces.size(); i++) {
+        calc.setForce(i + 1, nodeForces[i]);
+    }
+}
+
 void Sapr::performCalculations() {
 
     // Защита от повторного входа
@@ -1004,70 +1266,22 @@ void Sapr::performCalculations() {
 
     calculationInProgress = true;
 
-    // Временные переменные для результатов
-    std::vector<double> displacements, forces, stresses;
     bool success = false;
 
     try {
-        // Проверка базовых условий
-        if (barCount == 0) {
-            throw std::runtime_error("Нет стержней для расчета");
-        }
-
-        if (!ui->checkBoxLeft->isChecked() && !ui->checkBoxRight->isChecked()) {
-            throw std::runtime_error("Система должна иметь хотя бы одну заделку");
-        }
-
-        // Проверяем данные стержней
-        for (int i = 0; i < barCount; i++) {
-            double L = getLengthValue(i);
-            double A = getSurfaceValue(i);
-            double E = getElasticModulusValue(i);
-
-            if (L <= 0)
-                throw std::runtime_error(QString("Стержень %1: длина должна быть положительной")
-                                             .arg(i + 1)
-                                             .toStdString());
-            if (A <= 0)
-                throw std::runtime_error(QString("Стержень %1: площадь должна быть положительной")
-                                             .arg(i + 1)
-                                             .toStdString());
-            if (E <= 0)
-                throw std::runtime_error(
-                    QString("Стержень %1: модуль упругости должен быть положительным")
-                        .arg(i + 1)
-                        .toStdString());
-        }
-
-        // Удаляем старый калькулятор ПЕРЕД созданием нового
-        if (calculator) {
-            delete calculator;
-            calculator = nullptr;
-        }
-
-        // Создаем новый калькулятор
-        calculator = new RodSystemCalculator(barCount + 1);
-
-        // Устанавливаем параметры стержней
-        for (int i = 0; i < barCount; i++) {
-            double L = getLengthValue(i);
-            double A = getSurfaceValue(i);
-            double E = getElasticModulusValue(i);
-            double sigma_allow = getTensileStrengthValue(i);
-            double q = getBarForces(i);
+        validateBars();
 
-            calculator->setRod(i + 1, L, A, E, q, sigma_allow);
+        // Калькулятор пересоздается только при изменении числа узлов,
+        // иначе повторный расчет использует его рабочие буферы без выделения памяти
+        if (!calculator || calculator->getNodeCount() != barCount + 1) {
+            calculator = std::make_unique<RodSystemCalculator>(barCount + 1);
         }
 
-        // Устанавливаем сосредоточенные силы
-        QVector<double> nodeForces = getAllNodeForces();
-        for (int i = 0; i < nodeForces.size(); i++) {
-            calculator->setForce(i + 1, nodeForces[i]);
-        }
+        fillCalculator(*calculator);
 
-        // Выполняем расчет
-        calculator->calculate(displacements, forces, stresses, ui->checkBoxLeft->isChecked(),
-                              ui->checkBoxRight->isChecked());
+        // Расчет вместе с реакциями, сечениями и проверкой прочности: результат
+        // перемещается в окно и используется таблицами и экспортом без пересчета
+        solution = calculator->solve(ui->checkBoxLeft->isChecked(), ui->checkBoxRight->isChecked());
 
         success = true;
 
@@ -1078,18 +1292,24 @@ void Sapr::performCalculations() {
         QMessageBox::critical(this, "Ошибка расчета", "Неизвестная ошибка при расчете");
     }
 
-    // Очищаем калькулятор независимо от результата
-    if (calculator) {
-        delete calculator;
-        calculator = nullptr;
-    }
-
     // Обновляем таблицы только если расчет успешен
-    if (success && !displacements.empty()) {
+    if (success && !solution.displacements.empty()) {
         try {
-            updateResultsTables(displacements, forces, stresses);
-            QMessageBox::information(this, "Расчет завершен",
-                                     "Расчеты успешно выполнены и отображены в таблицах.");
+            updateResultsTables(solution);
+
+            const SolveDiagnostics &report = solution.diagnostics;
+            QString message = "Расчеты успешно выполнены и отображены в таблицах.\n\n";
+            message += QString("Оценка числа обусловленности: %1\n")
+                           .arg(report.conditionEstimate, 0, 'g', 3);
+            message += QString("Невязка равновесия узлов: %1\n")
+                           .arg(report.equilibriumResidual, 0, 'g', 3);
+            message += QString("Невязка равновесия системы (реакции и нагрузки): %1\n")
+                           .arg(report.globalResidual, 0, 'g', 3);
+            message += QString("Время расчета: %1 мс").arg(solution.timings.total, 0, 'f', 3);
+            if (report.conditionEstimate * std::numeric_limits<double>::epsilon() > 1e-6) {
+                message += "\n\nСистема плохо обусловлена: точность результатов снижена.";
+            }
+            QMessageBox::information(this, "Расчет завершен", message);
         } catch (const std::exception &e) {
             QMessageBox::critical(this, "Ошибка отображения",
                                   QString("Ошибка при обновлении таблиц: %1").arg(e.what()));
@@ -1099,106 +1319,325 @@ void Sapr::performCalculations() {
     calculationInProgress = false;
 }
 
-void Sapr::updateResultsTables(const std::vector<double> &displacements,
-                               const std::vector<double> &forces,
-                               const std::vector<double> &stresses) {
+void Sapr::performDynamicAnalysis() {
+    if (calculationInProgress) {
+        return;
+    }
 
-    // Проверка указателей таблиц
-    if (!resultsTable || !stressTable) {
+    calculationInProgress = true;
+
+    try {
+        validateBars();
+
+        RodSystemCalculator calc(barCount + 1);
+        fillCalculator(calc);
+
+        RodSystemDynamics dynamics(calc, ui->checkBoxLeft->isChecked(),
+                                   ui->checkBoxRight->isChecked());
+        std::vector<RodSystemDynamics::Mode> modes = dynamics.computeModes(5);
+
+        QString report = "Собственные частоты продольных колебаний:\n";
+        for (size_t i = 0; i < modes.size(); i++) {
+            report += QString("%1: ω = %2 рад/с, f = %3 Гц\n")
+                          .arg(i + 1)
+                          .arg(modes[i].omega, 0, 'e', 6)
+                          .arg(modes[i].frequency, 0, 'e', 6);
+        }
+        QMessageBox::information(this, "Динамический расчет", report);
+
+        // Переходный процесс при внезапном приложении нагрузки
+        QString fileName = QFileDialog::getSaveFileName(
+            this, "Сохранить переходный процесс", "", "CSV Files (*.csv)");
+        if (!fileName.isEmpty() && !modes.empty() && modes[0].omega > 0) {
+            double period = 2.0 * 3.14159265358979323846 / modes[0].omega;
+            double dt = period / 200.0;
+
+            std::ofstream out(std::filesystem::path(fileName.toStdWString()));
+            if (!out) {
+                throw std::runtime_error("Не удалось сохранить файл");
+            }
+            dynamics.integrateNewmark(dt, 2000, [](double) { return 1.0; }, out, 10);
+        }
+    } catch (const std::exception &e) {
+        QMessageBox::critical(this, "Ошибка расчета",
+                              QString("Произошла ошибка при расчете: %1").arg(e.what()));
+    }
+
+    calculationInProgress = false;
+}
+
+void Sapr::performOptimization() {
+    if (calculationInProgress) {
         return;
     }
 
-    // Проверка размеров данных
-    int nodeCount = barCount + 1;
-    if (displacements.size() != static_cast<size_t>(nodeCount)) {
+    calculationInProgress = true;
+
+    try {
+        validateBars();
+
+        RodSystemCalculator calc(barCount + 1);
+        fillCalculator(calc);
+
+        RodSystemOptimizer optimizer(calc, ui->checkBoxLeft->isChecked(),
+                                     ui->checkBoxRight->isChecked());
+        RodSystemOptimizer::Result result = optimizer.optimize();
+
+        QString report = QString("Масса: %1 → %2 кг\nМакс. коэффициент использования: %3\n"
+                                 "Итераций: %4 + %5, разложений матрицы: %6\n\n")
+                             .arg(result.initialMass, 0, 'g', 6)
+                             .arg(result.mass, 0, 'g', 6)
+                             .arg(result.maxUtilization, 0, 'f', 4)
+                             .arg(result.fsdIterations)
+                             .arg(result.gradientIterations)
+                             .arg(result.factorizations);
+        for (size_t i = 0; i < result.areas.size(); i++) {
+            report += QString("Стержень %1: A = %2 м²\n").arg(i + 1).arg(result.areas[i], 0, 'g', 6);
+        }
+        report += "\nПрименить найденные площади?";
+
+        if (QMessageBox::question(this, "Оптимизация сечений", report,
+                                  QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
+            for (int i = 0; i < barCount && i < static_cast<int>(result.areas.size()); i++) {
+                surfaceEdits[i]->setText(QString::number(result.areas[i], 'g', 6));
+            }
+        }
+    } catch (const std::exception &e) {
+        QMessageBox::critical(this, "Ошибка расчета",
+                              QString("Произошла ошибка при расчете: %1").arg(e.what()));
+    }
+
+    calculationInProgress = false;
+}
+
+void Sapr::performMonteCarlo() {
+    if (calculationInProgress) {
         return;
     }
 
-    // Очищаем таблицы
-    resultsTable->clear();
-    stressTable->clear();
-
-    // Таблица 1: Узловые перемещения
-    resultsTable->setRowCount(nodeCount);
-    resultsTable->setColumnCount(4);
-    resultsTable->setHorizontalHeaderLabels(QStringList() << "Узел" << "Координата (м)"
-                                                          << "Перемещение (м)" << "Статус");
-
-    // Вычисляем координаты узлов
-    QVector<double> nodeCoordinates(nodeCount, 0.0);
-    for (int i = 1; i < nodeCount; i++) {
-        nodeCoordinates[i] = nodeCoordinates[i - 1] + getLengthValue(i - 1);
-    }
-
-    // Заполняем таблицу перемещений
-    for (int i = 0; i < nodeCount; i++) {
-        // Убеждаемся, что у нас есть данные
-        if (i >= displacements.size())
-            break;
-
-        resultsTable->setItem(i, 0, new QTableWidgetItem(QString::number(i + 1)));
-        resultsTable->setItem(i, 1,
-                              new QTableWidgetItem(QString::number(nodeCoordinates[i], 'f', 3)));
-        resultsTable->setItem(i, 2,
-                              new QTableWidgetItem(QString::number(displacements[i], 'e', 6)));
-
-        // Статус узла
-        QTableWidgetItem *statusItem = new QTableWidgetItem();
-        bool isLeftAnchor = (i == 0 && ui->checkBoxLeft->isChecked());
-        bool isRightAnchor = (i == nodeCount - 1 && ui->checkBoxRight->isChecked());
-
-        if (isLeftAnchor || isRightAnchor) {
-            statusItem->setText("ЗАДЕЛКА");
-            statusItem->setBackground(QBrush(QColor(200, 200, 200)));
-        } else if (std::abs(displacements[i]) < 1e-10) {
-            statusItem->setText("Неподвижен");
-            statusItem->setBackground(QBrush(QColor(173, 216, 230)));
-        } else {
-            statusItem->setText("Свободен");
-            statusItem->setBackground(QBrush(QColor(144, 238, 144)));
+    calculationInProgress = true;
+
+    try {
+        validateBars();
+
+        RodSystemCalculator calc(barCount + 1);
+        fillCalculator(calc);
+
+        RodSystemMonteCarlo monteCarlo(calc, ui->checkBoxLeft->isChecked(),
+                                       ui->checkBoxRight->isChecked());
+        RodSystemMonteCarlo::Settings settings;
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        RodSystemMonteCarlo::Result result = monteCarlo.run(settings);
+        QApplication::restoreOverrideCursor();
+
+        QString report = QString("Выборок: %1 (разброс E %2%, A %3%, нагрузок %4%)\n"
+                                 "Вероятность превышения в системе: %5\n\n")
+                             .arg(result.samples)
+                             .arg(settings.elasticModulus.cov * 100)
+                             .arg(settings.area.cov * 100)
+                             .arg(settings.nodeForce.cov * 100)
+                             .arg(result.systemFailureProbability, 0, 'g', 4);
+        for (size_t i = 0; i < result.stresses.size(); i++) {
+            const OnlineStatistics &stress = result.stresses[i];
+            report += QString("Стержень %1: σ = %2 ± %3 Па, 95%: %4 Па, P = %5\n")
+                          .arg(i + 1)
+                          .arg(stress.mean(), 0, 'e', 3)
+                          .arg(stress.stddev(), 0, 'e', 3)
+                          .arg(stress.quantile95(), 0, 'e', 3)
+                          .arg(result.failureProbability[i], 0, 'g', 4);
+        }
+        if (result.failedSolves > 0) {
+            report += QString("\nВырожденных выборок: %1").arg(result.failedSolves);
         }
-        resultsTable->setItem(i, 3, statusItem);
+        QMessageBox::information(this, "Вероятностный расчет", report);
+    } catch (const std::exception &e) {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::critical(this, "Ошибка расчета",
+                              QString("Произошла ошибка при расчете: %1").arg(e.what()));
     }
 
-    // Таблица 2: Напряжения в узлах
-    stressTable->setRowCount(nodeCount);
-    stressTable->setColumnCount(4);
-    stressTable->setHorizontalHeaderLabels(QStringList() << "Узел" << "Напряжение (Па)"
-                                                         << "Допустимое (Па)" << "Статус");
+    calculationInProgress = false;
+}
 
-    // Определяем допустимые напряжения для каждого узла
-    QVector<double> nodeAllowedStresses(nodeCount, 200e6); // значение по умолчанию
+void Sapr::editLibrary() {
+    if (loadedProject.materials.empty() && loadedProject.sections.empty()) {
+        QMessageBox::information(this, "Библиотека",
+                                 "В открытом проекте нет материалов и сечений ([Materials], "
+                                 "[Sections])");
+        return;
+    }
 
-    for (int i = 0; i < nodeCount; i++) {
-        stressTable->setItem(i, 0, new QTableWidgetItem(QString::number(i + 1)));
+    // Записи библиотеки: имя только для чтения, значения - с 17 значащими цифрами,
+    // как поля стержней
+    auto cell = [](QTableWidget *table, int row, int column, const QString &text, bool editable) {
+        QTableWidgetItem *item = new QTableWidgetItem(text);
+        if (!editable) {
+            item->setFlags(item->flags() & ~Qt::ItemIsEditable);
+        }
+        table->setItem(row, column, item);
+    };
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("Материалы и сечения");
+    QVBoxLayout *layout = new QVBoxLayout(&dialog);
+
+    int materialCount = static_cast<int>(loadedProject.materials.size());
+    QTableWidget *materialsTable = new QTableWidget(materialCount, 4, &dialog);
+    materialsTable->setHorizontalHeaderLabels({"Материал", "E", "[σ]", "ρ"});
+    materialsTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    for (int i = 0; i < materialCount; i++) {
+        const SaprProject::Material &material = loadedProject.materials[i];
+        cell(materialsTable, i, 0, QString::fromStdString(material.name), false);
+        cell(materialsTable, i, 1, QString::number(material.E, 'g', 17), true);
+        cell(materialsTable, i, 2, QString::number(material.sigma_allow, 'g', 17), true);
+        cell(materialsTable, i, 3, QString::number(material.rho, 'g', 17), true);
+    }
+    layout->addWidget(materialsTable);
+
+    int sectionCount = static_cast<int>(loadedProject.sections.size());
+    QTableWidget *sectionsTable = new QTableWidget(sectionCount, 2, &dialog);
+    sectionsTable->setHorizontalHeaderLabels({"Сечение", "A"});
+    sectionsTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    for (int i = 0; i < sectionCount; i++) {
+        const SaprProject::Section &section = loadedProject.sections[i];
+        cell(sectionsTable, i, 0, QString::fromStdString(section.name), false);
+        cell(sectionsTable, i, 1, QString::number(section.A, 'g', 17), true);
+    }
+    layout->addWidget(sectionsTable);
 
-        if (i < stresses.size()) {
-            double stress = std::abs(stresses[i]);
-            double allowed = nodeAllowedStresses[i];
+    QDialogButtonBox *buttons =
+        new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
+    connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    layout->addWidget(buttons);
 
-            stressTable->setItem(i, 1, new QTableWidgetItem(QString::number(stress, 'e', 6)));
-            stressTable->setItem(i, 2, new QTableWidgetItem(QString::number(allowed, 'e', 6)));
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
 
-            QTableWidgetItem *statusItem = new QTableWidgetItem();
-            if (stress <= allowed) {
-                statusItem->setText("НОРМА");
-                statusItem->setBackground(QBrush(QColor(144, 238, 144)));
-            } else {
-                statusItem->setText("ПРЕВЫШЕНИЕ!");
-                statusItem->setBackground(QBrush(QColor(255, 0, 0)));
-                statusItem->setForeground(QBrush(QColor(255, 255, 255)));
-            }
-            stressTable->setItem(i, 3, statusItem);
-        } else {
-            // Заполняем пустыми значениями если данных нет
-            stressTable->setItem(i, 1, new QTableWidgetItem("—"));
-            stressTable->setItem(i, 2, new QTableWidgetItem("—"));
-            stressTable->setItem(i, 3, new QTableWidgetItem("—"));
+    // Значения ячейки; нечисловое или неположительное значение отменяет изменения
+    bool valid = true;
+    auto value = [&valid](QTableWidget *table, int row, int column) {
+        bool ok;
+        double result = table->item(row, column)->text().toDouble(&ok);
+        if (!ok || !(result > 0)) {
+            valid = false;
+        }
+        return result;
+    };
+
+    // Изменения записей переносятся MaterialLibrary во все ссылающиеся стержни,
+    // включая стержни подконструкций
+    SaprProject project = currentProject();
+    for (int i = 0; i < materialCount; i++) {
+        double E = value(materialsTable, i, 1);
+        double sigma_allow = value(materialsTable, i, 2);
+        double rho = value(materialsTable, i, 3);
+        if (valid) {
+            MaterialLibrary::setMaterial(project, i, E, sigma_allow, rho);
+        }
+    }
+    for (int i = 0; i < sectionCount; i++) {
+        double A = value(sectionsTable, i, 1);
+        if (valid) {
+            MaterialLibrary::setSection(project, i, A);
+        }
+    }
+    if (!valid) {
+        QMessageBox::warning(this, "Библиотека",
+                             "Значения материалов и сечений должны быть положительными числами");
+        return;
+    }
+
+    loadedProject.materials = project.materials;
+    loadedProject.sections = project.sections;
+    loadedProject.substructures = project.substructures;
+    for (int i = 0; i < barCount; i++) {
+        const SaprProject::Bar &bar = project.bars[i];
+        if (i < static_cast<int>(loadedProject.bars.size())) {
+            loadedProject.bars[i] = bar;
+        }
+        if (bar.material >= 0) {
+            elasticModulusEdits[i]->setText(QString::number(bar.E, 'g', 17));
+            tensileStrengthEdits[i]->setText(QString::number(bar.sigma_allow, 'g', 17));
+            densityEdits[i]->setText(QString::number(bar.rho, 'g', 17));
         }
+        if (bar.section >= 0) {
+            surfaceEdits[i]->setText(QString::number(bar.A, 'g', 17));
+        }
+    }
+
+    // Результаты прежнего расчета больше не соответствуют стержням
+    if (!solution.displacements.empty()) {
+        performCalculations();
+    }
+}
+
+void Sapr::exportResults() {
+    if (solution.displacements.empty()) {
+        QMessageBox::warning(this, "Экспорт результатов", "Сначала необходимо выполнить расчет");
+        return;
+    }
+
+    QString fileName = QFileDialog::getSaveFileName(
+        this, "Экспорт результатов", "",
+        "CSV Files (*.csv);;JSON Files (*.json);;Binary Files (*.bin)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    std::filesystem::path path(fileName.toStdWString());
+    SolutionExporter::Format format;
+    if (!SolutionExporter::formatForPath(path, format)) {
+        QMessageBox::warning(this, "Экспорт результатов",
+                             "Укажите расширение файла: .csv, .json или .bin");
+        return;
+    }
+
+    try {
+        SolutionExporter::save(solution, path, format);
+    } catch (const std::exception &e) {
+        QMessageBox::critical(this, "Ошибка экспорта", e.what());
+    }
+}
+
+void Sapr::updateResultsTables(const Solution &result) {
+    ProfileScope profile("Sapr::updateResultsTables");
+
+    // Проверка указателей таблиц
+    if (!resultsTable || !stressTable) {
+        return;
+    }
+
+    // Проверка размеров данных
+    if (result.nodeCount() != barCount + 1) {
+        return;
+    }
+
+    // Модели читают массивы результата напрямую; ширина столбцов - по выборке строк
+    nodeResultsModel->setSolution(&result);
+    resizeColumnsFromSample(resultsTable);
+
+    // Таблица 2: Проверка прочности по стержням
+    strengthResultsModel->setSolution(&result);
+    fillStressTable();
+}
+
+void Sapr::fillStressTable() {
+    if (!stressTable) {
+        return;
+    }
+
+    // Фильтр и сортировка меняют только порядок строк модели
+    strengthResultsModel->setOverloadedOnly(overloadedOnlyCheck &&
+                                            overloadedOnlyCheck->isChecked());
+    if (sortByUtilizationCheck && sortByUtilizationCheck->isChecked()) {
+        stressTable->sortByColumn(StrengthResultsModel::Utilization, Qt::DescendingOrder);
+    } else {
+        stressTable->sortByColumn(StrengthResultsModel::Rod, Qt::AscendingOrder);
     }
 
-    resultsTable->resizeColumnsToContents();
-    stressTable->resizeColumnsToContents();
+    resizeColumnsFromSample(stressTable);
 }
 
 double Sapr::getSurfaceValue(int index) {
@@ -1239,3 +1678,16 @@ double Sapr::getTensileStrengthValue(int index) {
     double value = text.toDouble(&ok);
     return ok ? value : 200e6;
 }
+
+double Sapr::getDensityValue(int index) {
+    if (index < 0 || index >= densityEdits.size() || !densityEdits[index]) {
+        return 7850.0; // сталь по умолчанию
+    }
+    QString text = densityEdits[index]->text();
+    if (text.isEmpty())
+        return 7850.0;
+
+    bool ok;
+    double value = text.toDouble(&ok);
+    return ok ? value : 7850.0;
+}
@@ -2,15 +2,18 @@
 #define SAPR_H
 
 #include "filehandler.h"
+#include "resultsmodel.h"
 #include "rodsystemcalculator.h"
 #include "schemawidget.h"
+#include <QCheckBox>
 #include <QGridLayout>
 #include <QLabel>
 #include <QLineEdit>
 #include <QMainWindow>
 #include <QPushButton>
-#include <QTableWidget>
+#include <QTableView>
 #include <QVector>
+#include <memory>
 
 namespace Ui { class MainWindow; }
 
@@ -30,12 +33,23 @@ public:
     QString getBarSurface(int index) const;
     QString getBarElasticModulus(int index) const;
     QString getBarTensileStrength(int index) const;
+    QString getBarDensity(int index) const;
     QVector<double> getAllNodeForces();
     QVector<double> getAllBarForces();
-    RodSystemCalculator *calculator;
+    std::unique_ptr<RodSystemCalculator> calculator;
+    Solution solution; // Результат последнего расчета
+    // Проект в том виде, в каком он прочитан ProjectReader (с подконструкциями): окно
+    // показывает развернутые стержни, а при сохранении экземпляры записываются компактно
+    SaprProject loadedProject;
+    // Расчетные данные окна для ProjectWriter
+    SaprProject currentProject();
     bool calculationInProgress;
-    QTableWidget *resultsTable;
-    QTableWidget *stressTable;
+    QTableView *resultsTable;
+    QTableView *stressTable;
+    NodeResultsModel *nodeResultsModel = nullptr;
+    StrengthResultsModel *strengthResultsModel = nullptr;
+    QCheckBox *overloadedOnlyCheck = nullptr;
+    QCheckBox *sortByUtilizationCheck = nullptr;
 
     // Public setters for FileHandler
     void setLeftAnchor(bool anchored);
@@ -44,19 +58,24 @@ public:
     void addBar();
     void setBarProperties(int index, const QString &length,
                           const QString &surface, const QString &elasticModulus,
-                          const QString &tensileStrength);
+                          const QString &tensileStrength, const QString &density = QString());
     void setNodeForces(const QVector<double> &forces);
     void setBarForces(const QVector<double> &forces);
 
     // Methods for calculator
     void setupResultsTables();
     void performCalculations();
-    void updateResultsTables(const std::vector<double> &displacements,
-                             const std::vector<double> &forces,
-                             const std::vector<double> &stresses);
+    void performDynamicAnalysis();
+    void performOptimization();
+    void performMonteCarlo();
+    void editLibrary();
+    void exportResults();
+    void updateResultsTables(const Solution &result);
+    void fillStressTable();
     double getSurfaceValue(int index);
     double getElasticModulusValue(int index);
     double getTensileStrengthValue(int index);
+    double getDensityValue(int index);
 
     Ui::MainWindow *ui;
     int barCount = 0;
@@ -67,6 +86,7 @@ public:
     QLabel *headerSurface = nullptr;
     QLabel *headerElasticModulus = nullptr;
     QLabel *headerTensileStrength = nullptr;
+    QLabel *headerDensity = nullptr;
     SchemaWidget *schemaWidget = nullptr;
 
     QVector<QLabel *> numberLabels;
@@ -76,6 +96,7 @@ public:
     QVector<QLineEdit *> surfaceEdits;
     QVector<QLineEdit *> elasticModulusEdits;
     QVector<QLineEdit *> tensileStrengthEdits;
+    QVector<QLineEdit *> densityEdits;
 
     QVector<double> savedNodeForces;
     QVector<double> savedBarForces;
@@ -105,6 +126,8 @@ private:
     double getLengthValue(int index);
     void updateSchemaData();
     void removeBar(int index);
+    void validateBars();
+    void fillCalculator(RodSystemCalculator &calc);
 
     double getNodeForces(int nodeIndex);
     void updateNodeForces(bool skipSave);
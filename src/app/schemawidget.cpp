@@ -1,4 +1,5 @@
 #include "schemawidget.h"
+#include "profiler.h"
 #include <QHBoxLayout>
 #include <QScrollArea>
 #include <QScrollBar>
@@ -152,6 +153,7 @@ double SchemaWidget::getTotalLength() const {
 
 void SchemaWidget::paintEvent(QPaintEvent *event) {
   Q_UNUSED(event)
+  ProfileScope profile("SchemaWidget::paintEvent");
 
   QPainter painter(this);
   painter.setRenderHint(QPainter::Antialiasing);
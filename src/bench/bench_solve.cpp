@@ -0,0 +1,175 @@
+#include "basicrodsystem.h"
+#include "paralleltridiagonalsolver.h"
+#include "rodkernels.h"
+#include "rodsystembatch.h"
+#include "rodsystemcalculator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <type_traits>
+
+// Время статического расчета в зависимости от числа стержней, пропускная способность
+// пакетного расчета и масштабирование параллельного трехдиагонального решателя по числу
+// потоков, время и погрешность расчета в разных скалярных типах. Модели случайные, но воспроизводимые (фиксированное зерно).
+
+namespace {
+
+SaprProject randomProject(int bars, std::mt19937_64 &random) {
+    std::uniform_real_distribution<double> factor(0.5, 2.0);
+    SaprProject project;
+    project.leftAnchor = true;
+    project.rightAnchor = (bars % 2 == 0);
+    for (int i = 0; i < bars; i++) {
+        SaprProject::Bar bar;
+        bar.L = factor(random);
+        bar.A = 1e-3 * factor(random);
+        bar.E = 2e11 * factor(random);
+        project.bars.push_back(bar);
+        project.barForces.push_back(1e3 * (factor(random) - 1.0));
+    }
+    for (int i = 0; i <= bars; i++) {
+        project.nodeForces.push_back(1e4 * (factor(random) - 1.0));
+    }
+    return project;
+}
+
+// Минимальное время из нескольких повторов, мс
+template <class Body> double measure(int repeats, Body &&body) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; r++) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto finish = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(finish - start).count());
+    }
+    return best;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937_64 random(2024);
+    std::printf("Ядра: %s\n\n", RodKernels::levelName(RodKernels::activeLevel()));
+
+    std::printf("%10s %12s %12s %12s %12s\n", "Стержней", "Всего, мс", "Сборка, мс",
+                "Решение, мс", "Усилия, мс");
+    for (int bars : {1000, 10000, 100000, 1000000}) {
+        RodSystemCalculator calculator(randomProject(bars, random));
+        calculator.setLogging(false);
+        calculator.setDiagnostics(false);
+        calculator.solve(true, bars % 2 == 0); // Прогрев и выделение рабочих буферов
+
+        SolveTimings best;
+        best.total = 1e300;
+        for (int r = 0; r < 5; r++) {
+            Solution solution = calculator.solve(true, bars % 2 == 0);
+            if (solution.timings.total < best.total) {
+                best = solution.timings;
+            }
+        }
+        std::printf("%10d %12.3f %12.3f %12.3f %12.3f\n", bars, best.total, best.assembly,
+                    best.factorization, best.recovery);
+    }
+
+    std::printf("\n%10s %10s %14s %14s\n", "Моделей", "Стержней", "Пакет, мс", "Моделей/с");
+    for (int bars : {4, 16, 64}) {
+        RodSystemBatch batch;
+        for (int m = 0; m < 20000; m++) {
+            batch.add(randomProject(bars, random));
+        }
+        double ms = measure(3, [&]() { batch.solve(); });
+        std::printf("%10d %10d %14.3f %14.0f\n", batch.size(), bars, ms,
+                    batch.size() / (ms / 1000.0));
+    }
+
+    // Разложение и решение матрицы жесткости цепочки стержней (заделка слева)
+    int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::printf("\n%10s %8s %8s %14s %10s\n", "Узлов", "Потоков", "Блоков", "Решение, мс",
+                "Ускорение");
+    for (int n : {1000000, 10000000}) {
+        std::uniform_real_distribution<double> factor(0.5, 2.0);
+        std::vector<double> k(n);
+        for (double &value : k) {
+            value = factor(random);
+        }
+        std::vector<double> diag(n), off(n - 1), rhs(n, 1.0);
+        for (int i = 0; i < n; i++) {
+            diag[i] = (i > 0 ? k[i - 1] : 0.0) + (i < n - 1 ? k[i] : 1.0);
+        }
+        for (int i = 0; i + 1 < n; i++) {
+            off[i] = -k[i];
+        }
+        diag[0] = 1.0;
+        off[0] = 0.0;
+
+        TridiagonalSolver serial;
+        std::vector<double> x;
+        double serialMs = measure(3, [&]() {
+            serial.factor(diag, off);
+            x = rhs;
+            serial.solve(x);
+        });
+        std::printf("%10d %8s %8d %14.3f %10.2f\n", n, "посл.", 1, serialMs, 1.0);
+
+        for (int threads = 1; threads <= cores; threads *= 2) {
+            ParallelTridiagonalSolver parallel;
+            parallel.setThreads(threads);
+            double ms = measure(3, [&]() {
+                parallel.factor(diag, off);
+                x = rhs;
+                parallel.solve(x);
+            });
+            std::printf("%10d %8d %8d %14.3f %10.2f\n", n, threads, parallel.blockCount(), ms,
+                        serialMs / ms);
+            if (threads < cores && threads * 2 > cores) {
+                threads = cores / 2; // Последний шаг - все ядра
+            }
+        }
+    }
+
+    // BasicRodSystem: время и отклонение перемещений от double (относительно max |u|);
+    // Dual<4> - значения и производные по модулю упругости четырех стержней
+    std::printf("\n%10s %12s %14s %14s\n", "Стержней", "Тип", "Решение, мс", "Отклонение");
+    for (int bars : {100000, 1000000}) {
+        SaprProject project = randomProject(bars, random);
+        BasicRodSystem<double> reference(project);
+        double referenceMs = measure(3, [&]() { reference.solve(true, false); });
+        const std::vector<double> &u = reference.getDisplacements();
+        double norm = 0;
+        for (double value : u) {
+            norm = std::max(norm, std::abs(value));
+        }
+        auto deviation = [&](const auto &values) {
+            using Scalar = typename std::decay_t<decltype(values)>::value_type;
+            double worst = 0;
+            for (int i = 0; i < static_cast<int>(u.size()); i++) {
+                double value = static_cast<double>(ScalarTraits<Scalar>::real(values[i]));
+                worst = std::max(worst, std::abs(value - u[i]) / norm);
+            }
+            return worst;
+        };
+
+        BasicRodSystem<float> single(project);
+        double singleMs = measure(3, [&]() { single.solve(true, false); });
+        BasicRodSystem<long double> extended(project);
+        double extendedMs = measure(3, [&]() { extended.solve(true, false); });
+        BasicRodSystem<Dual<4>> dual(project);
+        for (int j = 0; j < 4; j++) {
+            int p = j * (bars / 4);
+            dual.elasticModulus(p) = Dual<4>::variable(project.bars[p].E, j);
+        }
+        double dualMs = measure(3, [&]() { dual.solve(true, false); });
+
+        std::printf("%10d %12s %14.3f %14s\n", bars, "double", referenceMs, "-");
+        std::printf("%10d %12s %14.3f %14.3e\n", bars, "float", singleMs,
+                    deviation(single.getDisplacements()));
+        std::printf("%10d %12s %14.3f %14.3e\n", bars, "long double", extendedMs,
+                    deviation(extended.getDisplacements()));
+        std::printf("%10d %12s %14.3f %14.3e\n", bars, "Dual<4>", dualMs,
+                    deviation(dual.getDisplacements()));
+    }
+    return 0;
+}
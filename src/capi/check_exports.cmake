@@ -0,0 +1,22 @@
+# Проверка экспорта libsapr_c.so: все определенные динамические символы - функции sapr_*.
+# Запуск: cmake -DNM=<nm> -DLIBRARY=<путь к библиотеке> -P check_exports.cmake
+execute_process(COMMAND ${NM} -D --defined-only ${LIBRARY}
+                OUTPUT_VARIABLE symbols
+                RESULT_VARIABLE status)
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "nm завершился с ошибкой ${status}")
+endif()
+
+string(REPLACE "\n" ";" lines "${symbols}")
+set(foreign "")
+foreach(line IN LISTS lines)
+    string(REGEX MATCH "[^ ]+$" name "${line}")
+    if(name AND NOT name MATCHES "^sapr_")
+        list(APPEND foreign ${name})
+    endif()
+endforeach()
+
+if(foreign)
+    message(FATAL_ERROR "Экспортируются лишние символы: ${foreign}")
+endif()
+message(STATUS "Экспортируются только функции sapr_*")
@@ -0,0 +1,100 @@
+/* Пример использования sapr_c: консольный стержень из двух участков с заделкой слева.
+   Сила F на свободном конце, распределенная нагрузка q на втором участке.
+   Результат сверяется с аналитическим решением; код возврата 0 - совпадение. */
+
+#include "sapr_c.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#define RODS 2
+#define NODES (RODS + 1)
+
+static int check(const char *name, double actual, double expected) {
+    double tolerance = 1e-9 * (fabs(expected) > 1.0 ? fabs(expected) : 1.0);
+    if (fabs(actual - expected) > tolerance) {
+        fprintf(stderr, "%s: %.17g, ожидалось %.17g\n", name, actual, expected);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    const double length[RODS] = {1.0, 2.0};
+    const double area[RODS] = {2.0, 1.0};
+    const double modulus[RODS] = {1.0, 1.0};
+    const double load[RODS] = {0.0, 3.0};
+    const double forces[NODES] = {0.0, 0.0, 4.0};
+
+    double u[NODES], n[RODS], sigma[NODES], reactions[NODES];
+    sapr_model *model = NULL;
+    sapr_diagnostics diagnostics;
+    sapr_status status;
+    int failures = 0;
+
+    if (sapr_abi_version() != SAPR_C_ABI_VERSION) {
+        fprintf(stderr, "Версия библиотеки %d, заголовка %d\n", sapr_abi_version(),
+                SAPR_C_ABI_VERSION);
+        return 1;
+    }
+
+    status = sapr_model_create(RODS, &model);
+    if (status != SAPR_OK) {
+        fprintf(stderr, "sapr_model_create: %s\n", sapr_status_message(status));
+        return 1;
+    }
+    sapr_model_set_rods(model, length, area, modulus, load, NULL);
+    sapr_model_set_forces(model, forces);
+
+    /* Без заделок система вырождена */
+    status = sapr_model_solve(model, u, n, sigma, reactions);
+    if (status != SAPR_ERROR_SINGULAR) {
+        fprintf(stderr, "Ожидалась вырожденность, получено %d\n", (int)status);
+        failures++;
+    }
+
+    sapr_model_set_anchors(model, 1, 0);
+    status = sapr_model_solve(model, u, n, sigma, reactions);
+    if (status != SAPR_OK) {
+        fprintf(stderr, "sapr_model_solve: %s\n", sapr_model_last_error(model));
+        sapr_model_destroy(model);
+        return 1;
+    }
+
+    /* Усилия: N2(L) = F = 4, N1 = F + qL2 = 10; реакция заделки -10.
+       u1 = N1 L1 / (E A1) = 5, u2 = u1 + (F L2 + q L2^2 / 2) / (E A2) = 5 + 14 = 19 */
+    failures += check("u[1]", u[1], 5.0);
+    failures += check("u[2]", u[2], 19.0);
+    failures += check("N[0]", n[0], 10.0);
+    failures += check("N[1]", n[1], 4.0);
+    failures += check("R[0]", reactions[0], -10.0);
+    failures += check("R[2]", reactions[2], 0.0);
+
+    /* Без необязательных буферов */
+    status = sapr_model_solve(model, u, NULL, NULL, NULL);
+    failures += status != SAPR_OK;
+    failures += check("u[2] (NULL)", u[2], 19.0);
+
+    diagnostics.size = sizeof(diagnostics);
+    status = sapr_model_diagnostics(model, &diagnostics);
+    if (status != SAPR_OK || diagnostics.equilibrium_residual > 1e-12) {
+        fprintf(stderr, "Невязка равновесия %g\n", diagnostics.equilibrium_residual);
+        failures++;
+    }
+
+    /* Неположительная длина отклоняется, модель сохраняет прежние данные */
+    {
+        const double bad[RODS] = {1.0, 0.0};
+        status = sapr_model_set_rods(model, bad, area, modulus, load, NULL);
+        if (status != SAPR_ERROR_INVALID_ARGUMENT || sapr_model_last_error(model)[0] == '\0') {
+            fprintf(stderr, "Некорректная длина не отклонена\n");
+            failures++;
+        }
+    }
+
+    printf("u = %g %g %g, N = %g %g, R0 = %g, невязка %.3g, %.3f мс\n", u[0], u[1], u[2], n[0],
+           n[1], reactions[0], diagnostics.equilibrium_residual, diagnostics.total_ms);
+
+    sapr_model_destroy(model);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,294 @@
+#include "sapr_c.h"
+
+#include "rodsystemcalculator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+struct sapr_model {
+    explicit sapr_model(int rodCount) : calculator(rodCount + 1) {}
+
+    RodSystemCalculator calculator;
+    bool leftAnchor = false;
+    bool rightAnchor = false;
+    bool solved = false;
+    std::vector<double> scratch; // Выходные буферы, которые вызывающая сторона не передала
+    std::string lastError;
+};
+
+namespace {
+
+sapr_status fail(sapr_model *model, sapr_status status, const char *message) {
+    if (model) {
+        try {
+            model->lastError = message;
+        } catch (...) {
+            model->lastError.clear();
+        }
+    }
+    return status;
+}
+
+sapr_status fromCode(CalculationError::Code code) {
+    switch (code) {
+    case CalculationError::Code::NoRods:
+        return SAPR_ERROR_NO_RODS;
+    case CalculationError::Code::InvalidInput:
+        return SAPR_ERROR_INVALID_ARGUMENT;
+    case CalculationError::Code::Singular:
+        return SAPR_ERROR_SINGULAR;
+    case CalculationError::Code::NoSolution:
+        return SAPR_ERROR_NO_SOLUTION;
+    }
+    return SAPR_ERROR_INTERNAL;
+}
+
+// Выполняет действие над моделью; исключения C++ превращаются в код и текст ошибки
+template <class Action> sapr_status guarded(sapr_model *model, Action &&action) {
+    if (!model) {
+        return SAPR_ERROR_INVALID_ARGUMENT;
+    }
+    try {
+        sapr_status status = action();
+        if (status == SAPR_OK) {
+            model->lastError.clear();
+        }
+        return status;
+    } catch (const CalculationError &error) {
+        return fail(model, fromCode(error.code()), error.what());
+    } catch (const std::bad_alloc &) {
+        return fail(model, SAPR_ERROR_OUT_OF_MEMORY, sapr_status_message(SAPR_ERROR_OUT_OF_MEMORY));
+    } catch (const std::exception &error) {
+        return fail(model, SAPR_ERROR_INTERNAL, error.what());
+    } catch (...) {
+        return fail(model, SAPR_ERROR_INTERNAL, sapr_status_message(SAPR_ERROR_INTERNAL));
+    }
+}
+
+bool allPositive(const double *values, int count) {
+    return std::all_of(values, values + count,
+                       [](double v) { return std::isfinite(v) && v > 0.0; });
+}
+
+bool allFinite(const double *values, int count) {
+    return std::all_of(values, values + count, [](double v) { return std::isfinite(v); });
+}
+
+} // namespace
+
+extern "C" {
+
+int sapr_abi_version(void) { return SAPR_C_ABI_VERSION; }
+
+sapr_status sapr_model_create(int rod_count, sapr_model **model) {
+    if (!model) {
+        return SAPR_ERROR_INVALID_ARGUMENT;
+    }
+    *model = nullptr;
+    if (rod_count <= 0) {
+        return rod_count == 0 ? SAPR_ERROR_NO_RODS : SAPR_ERROR_INVALID_ARGUMENT;
+    }
+    try {
+        *model = new sapr_model(rod_count);
+        (*model)->calculator.setLogging(false);
+        return SAPR_OK;
+    } catch (const std::bad_alloc &) {
+        delete *model;
+        *model = nullptr;
+        return SAPR_ERROR_OUT_OF_MEMORY;
+    } catch (...) {
+        delete *model;
+        *model = nullptr;
+        return SAPR_ERROR_INTERNAL;
+    }
+}
+
+void sapr_model_destroy(sapr_model *model) { delete model; }
+
+int sapr_model_rod_count(const sapr_model *model) {
+    return model ? model->calculator.getRodCount() : 0;
+}
+
+int sapr_model_node_count(const sapr_model *model) {
+    return model ? model->calculator.getNodeCount() : 0;
+}
+
+sapr_status sapr_model_set_rods(sapr_model *model, const double *length, const double *area,
+                                const double *elastic_modulus, const double *distributed_load,
+                                const double *sigma_allow) {
+    return guarded(model, [&] {
+        int count = model->calculator.getRodCount();
+        if (!length || !area || !elastic_modulus || !distributed_load) {
+            return fail(model, SAPR_ERROR_INVALID_ARGUMENT, "Не задан массив свойств стержней");
+        }
+        if (!allPositive(length, count) || !allPositive(area, count) ||
+            !allPositive(elastic_modulus, count)) {
+            return fail(model, SAPR_ERROR_INVALID_ARGUMENT,
+                        "Длина, площадь и модуль упругости должны быть положительными");
+        }
+        if (!allFinite(distributed_load, count) || (sigma_allow && !allFinite(sigma_allow, count))) {
+            return fail(model, SAPR_ERROR_INVALID_ARGUMENT, "Некорректное значение нагрузки");
+        }
+        model->calculator.setRods(length, area, elastic_modulus, distributed_load, sigma_allow);
+        model->solved = false;
+        return SAPR_OK;
+    });
+}
+
+sapr_status sapr_model_set_densities(sapr_model *model, const double *density) {
+    return guarded(model, [&] {
+        int count = model->calculator.getRodCount();
+        if (!density || !allFinite(density, count)) {
+            return fail(model, SAPR_ERROR_INVALID_ARGUMENT, "Некорректное значение плотности");
+        }
+        // Плотность в расчет перемещений не входит: задается вместе с текущими свойствами
+        std::vector<double> L(count), A(count), E(count), q(count);
+        for (int p = 0; p < count; p++) {
+            L[p] = model->calculator.getRodLength(p);
+            A[p] = model->calculator.getRodArea(p);
+            E[p] = model->calculator.getRodElasticModulus(p);
+            q[p] = model->calculator.getRodDistributedLoad(p);
+        }
+        model->calculator.setRods(L.data(), A.data(), E.data(), q.data(), nullptr, density);
+        return SAPR_OK;
+    });
+}
+
+sapr_status sapr_model_set_forces(sapr_model *model, const double *forces) {
+    return guarded(model, [&] {
+        if (!forces || !allFinite(forces, model->calculator.getNodeCount())) {
+            return fail(model, SAPR_ERROR_INVALID_ARGUMENT, "Некорректное значение силы");
+        }
+        model->calculator.setForces(forces);
+        model->solved = false;
+        return SAPR_OK;
+    });
+}
+
+sapr_status sapr_model_set_anchors(sapr_model *model, int left, int right) {
+    return guarded(model, [&] {
+        model->leftAnchor = left != 0;
+        model->rightAnchor = right != 0;
+        model->solved = false;
+        return SAPR_OK;
+    });
+}
+
+sapr_status sapr_model_set_solver_mode(sapr_model *model, sapr_solver_mode mode) {
+    return guarded(model, [&] {
+        switch (mode) {
+        case SAPR_SOLVER_DIRECT:
+            model->calculator.setSolverMode(RodSystemCalculator::SolverMode::Direct);
+            return SAPR_OK;
+        case SAPR_SOLVER_MIXED_PRECISION:
+            model->calculator.setSolverMode(RodSystemCalculator::SolverMode::MixedPrecision);
+            return SAPR_OK;
+        }
+        return fail(model, SAPR_ERROR_INVALID_ARGUMENT, "Неизвестный режим решателя");
+    });
+}
+
+sapr_status sapr_model_set_diagnostics(sapr_model *model, int enabled) {
+    return guarded(model, [&] {
+        model->calculator.setDiagnostics(enabled != 0);
+        return SAPR_OK;
+    });
+}
+
+sapr_status sapr_model_solve(sapr_model *model, double *displacements, double *forces,
+                             double *stresses, double *reactions) {
+    return guarded(model, [&] {
+        if (!displacements) {
+            return fail(model, SAPR_ERROR_INVALID_ARGUMENT, "Не задан буфер перемещений");
+        }
+        model->solved = false;
+        RodSystemCalculator &calculator = model->calculator;
+        int n = calculator.getNodeCount();
+
+        // Недостающие буферы берутся из модели: после первого расчета выделений нет
+        size_t needed = (forces ? 0 : n - 1) + (stresses ? 0 : n);
+        if (model->scratch.size() < needed) {
+            model->scratch.resize(needed);
+        }
+        double *spare = model->scratch.data();
+        if (!forces) {
+            forces = spare;
+            spare += n - 1;
+        }
+        if (!stresses) {
+            stresses = spare;
+        }
+
+        calculator.calculateInto(displacements, forces, stresses, model->leftAnchor,
+                                 model->rightAnchor);
+        if (reactions) {
+            const std::vector<double> &computed = calculator.getReactions();
+            std::memcpy(reactions, computed.data(), sizeof(double) * n);
+        }
+        model->solved = true;
+        return SAPR_OK;
+    });
+}
+
+sapr_status sapr_model_diagnostics(const sapr_model *model, sapr_diagnostics *diagnostics) {
+    if (!model || !diagnostics || diagnostics->size < sizeof(size_t)) {
+        return SAPR_ERROR_INVALID_ARGUMENT;
+    }
+    if (!model->solved) {
+        return SAPR_ERROR_NO_SOLUTION;
+    }
+    const RodSystemCalculator::SolveReport &report = model->calculator.getSolveReport();
+    const SolveTimings &timings = model->calculator.getTimings();
+
+    sapr_diagnostics result;
+    result.size = sizeof(result);
+    result.mixed_precision = report.mixedPrecision ? 1 : 0;
+    result.float_factorization = report.floatFactorization ? 1 : 0;
+    result.refinement_steps = report.refinementSteps;
+    result.worst_node = report.worstNode;
+    result.condition_estimate = report.conditionEstimate;
+    result.min_pivot_ratio = report.minPivotRatio;
+    result.backward_error = report.backwardError;
+    result.equilibrium_residual = report.equilibriumResidual;
+    result.global_residual = report.globalResidual;
+    result.assembly_ms = timings.assembly;
+    result.factorization_ms = timings.factorization;
+    result.recovery_ms = timings.recovery;
+    result.total_ms = timings.total;
+
+    // Вызывающая сторона со старым заголовком получает только известные ей поля
+    size_t callerSize = diagnostics->size;
+    std::memcpy(diagnostics, &result, std::min(callerSize, sizeof(result)));
+    diagnostics->size = std::min(callerSize, sizeof(result));
+    return SAPR_OK;
+}
+
+const char *sapr_model_last_error(const sapr_model *model) {
+    return model ? model->lastError.c_str() : "";
+}
+
+const char *sapr_status_message(sapr_status status) {
+    switch (status) {
+    case SAPR_OK:
+        return "";
+    case SAPR_ERROR_INVALID_ARGUMENT:
+        return "Некорректные аргументы";
+    case SAPR_ERROR_NO_RODS:
+        return "Нет стержней для расчета";
+    case SAPR_ERROR_SINGULAR:
+        return "Система уравнений вырождена";
+    case SAPR_ERROR_NO_SOLUTION:
+        return "Расчет еще не выполнен";
+    case SAPR_ERROR_OUT_OF_MEMORY:
+        return "Недостаточно памяти";
+    case SAPR_ERROR_INTERNAL:
+        return "Внутренняя ошибка";
+    }
+    return "Неизвестная ошибка";
+}
+
+} // extern "C"
@@ -0,0 +1,123 @@
+#ifndef SAPR_C_H
+#define SAPR_C_H
+
+/*
+ * C-интерфейс статического расчета стержневой системы (библиотека sapr_c).
+ *
+ * Двоичная совместимость: функции и перечисления только добавляются; структуры,
+ * заполняемые библиотекой, начинаются с поля size, которое вызывающая сторона
+ * задает как sizeof(структуры) своей версии заголовка.
+ *
+ * Данные стержней копируются в модель одним вызовом из массивов вызывающей стороны;
+ * результаты записываются прямо в ее буферы. Исключения C++ через границу
+ * интерфейса не передаются: каждая функция возвращает sapr_status, текст последней
+ * ошибки (UTF-8) возвращает sapr_model_last_error().
+ *
+ * Одна модель не должна использоваться из нескольких потоков одновременно;
+ * разные модели независимы.
+ */
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#if defined(SAPR_C_BUILD)
+#define SAPR_C_API __declspec(dllexport)
+#else
+#define SAPR_C_API __declspec(dllimport)
+#endif
+#elif defined(__GNUC__)
+#define SAPR_C_API __attribute__((visibility("default")))
+#else
+#define SAPR_C_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SAPR_C_ABI_VERSION 1
+
+typedef enum sapr_status {
+    SAPR_OK = 0,
+    SAPR_ERROR_INVALID_ARGUMENT = 1, /* Нулевой указатель, неверный размер или номер */
+    SAPR_ERROR_NO_RODS = 2,          /* В модели нет стержней */
+    SAPR_ERROR_SINGULAR = 3,         /* Система уравнений вырождена (нет заделок и т. п.) */
+    SAPR_ERROR_NO_SOLUTION = 4,      /* Запрос результата до успешного расчета */
+    SAPR_ERROR_OUT_OF_MEMORY = 5,
+    SAPR_ERROR_INTERNAL = 6
+} sapr_status;
+
+typedef enum sapr_solver_mode {
+    SAPR_SOLVER_DIRECT = 0,         /* Разложение L D L^T в double */
+    SAPR_SOLVER_MIXED_PRECISION = 1 /* Разложение во float с уточнением до double */
+} sapr_solver_mode;
+
+typedef struct sapr_diagnostics {
+    size_t size;                 /* sizeof(sapr_diagnostics) вызывающей стороны */
+    int mixed_precision;         /* Расчет выполнен в режиме смешанной точности */
+    int float_factorization;     /* Разложение во float оказалось достаточным */
+    int refinement_steps;        /* Шаги итерационного уточнения */
+    int worst_node;              /* Узел с наибольшей невязкой (с 0), -1 - нет свободных */
+    double condition_estimate;   /* Оценка числа обусловленности (0 - не вычислялась) */
+    double min_pivot_ratio;      /* Минимальная доля ведущего элемента */
+    double backward_error;       /* Обратная ошибка после уточнения */
+    double equilibrium_residual; /* max относительной невязки равновесия узлов */
+    double global_residual;      /* Относительная невязка равновесия системы */
+    double assembly_ms;          /* Время этапов последнего расчета, мс */
+    double factorization_ms;
+    double recovery_ms;
+    double total_ms;
+} sapr_diagnostics;
+
+typedef struct sapr_model sapr_model;
+
+/* Версия двоичного интерфейса библиотеки (SAPR_C_ABI_VERSION при сборке) */
+SAPR_C_API int sapr_abi_version(void);
+
+/* Модель из rod_count стержней (rod_count + 1 узлов); все свойства нулевые,
+   допустимое напряжение 0, плотность 7850, заделок нет */
+SAPR_C_API sapr_status sapr_model_create(int rod_count, sapr_model **model);
+SAPR_C_API void sapr_model_destroy(sapr_model *model);
+
+SAPR_C_API int sapr_model_rod_count(const sapr_model *model);
+SAPR_C_API int sapr_model_node_count(const sapr_model *model);
+
+/* Свойства всех стержней: массивы по rod_count значений. sigma_allow может быть NULL
+   (значения не меняются). length, area, elastic_modulus должны быть положительными. */
+SAPR_C_API sapr_status sapr_model_set_rods(sapr_model *model, const double *length,
+                                           const double *area, const double *elastic_modulus,
+                                           const double *distributed_load,
+                                           const double *sigma_allow);
+SAPR_C_API sapr_status sapr_model_set_densities(sapr_model *model, const double *density);
+
+/* Сосредоточенные силы в узлах: node_count значений */
+SAPR_C_API sapr_status sapr_model_set_forces(sapr_model *model, const double *forces);
+
+SAPR_C_API sapr_status sapr_model_set_anchors(sapr_model *model, int left, int right);
+SAPR_C_API sapr_status sapr_model_set_solver_mode(sapr_model *model, sapr_solver_mode mode);
+
+/* Оценка обусловленности в прямом режиме (по умолчанию включена; стоит 2-4 решения) */
+SAPR_C_API sapr_status sapr_model_set_diagnostics(sapr_model *model, int enabled);
+
+/* Расчет. displacements и stresses (напряжения в узлах) - по node_count значений,
+   forces (усилия N(L) в стержнях) - rod_count, reactions - node_count (0 в свободных
+   узлах). Любой выходной буфер, кроме displacements, может быть NULL. */
+SAPR_C_API sapr_status sapr_model_solve(sapr_model *model, double *displacements, double *forces,
+                                        double *stresses, double *reactions);
+
+/* Диагностика последнего успешного расчета; diagnostics->size задает вызывающая сторона */
+SAPR_C_API sapr_status sapr_model_diagnostics(const sapr_model *model,
+                                              sapr_diagnostics *diagnostics);
+
+/* Текст последней ошибки модели (UTF-8), пустая строка после успешного вызова.
+   Указатель действителен до следующего вызова с этой моделью. */
+SAPR_C_API const char *sapr_model_last_error(const sapr_model *model);
+
+/* Текст, соответствующий коду (UTF-8, статическая строка) */
+SAPR_C_API const char *sapr_status_message(sapr_status status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SAPR_C_H */
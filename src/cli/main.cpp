@@ -0,0 +1,26 @@
+#include "commandline.h"
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+
+// Аргументы Windows приходят в UTF-16 и переводятся в UTF-8, как их ожидает CommandLine
+int wmain(int argc, wchar_t *argv[]) {
+    SetConsoleOutputCP(CP_UTF8);
+    std::vector<std::string> args;
+    for (int i = 0; i < argc; i++) {
+        int size = WideCharToMultiByte(CP_UTF8, 0, argv[i], -1, nullptr, 0, nullptr, nullptr);
+        std::string arg(size > 0 ? size - 1 : 0, '\0');
+        if (size > 1) {
+            WideCharToMultiByte(CP_UTF8, 0, argv[i], -1, &arg[0], size, nullptr, nullptr);
+        }
+        args.push_back(arg);
+    }
+    return CommandLine::run(args);
+}
+#else
+int main(int argc, char *argv[]) {
+    return CommandLine::run(std::vector<std::string>(argv, argv + argc));
+}
+#endif
@@ -0,0 +1,123 @@
+#include "basicrodsystem.h"
+#include "solution.h"
+#include "tridiagonalldlt.h"
+
+template <class Scalar> void BasicRodSystem<Scalar>::load(const SaprProject &project) {
+    int count = static_cast<int>(project.bars.size());
+    L.resize(count);
+    A.resize(count);
+    E.resize(count);
+    q.assign(count, Scalar(0.0));
+    F.assign(count > 0 ? count + 1 : 0, Scalar(0.0));
+    for (int p = 0; p < count; p++) {
+        const SaprProject::Bar &bar = project.bars[p];
+        L[p] = Scalar(bar.L);
+        A[p] = Scalar(bar.A);
+        E[p] = Scalar(bar.E);
+        if (p < static_cast<int>(project.barForces.size())) {
+            q[p] = Scalar(project.barForces[p]);
+        }
+    }
+    for (int i = 0; i < static_cast<int>(F.size()) &&
+                    i < static_cast<int>(project.nodeForces.size());
+         i++) {
+        F[i] = Scalar(project.nodeForces[i]);
+    }
+}
+
+template <class Scalar> void BasicRodSystem<Scalar>::solve(bool leftAnchor, bool rightAnchor) {
+    using Ldlt = TridiagonalLdlt<Scalar>;
+    int count = getRodCount();
+    int n = count + 1;
+    if (count <= 0) {
+        throw CalculationError(CalculationError::Code::NoRods, "Нет стержней для расчета");
+    }
+
+    // Сборка, как в RodKernels: diag[i] = k[i-1] + k[i], off[i] = -k[i], b[i] = F[i] + Q[i-1] + Q[i]
+    k.resize(count);
+    Q.resize(count);
+    for (int p = 0; p < count; p++) {
+        k[p] = E[p] * A[p] / L[p];
+        Q[p] = q[p] * L[p] / Scalar(2.0);
+    }
+    diag.resize(n);
+    off.resize(count);
+    rhs.resize(n);
+    diag[0] = Scalar(0.0) + k[0];
+    rhs[0] = F[0] + Q[0];
+    diag[count] = Scalar(0.0) + k[count - 1];
+    rhs[count] = F[count] + Q[count - 1];
+    for (int i = 0; i < count; i++) {
+        off[i] = Scalar(0.0) - k[i];
+    }
+    for (int i = 1; i < count; i++) {
+        diag[i] = (Scalar(0.0) + k[i - 1]) + k[i];
+        rhs[i] = (F[i] + Q[i - 1]) + Q[i];
+    }
+
+    if (leftAnchor) {
+        diag[0] = Scalar(1.0);
+        off[0] = Scalar(0.0);
+        rhs[0] = Scalar(0.0);
+    }
+    if (rightAnchor) {
+        diag[n - 1] = Scalar(1.0);
+        off[n - 2] = Scalar(0.0);
+        rhs[n - 1] = Scalar(0.0);
+    }
+
+    // Масштабирование, разложение и решение - те же шаги, что в TridiagonalSolver:
+    // x = S (S K S)^-1 S b
+    scale.resize(n);
+    d.resize(n);
+    l.resize(count);
+    if (!Ldlt::equilibrate(diag.data(), off.data(), scale.data(), n) ||
+        !Ldlt::factor(diag.data(), off.data(), d.data(), l.data(), n, pivotRatio)) {
+        throw CalculationError(CalculationError::Code::Singular, "Система уравнений вырождена");
+    }
+    for (int i = 0; i < n; i++) {
+        rhs[i] *= Scalar(scale[i]);
+    }
+    Ldlt::solve(d.data(), l.data(), rhs.data(), n);
+    for (int i = 0; i < n; i++) {
+        rhs[i] *= Scalar(scale[i]);
+    }
+    displacements = rhs;
+
+    // Усилия и напряжения: крайние узлы - из крайних стержней, промежуточные - среднее
+    forces.resize(count);
+    std::vector<Scalar> sigma(count);
+    for (int p = 0; p < count; p++) {
+        forces[p] = k[p] * (displacements[p + 1] - displacements[p]) - Q[p];
+        sigma[p] = forces[p] / A[p];
+    }
+    stresses.resize(n);
+    stresses[0] = sigma[0];
+    stresses[count] = sigma[count - 1];
+    for (int i = 1; i < count; i++) {
+        stresses[i] = (sigma[i - 1] + sigma[i]) / Scalar(2.0);
+    }
+
+    // Реакции заделок: R = K u - f для строки без граничного условия
+    reactions.assign(n, Scalar(0.0));
+    const std::vector<Scalar> &u = displacements;
+    for (int i : {0, n - 1}) {
+        if ((i == 0 && !leftAnchor) || (i == n - 1 && !rightAnchor)) {
+            continue;
+        }
+        Scalar residual = F[i];
+        if (i > 0) {
+            residual += Q[i - 1] - k[i - 1] * (u[i] - u[i - 1]);
+        }
+        if (i < n - 1) {
+            residual += Q[i] - k[i] * (u[i] - u[i + 1]);
+        }
+        reactions[i] = -residual;
+    }
+}
+
+template class BasicRodSystem<float>;
+template class BasicRodSystem<double>;
+template class BasicRodSystem<long double>;
+template class BasicRodSystem<Dual<1>>;
+template class BasicRodSystem<Dual<4>>;
@@ -0,0 +1,74 @@
+#ifndef BASICRODSYSTEM_H
+#define BASICRODSYSTEM_H
+
+#include "dual.h"
+#include "saprproject.h"
+#include "scalartraits.h"
+#include <vector>
+
+// Статический расчет стержневой системы над произвольным скалярным типом: сборка,
+// масштабирование степенями двойки, разложение L D L^T, усилия, напряжения и реакции.
+// Масштабирование, разложение и решение - TridiagonalLdlt<Scalar>, общий с TridiagonalSolver;
+// сборка повторяет RodKernels, поэтому BasicRodSystem<double> дает побитово те же
+// перемещения и усилия, что прямой последовательный режим RodSystemCalculator
+// (проверяется тестом src/tests/test_basicrodsystem.cpp).
+//   float       - быстрые массовые расчеты с пониженной точностью;
+//   long double - контрольный расчет с расширенной точностью;
+//   Dual<N>     - значения и точные производные всех результатов по N выбранным
+//                 параметрам стержней за один расчет (параметры задаются через
+//                 Dual<N>::variable, см. length(), area() и т. д.).
+// Шаблон явно инстанцирован в basicrodsystem.cpp для перечисленных типов
+// (Dual<1> и Dual<4>), остальные типы требуют своей инстанциации.
+// RodSystemCalculator остается основным калькулятором в double (векторные ядра,
+// параллельный решатель, смешанная точность, диагностика).
+template <class Scalar> class BasicRodSystem {
+public:
+    using Real = typename ScalarTraits<Scalar>::Real;
+
+    BasicRodSystem() = default;
+    explicit BasicRodSystem(const SaprProject &project) { load(project); }
+
+    // Стержни и силы проекта (значения переводятся в Scalar без производных)
+    void load(const SaprProject &project);
+
+    int getNodeCount() const { return static_cast<int>(F.size()); }
+    int getRodCount() const { return static_cast<int>(L.size()); }
+
+    // Параметры стержня p и сила в узле i (с 0); изменяются до solve()
+    Scalar &length(int p) { return L[p]; }
+    Scalar &area(int p) { return A[p]; }
+    Scalar &elasticModulus(int p) { return E[p]; }
+    Scalar &distributedLoad(int p) { return q[p]; }
+    Scalar &nodeForce(int i) { return F[i]; }
+
+    // CalculationError: нет стержней (NoRods), вырожденная система (Singular)
+    void solve(bool leftAnchor, bool rightAnchor);
+
+    // Результаты последнего solve()
+    const std::vector<Scalar> &getDisplacements() const { return displacements; }
+    const std::vector<Scalar> &getForces() const { return forces; }      // N = EA/L du - qL/2
+    const std::vector<Scalar> &getStresses() const { return stresses; }  // В узлах
+    const std::vector<Scalar> &getReactions() const { return reactions; } // 0 в свободных узлах
+    Real getMinPivotRatio() const { return pivotRatio; }
+
+private:
+    // Свойства стержней по столбцам, как в RodSystemCalculator
+    std::vector<Scalar> L, A, E, q;
+    std::vector<Scalar> F;
+
+    std::vector<Scalar> k, Q;            // EA/L и qL/2
+    std::vector<Scalar> diag, off, rhs;  // Матрица жесткости и правая часть
+    std::vector<Real> scale;             // Масштаб строк (степени двойки)
+    std::vector<Scalar> d, l;            // Разложение L D L^T
+
+    std::vector<Scalar> displacements, forces, stresses, reactions;
+    Real pivotRatio = 1;
+};
+
+extern template class BasicRodSystem<float>;
+extern template class BasicRodSystem<double>;
+extern template class BasicRodSystem<long double>;
+extern template class BasicRodSystem<Dual<1>>;
+extern template class BasicRodSystem<Dual<4>>;
+
+#endif // BASICRODSYSTEM_H
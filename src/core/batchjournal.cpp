@@ -0,0 +1,234 @@
+#include "batchjournal.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <fstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char *journalHeader = "SAPRJOURNAL 1";
+
+uint64_t fnv1a(const void *data, size_t size, uint64_t hash = 14695981039346656037ull) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string hex(uint64_t value) {
+    char text[17];
+    std::snprintf(text, sizeof(text), "%016" PRIx64, value);
+    return text;
+}
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Табуляция и перевод строки в полях заменяются пробелом: они разделяют записи
+std::string field(const std::string &text) {
+    std::string result = text;
+    for (char &c : result) {
+        if (c == '\t' || c == '\n' || c == '\r') {
+            c = ' ';
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+BatchJournal::~BatchJournal() { close(); }
+
+std::string BatchJournal::format(const Entry &entry) {
+    std::string line = field(entry.name) + '\t' + std::to_string(entry.size) + '\t' +
+                       std::to_string(entry.modified) + '\t' + (entry.ok ? "1" : "0") + '\t' +
+                       hex(entry.resultHash) + '\t' + field(entry.row) + '\t';
+    return line + hex(fnv1a(line.data(), line.size())) + '\n';
+}
+
+bool BatchJournal::parse(const std::string &line, Entry &entry) {
+    size_t checkPos = line.rfind('\t');
+    if (checkPos == std::string::npos || line.size() - checkPos != 17 ||
+        hex(fnv1a(line.data(), checkPos + 1)) != line.substr(checkPos + 1)) {
+        return false;
+    }
+
+    std::vector<std::string> fields;
+    size_t begin = 0;
+    for (size_t pos; (pos = line.find('\t', begin)) != std::string::npos && pos < checkPos;
+         begin = pos + 1) {
+        fields.push_back(line.substr(begin, pos - begin));
+    }
+    fields.push_back(line.substr(begin, checkPos - begin));
+    if (fields.size() != 6) {
+        return false;
+    }
+    try {
+        entry.name = fields[0];
+        entry.size = std::stoull(fields[1]);
+        entry.modified = std::stoll(fields[2]);
+        entry.ok = fields[3] == "1";
+        entry.resultHash = std::stoull(fields[4], nullptr, 16);
+        entry.row = fields[5];
+    } catch (const std::exception &) {
+        return false;
+    }
+    return true;
+}
+
+bool BatchJournal::load(const std::filesystem::path &path, std::vector<Entry> &entries,
+                        std::string *error, uint64_t *validSize) {
+    entries.clear();
+    if (validSize) {
+        *validSize = 0;
+    }
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        if (error) {
+            *error = "Не удалось открыть файл";
+        }
+        return false;
+    }
+
+    std::string line;
+    uint64_t offset = 0;
+    bool first = true;
+    // Строка без перевода строки в конце не завершена и не учитывается
+    while (std::getline(in, line) && !in.eof()) {
+        Entry entry;
+        if (first ? line != journalHeader : !parse(line, entry)) {
+            break;
+        }
+        if (!first) {
+            entries.push_back(std::move(entry));
+        }
+        first = false;
+        offset += line.size() + 1;
+    }
+    if (first) {
+        if (error) {
+            *error = "Файл не является журналом пакетного расчета";
+        }
+        return false;
+    }
+    if (validSize) {
+        *validSize = offset;
+    }
+    return true;
+}
+
+bool BatchJournal::open(const std::filesystem::path &path, std::string *error, int groupSize) {
+    close();
+    this->groupSize = std::max(1, groupSize);
+    failed = false;
+
+    std::error_code errorCode;
+    bool exists = std::filesystem::exists(path, errorCode) &&
+                  std::filesystem::file_size(path, errorCode) > 0;
+    if (exists) {
+        std::vector<Entry> entries;
+        uint64_t validSize = 0;
+        if (!load(path, entries, error, &validSize)) {
+            return false;
+        }
+        if (validSize < std::filesystem::file_size(path, errorCode)) {
+            std::filesystem::resize_file(path, validSize, errorCode);
+            if (errorCode) {
+                if (error) {
+                    *error = "Не удалось восстановить журнал";
+                }
+                return false;
+            }
+        }
+    }
+
+#ifdef _WIN32
+    file = _wfopen(path.c_str(), L"ab");
+#else
+    file = std::fopen(path.c_str(), "ab");
+#endif
+    if (!file) {
+        if (error) {
+            *error = "Не удалось открыть файл";
+        }
+        return false;
+    }
+    if (!exists) {
+        pending = std::string(journalHeader) + '\n';
+        sync();
+    }
+    lastSync = nowMs();
+    return !failed;
+}
+
+void BatchJournal::append(const Entry &entry) {
+    if (!file) {
+        return;
+    }
+    pending += format(entry);
+    pendingCount++;
+    if (pendingCount >= groupSize || nowMs() - lastSync >= 1000) {
+        sync();
+    }
+}
+
+bool BatchJournal::sync() {
+    if (!file) {
+        return false;
+    }
+    if (!pending.empty()) {
+        failed |= std::fwrite(pending.data(), 1, pending.size(), file) != pending.size();
+        failed |= std::fflush(file) != 0;
+#ifdef _WIN32
+        failed |= _commit(_fileno(file)) != 0;
+#else
+        failed |= ::fsync(fileno(file)) != 0;
+#endif
+        pending.clear();
+        pendingCount = 0;
+    }
+    lastSync = nowMs();
+    return !failed;
+}
+
+void BatchJournal::close() {
+    if (file) {
+        sync();
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+uint64_t BatchJournal::hash(const Solution &solution) {
+    uint64_t h = fnv1a(nullptr, 0);
+    for (const std::vector<double> *values : {&solution.displacements, &solution.forces,
+                                              &solution.nodalStresses, &solution.reactions}) {
+        h = fnv1a(values->data(), values->size() * sizeof(double), h);
+    }
+    return h;
+}
+
+bool BatchJournal::fingerprint(const std::filesystem::path &path, uint64_t &size,
+                               int64_t &modified) {
+    std::error_code errorCode;
+    size = std::filesystem::file_size(path, errorCode);
+    if (errorCode) {
+        return false;
+    }
+    auto time = std::filesystem::last_write_time(path, errorCode);
+    if (errorCode) {
+        return false;
+    }
+    modified = static_cast<int64_t>(time.time_since_epoch().count());
+    return true;
+}
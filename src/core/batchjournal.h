@@ -0,0 +1,68 @@
+#ifndef BATCHJOURNAL_H
+#define BATCHJOURNAL_H
+
+#include "solution.h"
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Журнал пакетного расчета: по одной строке на завершенный проект, только дозапись.
+// Записи накапливаются и сбрасываются на диск группами с fsync, поэтому после сбоя
+// теряется не больше одной группы. Каждая строка заканчивается контрольной суммой:
+// строка, оборванная сбоем, при чтении отбрасывается вместе со всем, что после нее.
+//
+// Формат: первая строка "SAPRJOURNAL 1", затем строки с полями через табуляцию:
+//   имя (путь относительно каталога пакета), размер файла, время изменения,
+//   1/0 (расчет успешен), хеш результата (16 hex), строка сводки, контрольная сумма (16 hex).
+class BatchJournal {
+public:
+    struct Entry {
+        std::string name;
+        uint64_t size = 0;
+        int64_t modified = 0; // Время изменения файла во внутренних единицах часов ФС
+        bool ok = false;
+        uint64_t resultHash = 0;
+        std::string row; // Строка сводки пакетного режима без перевода строки
+    };
+
+    static constexpr int defaultGroupSize = 256;
+
+    BatchJournal() = default;
+    ~BatchJournal();
+    BatchJournal(const BatchJournal &) = delete;
+    BatchJournal &operator=(const BatchJournal &) = delete;
+
+    // Чтение записей; оборванный хвост пропускается. validSize - длина верной части файла.
+    static bool load(const std::filesystem::path &path, std::vector<Entry> &entries,
+                     std::string *error = nullptr, uint64_t *validSize = nullptr);
+
+    // Открытие для дозаписи: новый файл получает заголовок, оборванный хвост обрезается
+    bool open(const std::filesystem::path &path, std::string *error = nullptr,
+              int groupSize = defaultGroupSize);
+    bool isOpen() const { return file != nullptr; }
+
+    // Запись попадает на диск при заполнении группы, по истечении секунды или при sync()
+    void append(const Entry &entry);
+    bool sync();
+    void close();
+
+    // Хеш перемещений, усилий, напряжений и реакций (FNV-1a по байтам значений)
+    static uint64_t hash(const Solution &solution);
+    // Отпечаток файла для проверки, что проект не изменился после записи в журнал
+    static bool fingerprint(const std::filesystem::path &path, uint64_t &size, int64_t &modified);
+
+private:
+    std::FILE *file = nullptr;
+    std::string pending;
+    int pendingCount = 0;
+    int groupSize = defaultGroupSize;
+    int64_t lastSync = 0;
+    bool failed = false;
+
+    static std::string format(const Entry &entry);
+    static bool parse(const std::string &line, Entry &entry);
+};
+
+#endif // BATCHJOURNAL_H
@@ -0,0 +1,274 @@
+#include "batchpipeline.h"
+#include "lockfreequeue.h"
+#include "profiler.h"
+#include "projectreader.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Item = BatchPipeline::Item;
+using Queue = LockFreeQueue<Item>;
+
+// Счетчики стадии, обновляемые ее потоками; время - в наносекундах от начала прогона
+struct StageCounters {
+    std::atomic<long long> items{0};
+    std::atomic<long long> bytes{0};
+    std::atomic<long long> busy{0};
+    std::atomic<long long> first{-1};
+    std::atomic<long long> last{0};
+
+    void record(Clock::time_point origin, Clock::time_point from, Clock::time_point to,
+                long long count) {
+        long long begin = std::chrono::duration_cast<std::chrono::nanoseconds>(from - origin).count();
+        long long end = std::chrono::duration_cast<std::chrono::nanoseconds>(to - origin).count();
+        items += count;
+        busy += end - begin;
+        long long previous = first.load();
+        while ((previous < 0 || begin < previous) && !first.compare_exchange_weak(previous, begin)) {
+        }
+        previous = last.load();
+        while (end > previous && !last.compare_exchange_weak(previous, end)) {
+        }
+    }
+
+    BatchPipeline::StageStats stats(const char *name, int threads) const {
+        BatchPipeline::StageStats s;
+        s.name = name;
+        s.threads = threads;
+        s.items = items;
+        s.bytes = bytes;
+        s.busyMs = busy / 1e6;
+        s.wallMs = first >= 0 ? (last - first) / 1e6 : 0.0;
+        return s;
+    }
+};
+
+void push(Queue &queue, Item &item) {
+    Backoff backoff;
+    while (!queue.tryPush(item)) {
+        backoff.wait();
+    }
+}
+
+// Следующий элемент; false, когда предыдущая стадия завершена и очередь пуста
+bool pop(Queue &queue, const std::atomic<bool> &upstreamDone, Item &item) {
+    Backoff backoff;
+    while (!queue.tryPop(item)) {
+        if (upstreamDone.load(std::memory_order_acquire)) {
+            // Элемент мог появиться между неудачной попыткой и проверкой флага
+            return queue.tryPop(item);
+        }
+        backoff.wait();
+    }
+    return true;
+}
+
+// Расчет одной модели в отдельном пакете; исключение становится ошибкой ее строки
+void solveAlone(RodSystemBatch &batch, Item &item) {
+    try {
+        batch.clear();
+        batch.add(item.project);
+        item.result = std::move(batch.solve().front());
+    } catch (const std::exception &e) {
+        item.result = RodSystemBatch::Result();
+        item.result.error = e.what();
+    }
+}
+
+// Запуск потоков стадии; done устанавливается, когда завершился последний из них
+template <class Body>
+void startStage(std::vector<std::thread> &threads, int count, std::atomic<int> &running,
+                std::atomic<bool> &done, Body body) {
+    running = count;
+    for (int t = 0; t < count; t++) {
+        threads.emplace_back([&running, &done, body] {
+            body();
+            if (--running == 0) {
+                done.store(true, std::memory_order_release);
+            }
+        });
+    }
+}
+
+} // namespace
+
+std::vector<BatchPipeline::StageStats>
+BatchPipeline::run(const std::vector<std::filesystem::path> &files,
+                   const std::function<void(Item &item)> &write) const {
+    int threads = settings.threads > 0
+                      ? settings.threads
+                      : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    // Для небольших моделей разбор текста занимает не меньше времени, чем расчет
+    int parseThreads = std::max(1, threads / 2);
+    int solveThreads = std::max(1, threads - parseThreads);
+
+    Queue readQueue(settings.queueCapacity);
+    Queue parseQueue(settings.queueCapacity);
+    Queue solveQueue(settings.queueCapacity);
+    std::atomic<bool> readDone{false}, parseDone{false}, solveDone{false};
+    std::atomic<int> readRunning{0}, parseRunning{0}, solveRunning{0};
+    StageCounters reading, parsing, solving, writing;
+    Clock::time_point origin = Clock::now();
+
+    // Окно переупорядочивания: чтение не уходит вперед записи больше чем на window файлов.
+    // Иначе один медленный файл задерживал бы запись, а все следующие результаты
+    // (текст и решение) копились бы в памяти, обходя ограничение очередей.
+    const size_t window = std::max<size_t>(1, settings.queueCapacity);
+    std::atomic<size_t> written{0};
+    std::atomic<bool> cancelled{false}; // Запись прервана исключением
+
+    std::vector<std::thread> pool;
+
+    // Чтение: один поток, файлы целиком в память без разбора
+    startStage(pool, 1, readRunning, readDone, [&] {
+        for (int index = 0; index < static_cast<int>(files.size()); index++) {
+            Backoff backoff;
+            size_t ahead = static_cast<size_t>(index);
+            while (ahead - written.load(std::memory_order_acquire) >= window &&
+                   !cancelled.load(std::memory_order_relaxed)) {
+                backoff.wait();
+            }
+            if (cancelled.load(std::memory_order_relaxed)) {
+                break;
+            }
+
+            Clock::time_point from = Clock::now();
+            ProfileScope profile("BatchPipeline::read");
+            Item item;
+            item.index = index;
+            try {
+                std::ifstream in(files[index], std::ios::binary);
+                if (in) {
+                    std::ostringstream content;
+                    content << in.rdbuf();
+                    item.content = content.str();
+                    reading.bytes += static_cast<long long>(item.content.size());
+                } else {
+                    item.error = "Не удалось открыть файл";
+                }
+            } catch (const std::exception &e) {
+                item.content = std::string();
+                item.error = e.what();
+            }
+            profile.stop();
+            reading.record(origin, from, Clock::now(), 1);
+            push(readQueue, item);
+        }
+    });
+
+    startStage(pool, parseThreads, parseRunning, parseDone, [&] {
+        Item item;
+        while (pop(readQueue, readDone, item)) {
+            Clock::time_point from = Clock::now();
+            ProfileScope profile("BatchPipeline::parse");
+            if (item.error.empty()) {
+                try {
+                    std::istringstream in(std::move(item.content));
+                    ProjectReader::read(in, item.project, &item.error);
+                } catch (const std::exception &e) {
+                    item.project = SaprProject();
+                    item.error = e.what();
+                }
+                item.content = std::string();
+            }
+            profile.stop();
+            parsing.record(origin, from, Clock::now(), 1);
+            push(parseQueue, item);
+        }
+    });
+
+    // Расчет: модели, накопившиеся в очереди, решаются группой RodSystemBatch
+    startStage(pool, solveThreads, solveRunning, solveDone, [&] {
+        RodSystemBatch batch;
+        std::vector<Item> group;
+        Item item;
+        while (pop(parseQueue, parseDone, item)) {
+            Clock::time_point from = Clock::now();
+            group.clear();
+            group.push_back(std::move(item));
+            while (static_cast<int>(group.size()) < RodSystemBatch::lanes &&
+                   parseQueue.tryPop(item)) {
+                group.push_back(std::move(item));
+            }
+
+            ProfileScope profile("BatchPipeline::solve");
+            batch.clear();
+            std::vector<int> slots;
+            for (int g = 0; g < static_cast<int>(group.size()); g++) {
+                if (group[g].error.empty()) {
+                    batch.add(group[g].project);
+                    slots.push_back(g);
+                }
+            }
+            if (!slots.empty()) {
+                try {
+                    std::vector<RodSystemBatch::Result> results = batch.solve();
+                    for (size_t r = 0; r < slots.size(); r++) {
+                        group[slots[r]].result = std::move(results[r]);
+                    }
+                } catch (const std::exception &) {
+                    // Исключение группы относится к одной из моделей: каждая решается
+                    // отдельно, ошибка попадает только в строку своей модели
+                    for (int slot : slots) {
+                        solveAlone(batch, group[slot]);
+                    }
+                }
+                for (int slot : slots) {
+                    group[slot].project = SaprProject();
+                }
+            }
+            profile.stop();
+            solving.record(origin, from, Clock::now(), static_cast<long long>(group.size()));
+            for (Item &done : group) {
+                push(solveQueue, done);
+            }
+        }
+    });
+
+    // Запись в вызывающем потоке: результаты, пришедшие раньше очереди, ждут своего номера.
+    // В полете не больше window файлов, поэтому хватает кольца из window ячеек.
+    std::vector<std::unique_ptr<Item>> pending(window);
+    size_t next = 0;
+    std::exception_ptr failure;
+    Item item;
+    while (pop(solveQueue, solveDone, item)) {
+        if (failure) {
+            continue; // Стадии дорабатывают уже прочитанные файлы, результаты отбрасываются
+        }
+        size_t index = static_cast<size_t>(item.index);
+        pending[index % window].reset(new Item(std::move(item)));
+        try {
+            while (pending[next % window]) {
+                Clock::time_point from = Clock::now();
+                ProfileScope profile("BatchPipeline::write");
+                std::unique_ptr<Item> ready = std::move(pending[next % window]);
+                write(*ready);
+                next++;
+                written.store(next, std::memory_order_release);
+                profile.stop();
+                writing.record(origin, from, Clock::now(), 1);
+            }
+        } catch (...) {
+            failure = std::current_exception();
+            cancelled = true;
+        }
+    }
+
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    return {reading.stats("чтение", 1), parsing.stats("разбор", parseThreads),
+            solving.stats("расчет", solveThreads), writing.stats("запись", 1)};
+}
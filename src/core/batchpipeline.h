@@ -0,0 +1,63 @@
+#ifndef BATCHPIPELINE_H
+#define BATCHPIPELINE_H
+
+#include "rodsystembatch.h"
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Конвейер пакетного расчета каталога: чтение файлов, разбор формата .sapr, расчет
+// и запись результатов выполняются отдельными стадиями одновременно, так что ввод-вывод
+// перекрывается с вычислениями. Стадии связаны очередями LockFreeQueue ограниченной
+// емкости: быстрая стадия ждет медленную, а не накапливает файлы в памяти. Чтение
+// опережает запись не больше чем на queueCapacity файлов, поэтому и результаты,
+// ожидающие записи в порядке files, занимают ограниченную память.
+// Исключение при обработке файла становится ошибкой его строки (Item::error или
+// result.error), исключение из write прерывает прогон и передается из run().
+// Стадия расчета забирает из очереди до RodSystemBatch::lanes моделей и решает их
+// вместе, поэтому результаты совпадают с RodSystemBatch и RodSystemCalculator.
+class BatchPipeline {
+public:
+    struct Settings {
+        int threads = 0;            // Потоков разбора и расчета; 0 - по числу ядер
+        size_t queueCapacity = 256; // Емкость каждой очереди и окна переупорядочивания
+    };
+
+    // Результат по одному файлу
+    struct Item {
+        int index = -1;
+        std::string content;         // Содержимое файла (до разбора)
+        SaprProject project;         // Модель (до расчета)
+        std::string error;           // Ошибка чтения или разбора; модель не решалась
+        RodSystemBatch::Result result;
+    };
+
+    // Показатели стадии за весь прогон
+    struct StageStats {
+        std::string name;
+        int threads = 0;
+        long long items = 0;
+        long long bytes = 0; // Только для чтения
+        double busyMs = 0.0; // Суммарное время работы потоков стадии
+        double wallMs = 0.0; // От первого до последнего элемента стадии
+
+        double itemsPerSecond() const { return wallMs > 0.0 ? items * 1000.0 / wallMs : 0.0; }
+        // Доля времени, которую потоки стадии были заняты
+        double utilization() const {
+            return wallMs > 0.0 && threads > 0 ? busyMs / (wallMs * threads) : 0.0;
+        }
+    };
+
+    BatchPipeline() = default;
+    explicit BatchPipeline(const Settings &settings) : settings(settings) {}
+
+    // Обработка файлов; write вызывается в вызывающем потоке строго в порядке files
+    std::vector<StageStats> run(const std::vector<std::filesystem::path> &files,
+                                const std::function<void(Item &item)> &write) const;
+
+private:
+    Settings settings;
+};
+
+#endif // BATCHPIPELINE_H
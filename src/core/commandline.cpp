@@ -0,0 +1,463 @@
+#include "commandline.h"
+#include "batchjournal.h"
+#include "batchpipeline.h"
+#include "outofcoresolver.h"
+#include "profiler.h"
+#include "projectreader.h"
+#include "rodsystembatch.h"
+#include "rodsystemcalculator.h"
+#include "solutionexporter.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <locale>
+#include <map>
+#include <sstream>
+
+namespace {
+
+std::filesystem::path pathFromUtf8(const std::string &text) {
+    return std::filesystem::u8path(text);
+}
+
+bool hasArgument(const std::vector<std::string> &args, const char *name) {
+    return std::find(args.begin() + std::min<size_t>(1, args.size()), args.end(), name) !=
+           args.end();
+}
+
+} // namespace
+
+std::string CommandLine::option(const std::vector<std::string> &args, const std::string &name) {
+    for (size_t i = 1; i + 1 < args.size(); i++) {
+        if (args[i] == name) {
+            return args[i + 1];
+        }
+    }
+    return std::string();
+}
+
+bool CommandLine::isHeadless(const std::vector<std::string> &args) {
+    return hasArgument(args, "--batch") || hasArgument(args, "--export") ||
+           hasArgument(args, "--merge") || hasArgument(args, "--solve-mapped");
+}
+
+void CommandLine::printUsage() {
+    std::cerr << "Использование:\n"
+                 "  --batch <каталог> [--output <файл.csv>] [--threads N] [--journal <журнал>]"
+                 " [--shard i/N] [--profile <трасса.json>]\n"
+                 "  --merge <журнал>... [--output <файл.csv>] [--journal <общий журнал>]\n"
+                 "  --export <файл.sapr> --output <файл.csv|.json|.bin> [--samples N]"
+                 " [--profile <трасса.json>]\n"
+                 "  --solve-mapped <модель.bin> --output <файл.bin> [--samples N]"
+                 " [--profile <трасса.json>]"
+              << std::endl;
+}
+
+int CommandLine::run(const std::vector<std::string> &args) {
+    // С ключом --profile фазы расчета записываются профилировщиком
+    std::string profilePath = option(args, "--profile");
+    if (!profilePath.empty()) {
+        Profiler::instance().setEnabled(true);
+    }
+
+    int code;
+    if (hasArgument(args, "--batch")) {
+        code = runBatch(args);
+    } else if (hasArgument(args, "--export")) {
+        code = runExport(args);
+    } else if (hasArgument(args, "--merge")) {
+        code = runMerge(args);
+    } else if (hasArgument(args, "--solve-mapped")) {
+        code = runMapped(args);
+    } else {
+        printUsage();
+        return 2;
+    }
+
+    if (!profilePath.empty()) {
+        try {
+            Profiler::instance().saveChromeTrace(pathFromUtf8(profilePath));
+        } catch (const std::exception &e) {
+            std::cerr << e.what() << ": " << profilePath << std::endl;
+            return code != 0 ? code : 2;
+        }
+    }
+    return code;
+}
+
+// Рассчитывает все файлы .sapr каталога (включая подкаталоги) и выводит сводку по каждому
+int CommandLine::runBatch(const std::vector<std::string> &args) {
+    std::string directoryName = option(args, "--batch");
+    if (directoryName.empty()) {
+        printUsage();
+        return 2;
+    }
+    std::filesystem::path directory = pathFromUtf8(directoryName);
+    std::error_code errorCode;
+    if (!std::filesystem::is_directory(directory, errorCode)) {
+        std::cerr << "Каталог не найден: " << directoryName << std::endl;
+        return 2;
+    }
+
+    // --shard i/N: процесс берет файлы с номерами i, i + N, ... общего отсортированного списка
+    int shard = 0, shardCount = 1;
+    std::string shardText = option(args, "--shard");
+    if (!shardText.empty()) {
+        char slash = 0;
+        std::istringstream stream(shardText);
+        if (!(stream >> shard >> slash >> shardCount) || slash != '/' || shardCount < 1 ||
+            shard < 0 || shard >= shardCount) {
+            std::cerr << "Некорректная часть пакета: " << shardText << std::endl;
+            return 2;
+        }
+    }
+
+    BatchPipeline::Settings settings;
+    std::string threadsText = option(args, "--threads");
+    if (!threadsText.empty()) {
+        try {
+            settings.threads = std::stoi(threadsText);
+        } catch (const std::exception &) {
+            std::cerr << "Некорректное число потоков: " << threadsText << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<std::filesystem::path> files;
+    for (auto it = std::filesystem::recursive_directory_iterator(directory, errorCode);
+         !errorCode && it != std::filesystem::recursive_directory_iterator();
+         it.increment(errorCode)) {
+        if (it->is_regular_file(errorCode) && it->path().extension() == ".sapr") {
+            files.push_back(it->path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    if (shardCount > 1) {
+        std::vector<std::filesystem::path> part;
+        for (size_t i = shard; i < files.size(); i += shardCount) {
+            part.push_back(files[i]);
+        }
+        files.swap(part);
+    }
+
+    auto relativeName = [&](const std::filesystem::path &fileName) {
+        return fileName.lexically_relative(directory).generic_u8string();
+    };
+
+    // Журнал: проекты, уже рассчитанные и не изменившиеся с тех пор, не пересчитываются
+    BatchJournal journal;
+    std::vector<BatchJournal::Entry> journaled;
+    std::vector<const BatchJournal::Entry *> finished(files.size(), nullptr);
+    std::vector<std::filesystem::path> todo;
+    std::vector<size_t> todoIndex;
+    std::string journalName = option(args, "--journal");
+    if (!journalName.empty()) {
+        std::filesystem::path journalPath = pathFromUtf8(journalName);
+        std::string error;
+        if (std::filesystem::exists(journalPath, errorCode) &&
+            !BatchJournal::load(journalPath, journaled, &error)) {
+            std::cerr << journalName << ": " << error << std::endl;
+            return 2;
+        }
+        if (!journal.open(journalPath, &error)) {
+            std::cerr << journalName << ": " << error << std::endl;
+            return 2;
+        }
+    }
+    {
+        std::map<std::string, const BatchJournal::Entry *> byName;
+        for (const BatchJournal::Entry &entry : journaled) {
+            byName[entry.name] = &entry; // При повторе имени действует последняя запись
+        }
+        for (size_t i = 0; i < files.size(); i++) {
+            auto it = byName.find(relativeName(files[i]));
+            uint64_t size;
+            int64_t modified;
+            if (it != byName.end() && BatchJournal::fingerprint(files[i], size, modified) &&
+                it->second->size == size && it->second->modified == modified) {
+                finished[i] = it->second;
+            } else {
+                todo.push_back(files[i]);
+                todoIndex.push_back(i);
+            }
+        }
+    }
+
+    std::ofstream file;
+    std::string outName = option(args, "--output");
+    if (!outName.empty()) {
+        file.open(pathFromUtf8(outName));
+        if (!file) {
+            std::cerr << "Не удалось сохранить файл: " << outName << std::endl;
+            return 2;
+        }
+    }
+    std::ostream &out = file.is_open() ? static_cast<std::ostream &>(file) : std::cout;
+    out.imbue(std::locale::classic());
+
+    out << "Файл;Узлов;Статус;max|u|;max|sigma|;Коэф. использования\n";
+
+    // Строки сводки пишутся по мере расчета, в порядке файлов; строки из журнала
+    // вставляются между новыми на свои места
+    auto start = std::chrono::steady_clock::now();
+    int solvedCount = 0;
+    int skipped = 0;
+    int failed = 0;
+    std::vector<std::string> readErrors;
+    size_t nextFile = 0;
+    auto writeJournaled = [&](size_t until) {
+        for (; nextFile < until; nextFile++) {
+            if (finished[nextFile]) {
+                out << finished[nextFile]->row << "\n";
+                failed += finished[nextFile]->ok ? 0 : 1;
+                skipped++;
+            }
+        }
+    };
+
+    BatchPipeline pipeline(settings);
+    std::vector<BatchPipeline::StageStats> stages =
+        pipeline.run(todo, [&](BatchPipeline::Item &item) {
+            size_t fileIndex = todoIndex[item.index];
+            writeJournaled(fileIndex);
+            nextFile = fileIndex + 1;
+
+            const std::filesystem::path &fileName = files[fileIndex];
+            if (!item.error.empty()) {
+                readErrors.push_back(fileName.u8string() + ": " + item.error);
+                return;
+            }
+            const RodSystemBatch::Result &result = item.result;
+            const Solution &solution = result.solution;
+            std::ostringstream row;
+            row.imbue(std::locale::classic());
+            row << relativeName(fileName) << ";" << solution.nodeCount() << ";";
+            if (result.ok) {
+                double utilization = solution.maxUtilization();
+                row << (utilization > 1.0 ? "ПРЕВЫШЕНИЕ" : "OK") << ";"
+                    << solution.maxDisplacement() << ";" << solution.maxStress() << ";"
+                    << utilization;
+            } else {
+                row << "Ошибка: " << result.error << ";;;";
+                failed++;
+            }
+            out << row.str() << "\n";
+            solvedCount++;
+
+            if (journal.isOpen()) {
+                BatchJournal::Entry entry;
+                entry.name = relativeName(fileName);
+                BatchJournal::fingerprint(fileName, entry.size, entry.modified);
+                entry.ok = result.ok;
+                entry.resultHash = result.ok ? BatchJournal::hash(solution) : 0;
+                entry.row = row.str();
+                journal.append(entry);
+            }
+        });
+    writeJournaled(files.size());
+    out.flush();
+    bool journalOk = !journal.isOpen() || journal.sync();
+    journal.close();
+    auto finish = std::chrono::steady_clock::now();
+
+    for (const std::string &error : readErrors) {
+        std::cerr << error << std::endl;
+    }
+    if (!journalOk) {
+        std::cerr << "Ошибка записи журнала: " << journalName << std::endl;
+    }
+
+    double totalMs = std::chrono::duration<double, std::milli>(finish - start).count();
+    std::cerr << "Моделей: " << solvedCount + skipped << ", с ошибками: "
+              << failed + readErrors.size();
+    if (!journalName.empty()) {
+        std::cerr << ", из журнала: " << skipped;
+    }
+    std::cerr << ", всего: " << totalMs << " мс" << std::endl;
+    for (const BatchPipeline::StageStats &stage : stages) {
+        std::cerr << "  " << stage.name << ": потоков " << stage.threads << ", " << stage.items
+                  << " за " << stage.wallMs << " мс, " << stage.itemsPerSecond() << " в с";
+        if (stage.bytes > 0 && stage.wallMs > 0.0) {
+            std::cerr << ", " << stage.bytes / 1048576.0 / (stage.wallMs / 1000.0) << " МБ/с";
+        }
+        std::cerr << ", загрузка " << stage.utilization() * 100.0 << "%" << std::endl;
+    }
+
+    return (failed > 0 || !readErrors.empty() || !journalOk) ? 1 : 0;
+}
+
+// Объединение журналов частей пакета (--shard) в общую сводку и, при --journal, в общий журнал
+int CommandLine::runMerge(const std::vector<std::string> &args) {
+    std::vector<std::string> journalNames;
+    auto it = std::find(args.begin(), args.end(), "--merge");
+    for (++it; it != args.end() && it->compare(0, 2, "--") != 0; ++it) {
+        journalNames.push_back(*it);
+    }
+    if (journalNames.empty()) {
+        printUsage();
+        return 2;
+    }
+
+    // Записи упорядочиваются по пути, как файлы в пакетном режиме
+    std::vector<BatchJournal::Entry> merged;
+    std::map<std::filesystem::path, size_t> byPath;
+    int conflicts = 0;
+    for (const std::string &name : journalNames) {
+        std::vector<BatchJournal::Entry> entries;
+        std::string error;
+        if (!BatchJournal::load(pathFromUtf8(name), entries, &error)) {
+            std::cerr << name << ": " << error << std::endl;
+            return 2;
+        }
+        for (BatchJournal::Entry &entry : entries) {
+            auto [found, inserted] = byPath.emplace(pathFromUtf8(entry.name), merged.size());
+            if (inserted) {
+                merged.push_back(std::move(entry));
+                continue;
+            }
+            BatchJournal::Entry &previous = merged[found->second];
+            if (previous.size == entry.size && previous.modified == entry.modified &&
+                previous.resultHash != entry.resultHash) {
+                std::cerr << "Разные результаты для " << entry.name << std::endl;
+                conflicts++;
+            }
+            previous = std::move(entry);
+        }
+    }
+
+    std::ofstream file;
+    std::string outName = option(args, "--output");
+    if (!outName.empty()) {
+        file.open(pathFromUtf8(outName));
+        if (!file) {
+            std::cerr << "Не удалось сохранить файл: " << outName << std::endl;
+            return 2;
+        }
+    }
+    std::ostream &out = file.is_open() ? static_cast<std::ostream &>(file) : std::cout;
+
+    BatchJournal journal;
+    std::string journalName = option(args, "--journal");
+    if (!journalName.empty()) {
+        std::filesystem::path journalPath = pathFromUtf8(journalName);
+        std::error_code errorCode;
+        std::filesystem::remove(journalPath, errorCode); // Общий журнал создается заново
+        std::string error;
+        if (!journal.open(journalPath, &error)) {
+            std::cerr << journalName << ": " << error << std::endl;
+            return 2;
+        }
+    }
+
+    int failed = 0;
+    out << "Файл;Узлов;Статус;max|u|;max|sigma|;Коэф. использования\n";
+    for (const auto &[path, index] : byPath) {
+        const BatchJournal::Entry &entry = merged[index];
+        out << entry.row << "\n";
+        failed += entry.ok ? 0 : 1;
+        journal.append(entry);
+    }
+    out.flush();
+    bool journalOk = !journal.isOpen() || journal.sync();
+    journal.close();
+
+    std::cerr << "Журналов: " << journalNames.size() << ", моделей: " << byPath.size()
+              << ", с ошибками: " << failed << std::endl;
+    if (!journalOk) {
+        std::cerr << "Ошибка записи журнала: " << journalName << std::endl;
+    }
+    return (failed > 0 || conflicts > 0 || !journalOk) ? 1 : 0;
+}
+
+// Расчет одного проекта и экспорт результата в формат по расширению файла
+int CommandLine::runExport(const std::vector<std::string> &args) {
+    std::string projectName = option(args, "--export");
+    std::string outName = option(args, "--output");
+    if (projectName.empty() || outName.empty()) {
+        printUsage();
+        return 2;
+    }
+
+    std::filesystem::path outPath = pathFromUtf8(outName);
+    SolutionExporter::Format format;
+    if (!SolutionExporter::formatForPath(outPath, format)) {
+        std::cerr << "Неизвестный формат экспорта: " << outName << std::endl;
+        return 2;
+    }
+
+    int samples = SolutionExporter::defaultSamples;
+    std::string samplesText = option(args, "--samples");
+    if (!samplesText.empty()) {
+        try {
+            samples = std::stoi(samplesText);
+        } catch (const std::exception &) {
+            std::cerr << "Некорректное число сечений: " << samplesText << std::endl;
+            return 2;
+        }
+    }
+
+    SaprProject project;
+    std::string error;
+    if (!ProjectReader::load(pathFromUtf8(projectName), project, &error)) {
+        std::cerr << projectName << ": " << error << std::endl;
+        return 1;
+    }
+
+    try {
+        RodSystemCalculator calculator(project);
+        calculator.setLogging(false);
+        Solution solution = calculator.solve(project.leftAnchor, project.rightAnchor);
+        SolutionExporter::save(solution, outPath, format, samples);
+        std::cerr << "Расчет: " << solution.timings.total << " мс" << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << "Ошибка: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Расчет двоичной модели через отображение файлов в память: результат пишется сразу
+// в файл .bin, модель и решение целиком в памяти не размещаются
+int CommandLine::runMapped(const std::vector<std::string> &args) {
+    std::string modelName = option(args, "--solve-mapped");
+    std::string outName = option(args, "--output");
+    if (modelName.empty() || outName.empty()) {
+        printUsage();
+        return 2;
+    }
+
+    std::filesystem::path outPath = pathFromUtf8(outName);
+    SolutionExporter::Format format;
+    if (!SolutionExporter::formatForPath(outPath, format) ||
+        format != SolutionExporter::Format::Binary) {
+        std::cerr << "Результат расчета с отображением файлов пишется только в .bin: " << outName
+                  << std::endl;
+        return 2;
+    }
+
+    OutOfCoreSolver::Settings settings;
+    std::string samplesText = option(args, "--samples");
+    if (!samplesText.empty()) {
+        try {
+            settings.samples = std::stoi(samplesText);
+        } catch (const std::exception &) {
+            std::cerr << "Некорректное число сечений: " << samplesText << std::endl;
+            return 2;
+        }
+    }
+
+    try {
+        OutOfCoreSolver::Report report =
+            OutOfCoreSolver::solve(pathFromUtf8(modelName), outPath, settings);
+        std::cerr << "Стержней: " << report.rods << ", расчет: " << report.timings.total
+                  << " мс (прямой ход " << report.timings.assembly << ", обратный ход "
+                  << report.timings.factorization << ", восстановление "
+                  << report.timings.recovery << ")" << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << "Ошибка: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,38 @@
+#ifndef COMMANDLINE_H
+#define COMMANDLINE_H
+
+#include <string>
+#include <vector>
+
+// Режимы без окна, общие для mini_sapr и sapr_cli. Аргументы передаются в UTF-8,
+// args[0] - имя программы.
+//   --batch <каталог> [--output <файл.csv>] [--threads N]   сводка по всем .sapr каталога
+//           [--journal <журнал>] [--shard i/N]               продолжение прерванного пакета,
+//                                                            доля пакета для одного процесса
+//   --merge <журнал>... [--output <файл.csv>] [--journal <общий журнал>]
+//                                                            сводка по журналам частей пакета
+//   --export <файл.sapr> --output <файл.csv|.json|.bin> [--samples N]
+//   --solve-mapped <модель.bin> --output <файл.bin> [--samples N]
+//                                                            расчет моделей больше памяти
+//   --profile <файл.json>                                    трасса Chrome для любого режима
+class CommandLine {
+public:
+    // Требуется ли режим без окна
+    static bool isHeadless(const std::vector<std::string> &args);
+
+    // Код возврата процесса: 0 - успех, 1 - ошибки расчета или чтения, 2 - ошибка аргументов
+    static int run(const std::vector<std::string> &args);
+
+    static void printUsage();
+
+private:
+    static int runBatch(const std::vector<std::string> &args);
+    static int runExport(const std::vector<std::string> &args);
+    static int runMerge(const std::vector<std::string> &args);
+    static int runMapped(const std::vector<std::string> &args);
+
+    // Значение ключа (следующий аргумент); пустая строка, если ключа нет
+    static std::string option(const std::vector<std::string> &args, const std::string &name);
+};
+
+#endif // COMMANDLINE_H
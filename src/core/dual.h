@@ -0,0 +1,77 @@
+#ifndef DUAL_H
+#define DUAL_H
+
+#include "scalartraits.h"
+#include <array>
+
+// Дуальное число прямого режима автоматического дифференцирования: значение и производные
+// по N независимым переменным. Арифметика над значением совпадает с double побитово,
+// поэтому расчет в Dual дает те же результаты, что и в double, и вместе с ними -
+// точные (без конечных разностей) производные всех величин за один проход.
+template <int N> struct Dual {
+    double v = 0.0;
+    std::array<double, N> d{};
+
+    Dual() = default;
+    Dual(double value) : v(value) {}
+
+    // Независимая переменная номер index (производная по себе равна 1)
+    static Dual variable(double value, int index) {
+        Dual x(value);
+        x.d[index] = 1.0;
+        return x;
+    }
+
+    Dual operator-() const {
+        Dual r(-v);
+        for (int i = 0; i < N; i++) {
+            r.d[i] = -d[i];
+        }
+        return r;
+    }
+
+    Dual &operator+=(const Dual &b) { return *this = *this + b; }
+    Dual &operator-=(const Dual &b) { return *this = *this - b; }
+    Dual &operator*=(const Dual &b) { return *this = *this * b; }
+    Dual &operator/=(const Dual &b) { return *this = *this / b; }
+
+    friend Dual operator+(const Dual &a, const Dual &b) {
+        Dual r(a.v + b.v);
+        for (int i = 0; i < N; i++) {
+            r.d[i] = a.d[i] + b.d[i];
+        }
+        return r;
+    }
+    friend Dual operator-(const Dual &a, const Dual &b) {
+        Dual r(a.v - b.v);
+        for (int i = 0; i < N; i++) {
+            r.d[i] = a.d[i] - b.d[i];
+        }
+        return r;
+    }
+    friend Dual operator*(const Dual &a, const Dual &b) {
+        Dual r(a.v * b.v);
+        for (int i = 0; i < N; i++) {
+            r.d[i] = a.d[i] * b.v + a.v * b.d[i];
+        }
+        return r;
+    }
+    // (a / b)' = (a' - (a / b) b') / b
+    friend Dual operator/(const Dual &a, const Dual &b) {
+        Dual r(a.v / b.v);
+        for (int i = 0; i < N; i++) {
+            r.d[i] = (a.d[i] - r.v * b.d[i]) / b.v;
+        }
+        return r;
+    }
+};
+
+template <int N> struct ScalarTraits<Dual<N>> {
+    using Real = double;
+
+    static Real real(const Dual<N> &x) { return x.v; }
+
+    static constexpr Real singularTolerance = 1e-14;
+};
+
+#endif // DUAL_H
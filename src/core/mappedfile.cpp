@@ -0,0 +1,158 @@
+#include "mappedfile.h"
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MappedFile::open(const std::filesystem::path &path, Mode mode, uint64_t size,
+                      std::string *error) {
+    close();
+    this->mode = mode;
+    auto fail = [&](const char *message) {
+        if (error) {
+            *error = message;
+        }
+        close();
+        return false;
+    };
+
+#ifdef _WIN32
+    bool create = mode == Mode::Create;
+    HANDLE handle = CreateFileW(path.c_str(), create ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                                FILE_SHARE_READ, nullptr, create ? CREATE_ALWAYS : OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return fail(create ? "Не удалось сохранить файл" : "Не удалось открыть файл");
+    }
+    file = handle;
+    if (create) {
+        fileSize = size;
+    } else {
+        LARGE_INTEGER length;
+        if (!GetFileSizeEx(handle, &length)) {
+            return fail("Не удалось открыть файл");
+        }
+        fileSize = static_cast<uint64_t>(length.QuadPart);
+    }
+    if (fileSize > 0) {
+        mapping = CreateFileMappingW(handle, nullptr, create ? PAGE_READWRITE : PAGE_READONLY,
+                                     static_cast<DWORD>(fileSize >> 32),
+                                     static_cast<DWORD>(fileSize), nullptr);
+        if (!mapping) {
+            return fail(create ? "Не удалось сохранить файл" : "Не удалось открыть файл");
+        }
+    }
+#else
+    if (mode == Mode::Create) {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0 || ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            return fail("Не удалось сохранить файл");
+        }
+        fileSize = size;
+    } else {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat info;
+        if (fd < 0 || ::fstat(fd, &info) != 0) {
+            return fail("Не удалось открыть файл");
+        }
+        fileSize = static_cast<uint64_t>(info.st_size);
+    }
+#endif
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    if (mapping) {
+        CloseHandle(mapping);
+        mapping = nullptr;
+    }
+    if (file) {
+        CloseHandle(file);
+        file = nullptr;
+    }
+#else
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+#endif
+    fileSize = 0;
+}
+
+size_t MappedFile::granularity() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#else
+    return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+}
+
+void *MappedFile::map(uint64_t offset, size_t length) const {
+#ifdef _WIN32
+    void *address = MapViewOfFile(mapping, writable() ? FILE_MAP_WRITE : FILE_MAP_READ,
+                                  static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset),
+                                  length);
+    if (!address) {
+        throw std::runtime_error("Не удалось отобразить файл в память");
+    }
+#else
+    void *address = ::mmap(nullptr, length, writable() ? PROT_READ | PROT_WRITE : PROT_READ,
+                           MAP_SHARED, fd, static_cast<off_t>(offset));
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Не удалось отобразить файл в память");
+    }
+#endif
+    return address;
+}
+
+void MappedFile::unmap(void *address, size_t length) {
+#ifdef _WIN32
+    (void)length;
+    UnmapViewOfFile(address);
+#else
+    ::munmap(address, length);
+#endif
+}
+
+MappedColumn::MappedColumn(const MappedFile &file, uint64_t offset, uint64_t count, bool forward,
+                           size_t windowBytes)
+    : file(file), offset(offset), count(count), forward(forward) {
+    size_t granularity = MappedFile::granularity();
+    window = std::max(granularity, windowBytes / granularity * granularity);
+}
+
+MappedColumn::~MappedColumn() {
+    if (base) {
+        MappedFile::unmap(base, mappedLength);
+    }
+}
+
+void MappedColumn::remap(uint64_t position) {
+    if (base) {
+        MappedFile::unmap(base, mappedLength);
+        base = nullptr;
+    }
+    // При обратном ходе окно заканчивается на запрошенном элементе
+    uint64_t granularity = MappedFile::granularity();
+    uint64_t columnEnd = offset + count * sizeof(double);
+    uint64_t start = forward || position + sizeof(double) < window
+                         ? position
+                         : position + sizeof(double) - window;
+    start = std::max(start, offset) / granularity * granularity;
+    uint64_t finish = std::min<uint64_t>(std::min(start + window + granularity, columnEnd),
+                                         file.size());
+    finish = std::max(finish, position + sizeof(double));
+    mappedFrom = start;
+    mappedLength = static_cast<size_t>(finish - start);
+    base = static_cast<char *>(file.map(mappedFrom, mappedLength));
+}
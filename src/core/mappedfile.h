@@ -0,0 +1,90 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+// Файл, отображаемый в память окнами: одновременно отображена только часть файла,
+// поэтому объем резидентной памяти не зависит от размера файла.
+class MappedFile {
+public:
+    enum class Mode {
+        Read,  // Существующий файл только для чтения
+        Create // Новый файл заданного размера (прежнее содержимое удаляется)
+    };
+
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool open(const std::filesystem::path &path, Mode mode, uint64_t size = 0,
+              std::string *error = nullptr);
+    void close();
+
+    uint64_t size() const { return fileSize; }
+    bool writable() const { return mode == Mode::Create; }
+
+    // Граница, по которой выравнивается начало окна
+    static size_t granularity();
+
+    // Отображение [offset, offset + length); offset кратен granularity()
+    void *map(uint64_t offset, size_t length) const;
+    static void unmap(void *address, size_t length);
+
+private:
+    Mode mode = Mode::Read;
+    uint64_t fileSize = 0;
+#ifdef _WIN32
+    void *file = nullptr;
+    void *mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+// Последовательный доступ к столбцу чисел double (little-endian) внутри файла через окно
+// фиксированного размера. Окно сдвигается по мере обращений: вперед для forward = true,
+// назад для обратного хода. Произвольный доступ допустим, но каждый выход
+// за пределы окна стоит нового отображения.
+class MappedColumn {
+public:
+    MappedColumn(const MappedFile &file, uint64_t offset, uint64_t count, bool forward = true,
+                 size_t windowBytes = defaultWindow);
+    ~MappedColumn();
+    MappedColumn(const MappedColumn &) = delete;
+    MappedColumn &operator=(const MappedColumn &) = delete;
+
+    static constexpr size_t defaultWindow = 1 << 20;
+
+    double get(uint64_t i) {
+        double value;
+        std::memcpy(&value, at(i), sizeof(value));
+        return value;
+    }
+    void set(uint64_t i, double value) { std::memcpy(at(i), &value, sizeof(value)); }
+
+private:
+    const MappedFile &file;
+    uint64_t offset;
+    uint64_t count;
+    bool forward;
+    size_t window;
+    char *base = nullptr;     // Начало отображенного окна
+    uint64_t mappedFrom = 0;  // Смещение окна в файле
+    size_t mappedLength = 0;
+
+    char *at(uint64_t i) {
+        uint64_t position = offset + i * sizeof(double);
+        if (!base || position < mappedFrom || position + sizeof(double) > mappedFrom + mappedLength) {
+            remap(position);
+        }
+        return base + (position - mappedFrom);
+    }
+    void remap(uint64_t position);
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,105 @@
+#include "materiallibrary.h"
+
+int MaterialLibrary::findMaterial(const SaprProject &project, const std::string &name) {
+    for (size_t i = 0; i < project.materials.size(); i++) {
+        if (project.materials[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+int MaterialLibrary::findSection(const SaprProject &project, const std::string &name) {
+    for (size_t i = 0; i < project.sections.size(); i++) {
+        if (project.sections[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void MaterialLibrary::assignMaterial(const SaprProject &project, SaprProject::Bar &bar,
+                                     int material) {
+    if (material < 0 || material >= static_cast<int>(project.materials.size())) {
+        bar.material = -1;
+        return;
+    }
+    const SaprProject::Material &value = project.materials[material];
+    bar.material = material;
+    bar.E = value.E;
+    bar.sigma_allow = value.sigma_allow;
+    bar.rho = value.rho;
+}
+
+void MaterialLibrary::assignSection(const SaprProject &project, SaprProject::Bar &bar,
+                                    int section) {
+    if (section < 0 || section >= static_cast<int>(project.sections.size())) {
+        bar.section = -1;
+        return;
+    }
+    bar.section = section;
+    bar.A = project.sections[section].A;
+}
+
+int MaterialLibrary::setMaterial(SaprProject &project, int material, double E,
+                                 double sigma_allow, double rho) {
+    if (material < 0 || material >= static_cast<int>(project.materials.size())) {
+        return 0;
+    }
+    SaprProject::Material &value = project.materials[material];
+    value.E = E;
+    value.sigma_allow = sigma_allow;
+    value.rho = rho;
+
+    int changed = 0;
+    for (SaprProject::Bar &bar : project.bars) {
+        if (bar.material == material) {
+            assignMaterial(project, bar, material);
+            changed++;
+        }
+    }
+    for (SaprProject::Substructure &substructure : project.substructures) {
+        for (SaprProject::Bar &bar : substructure.bars) {
+            if (bar.material == material) {
+                assignMaterial(project, bar, material);
+            }
+        }
+    }
+    return changed;
+}
+
+int MaterialLibrary::setSection(SaprProject &project, int section, double A) {
+    if (section < 0 || section >= static_cast<int>(project.sections.size())) {
+        return 0;
+    }
+    project.sections[section].A = A;
+
+    int changed = 0;
+    for (SaprProject::Bar &bar : project.bars) {
+        if (bar.section == section) {
+            bar.A = A;
+            changed++;
+        }
+    }
+    for (SaprProject::Substructure &substructure : project.substructures) {
+        for (SaprProject::Bar &bar : substructure.bars) {
+            if (bar.section == section) {
+                bar.A = A;
+            }
+        }
+    }
+    return changed;
+}
+
+bool MaterialLibrary::usesMaterial(const SaprProject &project, const SaprProject::Bar &bar) {
+    if (bar.material < 0 || bar.material >= static_cast<int>(project.materials.size())) {
+        return false;
+    }
+    const SaprProject::Material &value = project.materials[bar.material];
+    return bar.E == value.E && bar.sigma_allow == value.sigma_allow && bar.rho == value.rho;
+}
+
+bool MaterialLibrary::usesSection(const SaprProject &project, const SaprProject::Bar &bar) {
+    return bar.section >= 0 && bar.section < static_cast<int>(project.sections.size()) &&
+           bar.A == project.sections[bar.section].A;
+}
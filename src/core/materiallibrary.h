@@ -0,0 +1,30 @@
+#ifndef MATERIALLIBRARY_H
+#define MATERIALLIBRARY_H
+
+#include "saprproject.h"
+#include <string>
+
+// Материалы и сечения библиотеки проекта. Изменение записи библиотеки переносится во все
+// стержни, которые на нее ссылаются (включая стержни подконструкций), так что следующий
+// расчет проекта учитывает его без правки отдельных стержней.
+class MaterialLibrary {
+public:
+    // Номер по имени; -1, если записи нет
+    static int findMaterial(const SaprProject &project, const std::string &name);
+    static int findSection(const SaprProject &project, const std::string &name);
+
+    // Ссылка стержня на запись библиотеки с переносом ее значений в стержень
+    static void assignMaterial(const SaprProject &project, SaprProject::Bar &bar, int material);
+    static void assignSection(const SaprProject &project, SaprProject::Bar &bar, int section);
+
+    // Новые значения записи; возвращается число стержней проекта, получивших их
+    static int setMaterial(SaprProject &project, int material, double E, double sigma_allow,
+                           double rho);
+    static int setSection(SaprProject &project, int section, double A);
+
+    // Значения стержня совпадают с записью, на которую он ссылается
+    static bool usesMaterial(const SaprProject &project, const SaprProject::Bar &bar);
+    static bool usesSection(const SaprProject &project, const SaprProject::Bar &bar);
+};
+
+#endif // MATERIALLIBRARY_H
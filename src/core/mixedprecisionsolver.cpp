@@ -0,0 +1,172 @@
+#include "mixedprecisionsolver.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Потеря всех значащих цифр float, кроме ~4 (64 eps), делает уточнение медленным
+const double floatPivotTolerance = 64.0 * FLT_EPSILON;
+// Погрешность уточнения убывает примерно в 1 / (cond * eps_float) раз за шаг;
+// запас на неточность оценки оставляет не больше 4-5 шагов до точности double
+const double floatConditionLimit = 0.05 / FLT_EPSILON;
+// Дальше число обусловленности превышает точность double: матрица численно вырождена
+const double doubleConditionLimit = 1.0 / DBL_EPSILON;
+
+} // namespace
+
+bool MixedPrecisionSolver::factorFloat() {
+    int n = size();
+    d.resize(n);
+    l.resize(n > 0 ? n - 1 : 0);
+
+    // Ведущий элемент сравнивается с величинами, из которых он получен вычитанием:
+    // малое отношение означает взаимное уничтожение и потерю значащих цифр
+    info.minPivotRatio = 1.0;
+    float prevPivot = 1.0f;
+    for (int i = 0; i < n; i++) {
+        float a = static_cast<float>(scaledDiag[i]);
+        float pivot = a;
+        float eliminated = 0.0f;
+        if (i > 0) {
+            float b = static_cast<float>(scaledOff[i - 1]);
+            l[i - 1] = b / prevPivot;
+            eliminated = l[i - 1] * b;
+            pivot = a - eliminated;
+        }
+        double magnitude = std::abs(a) + std::abs(eliminated);
+        double ratio = magnitude > 0.0 ? std::abs(pivot) / magnitude : 0.0;
+        info.minPivotRatio = std::min(info.minPivotRatio, ratio);
+        if (!(ratio > floatPivotTolerance) || !std::isfinite(pivot)) {
+            return false;
+        }
+        d[i] = pivot;
+        prevPivot = pivot;
+    }
+
+    double inverse = TridiagonalSolver::inverseNorm1Estimate(
+        n, [this](std::vector<double> &v) { solveScaled(v); }, estimate);
+    info.condition = TridiagonalSolver::norm1(scaledDiag, scaledOff) * inverse;
+    return info.condition < floatConditionLimit;
+}
+
+void MixedPrecisionSolver::factor(const std::vector<double> &diagonal,
+                                  const std::vector<double> &offDiagonal) {
+    diag = diagonal;
+    off = offDiagonal;
+    info = Report();
+
+    // ||A||_inf = ||A||_1 для симметричной матрицы
+    normInf = TridiagonalSolver::norm1(diag, off);
+
+    // Масштабирование степенями двойки укладывает элементы в диапазон float;
+    // нулевой диагональный элемент неотрицательно определенной матрицы - вырождение
+    scaledDiag = diag;
+    scaledOff = off;
+    if (!TridiagonalSolver::equilibrate(scaledDiag, scaledOff, scale)) {
+        throw std::runtime_error("Система уравнений вырождена");
+    }
+
+    info.mixed = factorFloat();
+    if (info.mixed) {
+        return;
+    }
+
+    // Разложение в double с проверкой обусловленности вместо абсолютного порога
+    fallback.factor(scaledDiag, scaledOff, true);
+    info.condition = fallback.conditionEstimate(scaledDiag, scaledOff, estimate);
+    info.minPivotRatio = fallback.minPivotRatio();
+    if (!(info.condition < doubleConditionLimit)) {
+        throw std::runtime_error("Система уравнений вырождена (число обусловленности превышает "
+                                 "точность вычислений)");
+    }
+}
+
+void MixedPrecisionSolver::solveScaled(std::vector<double> &v) const {
+    // Решение (S A S) y = v по разложению во float
+    int n = size();
+    w.resize(n);
+    for (int i = 0; i < n; i++) {
+        w[i] = static_cast<float>(v[i]);
+    }
+    for (int i = 1; i < n; i++) {
+        w[i] -= l[i - 1] * w[i - 1];
+    }
+    for (int i = 0; i < n; i++) {
+        w[i] /= d[i];
+    }
+    for (int i = n - 2; i >= 0; i--) {
+        w[i] -= l[i] * w[i + 1];
+    }
+    for (int i = 0; i < n; i++) {
+        v[i] = w[i];
+    }
+}
+
+MixedPrecisionSolver::Refinement MixedPrecisionSolver::solve(std::vector<double> &rhs) const {
+    int n = size();
+    Refinement refinement;
+
+    if (!info.mixed) {
+        // A x = b  =>  x = S (S A S)^-1 S b
+        for (int i = 0; i < n; i++) {
+            rhs[i] *= scale[i];
+        }
+        fallback.solve(rhs);
+        for (int i = 0; i < n; i++) {
+            rhs[i] *= scale[i];
+        }
+        return refinement;
+    }
+
+    double rhsNorm = 0.0;
+    for (int i = 0; i < n; i++) {
+        rhsNorm = std::max(rhsNorm, std::abs(rhs[i]));
+    }
+
+    x.assign(n, 0.0);
+    r.assign(rhs.begin(), rhs.begin() + n);
+    double previous = HUGE_VAL;
+
+    for (int step = 0; step <= maxRefinementSteps; step++) {
+        // Поправка по разложению во float: A dx = r, dx = S (S A S)^-1 S r
+        for (int i = 0; i < n; i++) {
+            r[i] *= scale[i];
+        }
+        solveScaled(r);
+        for (int i = 0; i < n; i++) {
+            x[i] += scale[i] * r[i];
+        }
+
+        // Невязка r = b - A x с накоплением в long double
+        double residual = 0.0;
+        double xNorm = 0.0;
+        for (int i = 0; i < n; i++) {
+            long double sum = static_cast<long double>(rhs[i]) -
+                              static_cast<long double>(diag[i]) * x[i];
+            if (i > 0) {
+                sum -= static_cast<long double>(off[i - 1]) * x[i - 1];
+            }
+            if (i < n - 1) {
+                sum -= static_cast<long double>(off[i]) * x[i + 1];
+            }
+            r[i] = static_cast<double>(sum);
+            residual = std::max(residual, std::abs(r[i]));
+            xNorm = std::max(xNorm, std::abs(x[i]));
+        }
+
+        double denominator = normInf * xNorm + rhsNorm;
+        refinement.backwardError = denominator > 0.0 ? residual / denominator : 0.0;
+        refinement.steps = step;
+
+        if (refinement.backwardError <= DBL_EPSILON ||
+            refinement.backwardError > 0.5 * previous) {
+            break;
+        }
+        previous = refinement.backwardError;
+    }
+
+    std::copy(x.begin(), x.end(), rhs.begin());
+    return refinement;
+}
@@ -0,0 +1,57 @@
+#ifndef MIXEDPRECISIONSOLVER_H
+#define MIXEDPRECISIONSOLVER_H
+
+#include "tridiagonalsolver.h"
+#include <vector>
+
+// Решатель симметричной трехдиагональной системы с разложением в float
+// и итерационным уточнением до точности double. Невязка b - A x накапливается в long double.
+// Перед разложением матрица симметрично масштабируется степенями двойки, чтобы элементы
+// не выходили за диапазон float. Если разложение во float ненадежно (потеря ведущего
+// элемента или большое число обусловленности), используется разложение в double.
+class MixedPrecisionSolver {
+public:
+    struct Report {
+        bool mixed = false;         // Использовано разложение во float
+        double condition = 0.0;     // Оценка числа обусловленности в норме 1 (после масштабирования
+                                    // при разложении во float - она и определяет точность)
+        double minPivotRatio = 0.0; // min |d_i| / (|a_ii| + |l_i-1 a_i,i-1|) - потеря точности
+    };
+
+    // Итоги уточнения одного solve(); у каждого решения свои, в Report не попадают
+    struct Refinement {
+        int steps = 0;              // Шаги уточнения
+        double backwardError = 0.0; // ||b - A x|| / (||A|| ||x|| + ||b||)
+    };
+
+    // Бросает std::runtime_error, если матрица численно вырождена
+    void factor(const std::vector<double> &diag, const std::vector<double> &off);
+    Refinement solve(std::vector<double> &rhs) const; // Решение на месте
+
+    int size() const { return static_cast<int>(diag.size()); }
+    // Сведения о последнем разложении; решения с ним их не меняют
+    const Report &report() const { return info; }
+
+    // Уточнение прекращается при обратной ошибке порядка машинной точности double
+    // или когда очередной шаг уменьшает ее менее чем вдвое
+    static constexpr int maxRefinementSteps = 10;
+
+private:
+    std::vector<double> diag, off; // Исходная матрица для вычисления невязки
+    std::vector<double> scale;     // Диагональ S (степени двойки)
+    std::vector<double> scaledDiag, scaledOff; // S A S
+    std::vector<float> d, l;       // Разложение S A S = L D L^T во float
+    double normInf = 0.0;
+    TridiagonalSolver fallback; // Разложение в double для плохо обусловленных матриц
+    TridiagonalSolver::EstimateBuffers estimate; // Оценка обусловленности в factor()
+
+    // Рабочие буферы solve(); содержимое между вызовами не используется
+    mutable std::vector<double> x, r;
+    mutable std::vector<float> w;
+    Report info;
+
+    bool factorFloat();
+    void solveScaled(std::vector<double> &v) const;
+};
+
+#endif // MIXEDPRECISIONSOLVER_H
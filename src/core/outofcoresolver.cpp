@@ -0,0 +1,452 @@
+#include "outofcoresolver.h"
+#include "mappedfile.h"
+#include "profiler.h"
+#include "tridiagonalldlt.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace {
+
+constexpr uint64_t modelHeader = 20;  // "SAPRMDL\0", версия, число стержней, флаги
+constexpr uint64_t resultHeader = 28; // "SAPRRES\0", версия, узлы, стержни, сечения, флаги
+constexpr uint64_t scratchRecord = 3; // z, l (множитель предыдущей строки), масштаб
+
+// Столбцы читаются и пишутся без перестановки байтов
+bool hostLittleEndian() {
+    uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+uint32_t loadU32(const unsigned char *data) {
+    return static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+           static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+}
+
+void storeU32(unsigned char *data, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        data[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+// Строка матрицы жесткости до масштабирования: диагональ, элемент справа и правая часть
+struct Row {
+    double diag = 0.0;
+    double off = 0.0;
+    double b = 0.0;
+};
+
+using Ldlt = TridiagonalLdlt<double>;
+
+// Масштаб строки степенью двойки, как в TridiagonalSolver::equilibrate
+double rowScale(double diag) {
+    double scale;
+    if (!Ldlt::rowScale(diag, scale)) {
+        throw CalculationError(CalculationError::Code::Singular, "Система уравнений вырождена");
+    }
+    return scale;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point from,
+                 std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// Удаляет рабочий файл всегда, а файл результата - если расчет не завершен
+class OutputGuard {
+public:
+    OutputGuard(const std::filesystem::path &result, const std::filesystem::path &scratch)
+        : result(result), scratch(scratch) {}
+    ~OutputGuard() {
+        std::error_code error;
+        std::filesystem::remove(scratch, error);
+        if (!completed) {
+            std::filesystem::remove(result, error);
+        }
+    }
+    void complete() { completed = true; }
+
+private:
+    std::filesystem::path result;
+    std::filesystem::path scratch;
+    bool completed = false;
+};
+
+} // namespace
+
+OutOfCoreSolver::Report OutOfCoreSolver::solve(const std::filesystem::path &modelPath,
+                                               const std::filesystem::path &resultPath,
+                                               const Settings &settings) {
+    ProfileScope profile("OutOfCoreSolver::solve");
+    auto start = std::chrono::steady_clock::now();
+
+    if (!hostLittleEndian()) {
+        throw std::runtime_error("Расчет с отображением файлов требует порядка байтов little-endian");
+    }
+    if (settings.samples < 2) {
+        throw CalculationError(CalculationError::Code::InvalidInput,
+                               "Число сечений должно быть не меньше 2");
+    }
+
+    std::string error;
+    MappedFile model;
+    if (!model.open(modelPath, MappedFile::Mode::Read, 0, &error)) {
+        throw std::runtime_error(error);
+    }
+    if (model.size() < modelHeader) {
+        throw std::runtime_error("Неизвестный формат модели");
+    }
+
+    Report report;
+    {
+        void *header = model.map(0, static_cast<size_t>(modelHeader));
+        const unsigned char *data = static_cast<const unsigned char *>(header);
+        bool known = std::memcmp(data, "SAPRMDL", 8) == 0;
+        uint32_t version = loadU32(data + 8);
+        report.rods = loadU32(data + 12);
+        uint32_t flags = loadU32(data + 16);
+        MappedFile::unmap(header, static_cast<size_t>(modelHeader));
+
+        if (!known) {
+            throw std::runtime_error("Неизвестный формат модели");
+        }
+        if (version != 1) {
+            throw std::runtime_error("Неподдерживаемая версия модели");
+        }
+        report.leftAnchor = (flags & 1u) != 0;
+        report.rightAnchor = (flags & 2u) != 0;
+    }
+    if (report.rods == 0) {
+        throw CalculationError(CalculationError::Code::NoRods, "Нет стержней для расчета");
+    }
+    // Число узлов записывается в результат как uint32
+    if (report.rods >= std::numeric_limits<uint32_t>::max()) {
+        throw CalculationError(CalculationError::Code::InvalidInput, "Слишком много стержней");
+    }
+    if (!report.leftAnchor && !report.rightAnchor) {
+        throw CalculationError(CalculationError::Code::InvalidInput,
+                               "Система должна иметь хотя бы одну заделку");
+    }
+
+    const uint64_t rods = report.rods;
+    const uint64_t nodes = rods + 1;
+    const uint64_t last = nodes - 1;
+    const uint64_t samples = static_cast<uint64_t>(settings.samples);
+    report.nodes = nodes;
+    if (model.size() < modelHeader + (6 * rods + nodes) * sizeof(double)) {
+        throw std::runtime_error("Модель обрезана");
+    }
+
+    // Столбцы модели: L, A, E, sigma_allow, rho, q (по стержням), F (по узлам)
+    auto modelColumn = [&](int index) { return modelHeader + index * rods * sizeof(double); };
+    // Столбцы результата: 4 по узлам, 8 по стержням, 4 по сечениям
+    auto nodeColumn = [&](int index) { return resultHeader + index * nodes * sizeof(double); };
+    auto rodColumn = [&](int index) {
+        return resultHeader + (4 * nodes + index * rods) * sizeof(double);
+    };
+    auto sectionColumn = [&](int index) {
+        return resultHeader + (4 * nodes + 8 * rods + index * rods * samples) * sizeof(double);
+    };
+
+    std::filesystem::path scratchPath = settings.scratchPath;
+    if (scratchPath.empty()) {
+        scratchPath = resultPath;
+        scratchPath += ".scratch";
+    }
+    OutputGuard guard(resultPath, scratchPath);
+
+    MappedFile result;
+    MappedFile scratch;
+    if (!result.open(resultPath, MappedFile::Mode::Create, sectionColumn(4), &error) ||
+        !scratch.open(scratchPath, MappedFile::Mode::Create,
+                      scratchRecord * nodes * sizeof(double), &error)) {
+        throw std::runtime_error(error);
+    }
+    const size_t window = settings.windowBytes;
+    const bool leftAnchor = report.leftAnchor;
+    const bool rightAnchor = report.rightAnchor;
+    SolveDiagnostics &diagnostics = report.diagnostics;
+
+    // Проход 1: сборка, масштабирование S K S, разложение и прямой ход.
+    // Порядок операций повторяет RodKernels::assemble, equilibrate и TridiagonalSolver,
+    // поэтому перемещения совпадают с расчетом в памяти побитово.
+    {
+        ProfileScope passProfile("OutOfCoreSolver::forward");
+        MappedColumn L(model, modelColumn(0), rods, true, window);
+        MappedColumn A(model, modelColumn(1), rods, true, window);
+        MappedColumn E(model, modelColumn(2), rods, true, window);
+        MappedColumn q(model, modelColumn(5), rods, true, window);
+        MappedColumn F(model, modelColumn(6), nodes, true, window);
+        MappedColumn records(scratch, 0, scratchRecord * nodes, true, window);
+
+        auto element = [&](uint64_t p, double &k, double &Q) {
+            double length = L.get(p);
+            double area = A.get(p);
+            double modulus = E.get(p);
+            if (length <= 0 || area <= 0 || modulus <= 0) {
+                throw CalculationError(
+                    CalculationError::Code::InvalidInput,
+                    "Длина, площадь и модуль упругости должны быть положительными");
+            }
+            k = modulus * area / length;
+            Q = q.get(p) * length / 2.0;
+        };
+        // Строка узла i по стержням слева (kLeft, QLeft) и справа (kRight, QRight)
+        auto row = [&](uint64_t i, double kLeft, double QLeft, double kRight, double QRight) {
+            Row r;
+            double force = F.get(i);
+            if (i == 0) {
+                r.diag = 0.0 + kRight;
+                r.b = force + QRight;
+            } else if (i == last) {
+                r.diag = 0.0 + kLeft;
+                r.b = force + QLeft;
+            } else {
+                r.diag = (0.0 + kLeft) + kRight;
+                r.b = (force + QLeft) + QRight;
+            }
+            r.off = i < last ? 0.0 - kRight : 0.0;
+            if ((i == 0 && leftAnchor) || (i == last && rightAnchor)) {
+                r.diag = 1.0;
+                r.b = 0.0;
+            }
+            if ((i == 0 && leftAnchor) || (i + 1 == last && rightAnchor)) {
+                r.off = 0.0;
+            }
+            return r;
+        };
+
+        double kRod, QRod; // Стержень справа от текущего узла
+        element(0, kRod, QRod);
+        Row current = row(0, 0.0, 0.0, kRod, QRod);
+        double scale = rowScale(current.diag);
+
+        double pivotRatio = 1.0;
+        double previousOff = 0.0;   // Масштабированный элемент справа предыдущей строки
+        double previousPivot = 0.0; // Ведущий элемент предыдущей строки
+        double previousY = 0.0;     // Решение L y = S b в предыдущем узле
+        for (uint64_t i = 0; i < nodes; i++) {
+            // Масштаб следующей строки нужен для элемента справа текущей
+            Row next;
+            double nextScale = 0.0;
+            if (i < last) {
+                double kNext = 0.0, QNext = 0.0;
+                if (i + 1 < rods) {
+                    element(i + 1, kNext, QNext);
+                }
+                next = row(i + 1, kRod, QRod, kNext, QNext);
+                nextScale = rowScale(next.diag);
+                kRod = kNext;
+                QRod = QNext;
+            }
+
+            double y = current.b * scale;
+            double l = 0.0;
+            double diag = scale * current.diag * scale;
+            Ldlt::Pivot p = i > 0 ? Ldlt::pivot(diag, previousOff, previousPivot, l)
+                                  : Ldlt::pivot(diag);
+            if (i > 0) {
+                y -= l * previousY;
+            }
+            if (!Ldlt::accept(p, pivotRatio)) {
+                throw CalculationError(CalculationError::Code::Singular,
+                                       "Система уравнений вырождена");
+            }
+            double pivot = p.value;
+
+            records.set(scratchRecord * i, y / pivot);
+            records.set(scratchRecord * i + 1, l);
+            records.set(scratchRecord * i + 2, scale);
+
+            previousOff = i < last ? scale * current.off * nextScale : 0.0;
+            previousPivot = pivot;
+            previousY = y;
+            current = next;
+            scale = nextScale;
+        }
+        diagnostics.minPivotRatio = pivotRatio;
+    }
+    auto forward = std::chrono::steady_clock::now();
+    report.timings.assembly = elapsedMs(start, forward);
+
+    // Проход 2: обратный ход L^T x = z, u = S x
+    {
+        ProfileScope passProfile("OutOfCoreSolver::backward");
+        MappedColumn records(scratch, 0, scratchRecord * nodes, false, window);
+        MappedColumn u(result, nodeColumn(1), nodes, false, window);
+        double x = 0.0;
+        double lNext = 0.0; // Множитель, хранящийся в записи следующего узла
+        for (uint64_t i = nodes; i-- > 0;) {
+            double z = records.get(scratchRecord * i);
+            x = i < last ? z - lNext * x : z;
+            u.set(i, x * records.get(scratchRecord * i + 2));
+            lNext = records.get(scratchRecord * i + 1);
+        }
+    }
+    auto backward = std::chrono::steady_clock::now();
+    report.timings.factorization = elapsedMs(forward, backward);
+
+    // Проход 3: восстановление по перемещениям, как RodSystemCalculator::calculateInto,
+    // checkEquilibrium и Solution::completeSections
+    {
+        ProfileScope passProfile("OutOfCoreSolver::recovery");
+        MappedColumn L(model, modelColumn(0), rods, true, window);
+        MappedColumn A(model, modelColumn(1), rods, true, window);
+        MappedColumn E(model, modelColumn(2), rods, true, window);
+        MappedColumn allowed(model, modelColumn(3), rods, true, window);
+        MappedColumn q(model, modelColumn(5), rods, true, window);
+        MappedColumn F(model, modelColumn(6), nodes, true, window);
+
+        MappedColumn coordinates(result, nodeColumn(0), nodes, true, window);
+        MappedColumn u(result, nodeColumn(1), nodes, true, window);
+        MappedColumn nodalStresses(result, nodeColumn(2), nodes, true, window);
+        MappedColumn reactions(result, nodeColumn(3), nodes, true, window);
+        MappedColumn lengths(result, rodColumn(0), rods, true, window);
+        MappedColumn startForces(result, rodColumn(1), rods, true, window);
+        MappedColumn forces(result, rodColumn(2), rods, true, window);
+        MappedColumn startStresses(result, rodColumn(3), rods, true, window);
+        MappedColumn endStresses(result, rodColumn(4), rods, true, window);
+        MappedColumn maxStresses(result, rodColumn(5), rods, true, window);
+        MappedColumn allowedStresses(result, rodColumn(6), rods, true, window);
+        MappedColumn utilizations(result, rodColumn(7), rods, true, window);
+        MappedColumn sectionCoordinates(result, sectionColumn(0), rods * samples, true, window);
+        MappedColumn sectionForces(result, sectionColumn(1), rods * samples, true, window);
+        MappedColumn sectionStresses(result, sectionColumn(2), rods * samples, true, window);
+        MappedColumn sectionDisplacements(result, sectionColumn(3), rods * samples, true, window);
+
+        double total = 0.0;
+        double totalMagnitude = 0.0;
+        double coordinate = 0.0;
+        double uCurrent = u.get(0);
+        double uPrevious = 0.0;
+        double kPrevious = 0.0, QPrevious = 0.0, sigmaPrevious = 0.0;
+        for (uint64_t i = 0; i < nodes; i++) {
+            double uNext = i < last ? u.get(i + 1) : 0.0;
+            coordinates.set(i, coordinate);
+
+            // Стержень p = i справа от узла
+            double k = 0.0, Q = 0.0, sigma = 0.0;
+            if (i < last) {
+                double length = L.get(i);
+                double area = A.get(i);
+                double modulus = E.get(i);
+                double load = q.get(i);
+                double sigmaAllow = allowed.get(i);
+
+                k = modulus * area / length;
+                Q = load * length / 2.0;
+                double force = k * (uNext - uCurrent) - Q;
+                sigma = force / area;
+                double startForce = force + load * length;
+                double startStress = startForce / area;
+                double bulge = load / (2.0 * modulus * area);
+
+                double N0 = (modulus * area / length) * (uNext - uCurrent) + load * length / 2.0;
+                double NL = N0 - load * length;
+                double maxStress = std::abs(N0) >= std::abs(NL) ? std::abs(N0) / area
+                                                                : std::abs(NL) / area;
+                double utilization;
+                if (sigmaAllow > 0) {
+                    utilization = maxStress / sigmaAllow;
+                } else {
+                    utilization = maxStress > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+                }
+
+                lengths.set(i, length);
+                startForces.set(i, startForce);
+                forces.set(i, force);
+                startStresses.set(i, startStress);
+                endStresses.set(i, sigma);
+                maxStresses.set(i, maxStress);
+                allowedStresses.set(i, sigmaAllow);
+                utilizations.set(i, utilization);
+
+                for (uint64_t s = 0; s < samples; s++) {
+                    double x = length * static_cast<int>(s) / (static_cast<int>(samples) - 1);
+                    double t = length > 0 ? x / length : 0.0;
+                    uint64_t index = i * samples + s;
+                    sectionCoordinates.set(index, coordinate + x);
+                    sectionForces.set(index, startForce + (force - startForce) * t);
+                    sectionStresses.set(index, startStress + (sigma - startStress) * t);
+                    sectionDisplacements.set(index, uCurrent + (uNext - uCurrent) * t +
+                                                        bulge * x * (length - x));
+                }
+                coordinate = coordinate + length;
+            }
+
+            if (i == 0) {
+                nodalStresses.set(i, sigma);
+            } else if (i == last) {
+                nodalStresses.set(i, sigmaPrevious);
+            } else {
+                nodalStresses.set(i, (sigmaPrevious + sigma) / 2.0);
+            }
+
+            // Невязка равновесия узла и реакция заделки
+            double force = F.get(i);
+            double residual = force;
+            double magnitude = std::abs(force);
+            if (i > 0) {
+                double internal = kPrevious * (uCurrent - uPrevious);
+                residual += QPrevious - internal;
+                magnitude += std::abs(QPrevious) + std::abs(internal);
+            }
+            if (i < last) {
+                double internal = k * (uCurrent - uNext);
+                residual += Q - internal;
+                magnitude += std::abs(Q) + std::abs(internal);
+            }
+            total += force;
+            totalMagnitude += std::abs(force);
+            if (i < last) {
+                total += 2.0 * Q;
+                totalMagnitude += 2.0 * std::abs(Q);
+            }
+            if ((i == 0 && leftAnchor) || (i == last && rightAnchor)) {
+                reactions.set(i, -residual);
+                total += -residual;
+                totalMagnitude += std::abs(residual);
+            } else {
+                reactions.set(i, 0.0);
+                double relative = magnitude > 0.0 ? std::abs(residual) / magnitude : 0.0;
+                if (relative > diagnostics.equilibriumResidual || diagnostics.worstNode < 0) {
+                    diagnostics.equilibriumResidual = relative;
+                    diagnostics.worstNode = static_cast<int>(
+                        std::min<uint64_t>(i, std::numeric_limits<int>::max()));
+                }
+            }
+
+            uPrevious = uCurrent;
+            uCurrent = uNext;
+            kPrevious = k;
+            QPrevious = Q;
+            sigmaPrevious = sigma;
+        }
+        diagnostics.globalResidual = totalMagnitude > 0.0 ? std::abs(total) / totalMagnitude : 0.0;
+    }
+
+    // Заголовок пишется последним: недописанный файл не распознается как результат
+    {
+        void *header = result.map(0, static_cast<size_t>(resultHeader));
+        unsigned char *data = static_cast<unsigned char *>(header);
+        std::memcpy(data, "SAPRRES", 8);
+        storeU32(data + 8, 1);
+        storeU32(data + 12, static_cast<uint32_t>(nodes));
+        storeU32(data + 16, static_cast<uint32_t>(rods));
+        storeU32(data + 20, static_cast<uint32_t>(samples));
+        storeU32(data + 24, (leftAnchor ? 1u : 0u) | (rightAnchor ? 2u : 0u));
+        MappedFile::unmap(header, static_cast<size_t>(resultHeader));
+    }
+    result.close();
+    scratch.close();
+    guard.complete();
+
+    auto finish = std::chrono::steady_clock::now();
+    report.timings.recovery = elapsedMs(backward, finish);
+    report.timings.total = elapsedMs(start, finish);
+    return report;
+}
@@ -0,0 +1,49 @@
+#ifndef OUTOFCORESOLVER_H
+#define OUTOFCORESOLVER_H
+
+#include "solution.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// Расчет моделей, не помещающихся в память. Двоичная модель (формат описан в projectreader.h)
+// читается через окна отображения в память, результат пишется в отображенный файл
+// в формате SolutionExporter (.bin) - побитово совпадающий с экспортом после
+// RodSystemCalculator::solve в последовательном прямом режиме. Объем резидентной памяти
+// определяется размером окон и не зависит от числа стержней.
+//
+// Три последовательных прохода:
+//   1) сборка строк матрицы, масштабирование, разложение и прямой ход; в рабочий файл
+//      пишутся z = y / d, множитель l и масштаб строки;
+//   2) обратный ход от последнего узла к первому, перемещения - сразу в файл результата;
+//   3) усилия, напряжения, реакции, проверка прочности и сечения.
+class OutOfCoreSolver {
+public:
+    struct Settings {
+        int samples = 11; // Сечений на стержень, включая концы (как SolutionExporter)
+        size_t windowBytes = 1 << 20; // Окно каждого столбца
+        // Рабочий файл разложения; по умолчанию рядом с результатом (<результат>.scratch).
+        // Удаляется после расчета.
+        std::filesystem::path scratchPath;
+    };
+
+    struct Report {
+        uint64_t rods = 0;
+        uint64_t nodes = 0;
+        bool leftAnchor = false;
+        bool rightAnchor = false;
+        SolveDiagnostics diagnostics; // Оценка обусловленности не вычисляется
+        SolveTimings timings;         // assembly - проход 1, factorization - проход 2
+    };
+
+    // Исключения: CalculationError - некорректные данные или вырожденная система,
+    // std::runtime_error - ошибки чтения и записи файлов. При ошибке файл результата удаляется.
+    static Report solve(const std::filesystem::path &modelPath,
+                        const std::filesystem::path &resultPath, const Settings &settings);
+    static Report solve(const std::filesystem::path &modelPath,
+                        const std::filesystem::path &resultPath) {
+        return solve(modelPath, resultPath, Settings());
+    }
+};
+
+#endif // OUTOFCORESOLVER_H
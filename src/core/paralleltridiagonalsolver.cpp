@@ -0,0 +1,155 @@
+#include "paralleltridiagonalsolver.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+int ParallelTridiagonalSolver::threads() const {
+    if (threadCount > 0) {
+        return threadCount;
+    }
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void ParallelTridiagonalSolver::factor(const std::vector<double> &diag,
+                                       const std::vector<double> &off) {
+    int size = static_cast<int>(diag.size());
+    int blocks = std::max(1, std::min(threads(), size / minBlockSize));
+
+    begin.resize(blocks);
+    end.resize(blocks);
+    for (int k = 0; k < blocks; k++) {
+        begin[k] = static_cast<int>(static_cast<long long>(size) * k / blocks);
+        end[k] = static_cast<int>(static_cast<long long>(size) * (k + 1) / blocks) - 1;
+    }
+    end[blocks - 1] = size; // У последнего блока разделителя нет
+
+    d.assign(size, 0.0);
+    l.assign(size, 0.0);
+    // Шипы нужны только при нескольких блоках
+    leftSpike.assign(blocks > 1 ? size : 0, 0.0);
+    rightSpike.assign(blocks > 1 ? size : 0, 0.0);
+    separatorLeft.assign(std::max(0, blocks - 1), 0.0);
+    separatorRight.assign(std::max(0, blocks - 1), 0.0);
+
+    ratios.assign(blocks, 1.0);
+    singular.assign(blocks, 0);
+    auto factorBlock = [&](int k) {
+        // Разложение внутренней части теми же шагами, что в TridiagonalSolver
+        using Ldlt = TridiagonalLdlt<double>;
+        for (int i = begin[k]; i < end[k]; i++) {
+            Ldlt::Pivot p = i > begin[k] ? Ldlt::pivot(diag[i], off[i - 1], d[i - 1], l[i])
+                                         : Ldlt::pivot(diag[i]);
+            if (!Ldlt::accept(p, ratios[k])) {
+                singular[k] = 1;
+                return;
+            }
+            d[i] = p.value;
+        }
+
+        if (k > 0) {
+            leftSpike[begin[k]] = off[begin[k] - 1];
+            solveBlock(k, leftSpike.data());
+        }
+        if (k < blocks - 1) {
+            rightSpike[end[k] - 1] = off[end[k] - 1];
+            solveBlock(k, rightSpike.data());
+        }
+    };
+    pool.run(blocks, factorBlock);
+    if (std::find(singular.begin(), singular.end(), 1) != singular.end()) {
+        throw std::runtime_error("Система уравнений вырождена");
+    }
+    pivotRatio = *std::min_element(ratios.begin(), ratios.end());
+
+    // Дополнение Шура: связь разделителя j с соседними блоками j и j + 1. Разложение
+    // выполняется здесь же: порог вырожденности учитывает величины, исключенные при
+    // построении дополнения, иначе вырожденная система (без заделок) не распознается
+    int separators = blocks - 1;
+    reducedD.assign(separators, 0.0);
+    reducedL.assign(separators, 0.0);
+    double previousOff = 0.0;
+    for (int j = 0; j < separators; j++) {
+        int t = end[j];
+        separatorLeft[j] = off[t - 1];
+        separatorRight[j] = off[t];
+        double fromLeft = off[t - 1] * rightSpike[t - 1];
+        double fromRight = off[t] * leftSpike[t + 1];
+        double pivot = diag[t] - fromLeft - fromRight;
+        double magnitude = std::abs(diag[t]) + std::abs(fromLeft) + std::abs(fromRight);
+        double reducedMagnitude = std::abs(pivot);
+        if (j > 0) {
+            reducedL[j] = previousOff / reducedD[j - 1];
+            double eliminated = reducedL[j] * previousOff;
+            pivot -= eliminated;
+            magnitude += std::abs(eliminated);
+            reducedMagnitude += std::abs(eliminated);
+        }
+        if (!(std::abs(pivot) > magnitude * 1e-14)) {
+            throw std::runtime_error("Система уравнений вырождена");
+        }
+        pivotRatio = std::min(pivotRatio, std::abs(pivot) / reducedMagnitude);
+        reducedD[j] = pivot;
+        previousOff = -off[t] * rightSpike[t + 1]; // Связь с разделителем j + 1 через блок j + 1
+    }
+}
+
+void ParallelTridiagonalSolver::solveBlock(int k, double *x) const {
+    int first = begin[k];
+    int last = end[k];
+    for (int i = first + 1; i < last; i++) {
+        x[i] -= l[i] * x[i - 1];
+    }
+    for (int i = first; i < last; i++) {
+        x[i] /= d[i];
+    }
+    for (int i = last - 2; i >= first; i--) {
+        x[i] -= l[i + 1] * x[i + 1];
+    }
+}
+
+void ParallelTridiagonalSolver::solve(std::vector<double> &rhs) const {
+    int blocks = blockCount();
+    auto solveInterior = [&](int k) { solveBlock(k, rhs.data()); };
+    pool.run(blocks, solveInterior);
+    if (blocks == 1) {
+        return;
+    }
+
+    // Разделители: правая часть дополнения Шура и решение с готовым разложением
+    int count = blocks - 1;
+    separators.resize(count);
+    for (int j = 0; j < count; j++) {
+        int t = end[j];
+        separators[j] = rhs[t] - separatorLeft[j] * rhs[t - 1] - separatorRight[j] * rhs[t + 1];
+        if (j > 0) {
+            separators[j] -= reducedL[j] * separators[j - 1];
+        }
+    }
+    for (int j = count - 1; j >= 0; j--) {
+        separators[j] /= reducedD[j];
+        if (j + 1 < count) {
+            separators[j] -= reducedL[j + 1] * separators[j + 1];
+        }
+    }
+
+    auto correct = [&](int k) {
+        double left = k > 0 ? separators[k - 1] : 0.0;
+        double right = k + 1 < blocks ? separators[k] : 0.0;
+        for (int i = begin[k]; i < end[k]; i++) {
+            rhs[i] -= leftSpike[i] * left + rightSpike[i] * right;
+        }
+        if (k + 1 < blocks) {
+            rhs[end[k]] = right;
+        }
+    };
+    pool.run(blocks, correct);
+}
+
+double ParallelTridiagonalSolver::conditionEstimate(
+    const std::vector<double> &diag, const std::vector<double> &off,
+    TridiagonalSolver::EstimateBuffers &buffers) const {
+    double inverse = TridiagonalSolver::inverseNorm1Estimate(
+        size(), [this](std::vector<double> &v) { solve(v); }, buffers);
+    return TridiagonalSolver::norm1(diag, off) * inverse;
+}
@@ -0,0 +1,65 @@
+#ifndef PARALLELTRIDIAGONALSOLVER_H
+#define PARALLELTRIDIAGONALSOLVER_H
+
+#include "tridiagonalsolver.h"
+#include "workerpool.h"
+#include <vector>
+
+// Многопоточный решатель симметричных трехдиагональных систем методом разбиения
+// (вариант SPIKE для симметричных матриц). Строки делятся на блоки по числу потоков;
+// последняя строка каждого блока, кроме последнего, - разделитель. Внутренние части
+// блоков раскладываются (L D L^T) и решаются независимо, вместе с двумя "шипами" -
+// откликами на связи с соседними разделителями. Разделители образуют трехдиагональное
+// дополнение Шура размером (блоков - 1), которое решается последовательно, после чего
+// решение внутри блоков восстанавливается также параллельно.
+//
+// Объем вычислений в 1.5-2 раза больше, чем у TridiagonalSolver, поэтому выигрыш
+// появляется на длинных системах и нескольких ядрах; результат совпадает
+// с последовательным решением до ошибок округления, но не побитово.
+class ParallelTridiagonalSolver {
+public:
+    // Системы короче не делятся на блоки (RodSystemCalculator::setParallelThreshold).
+    // Значение предварительное: ускорение по числу потоков на многоядерных машинах
+    // еще не измерено. Для конкретной машины порог следует подобрать по таблице
+    // sapr_bench (последний раздел) и задать через setParallelThreshold.
+    static constexpr int defaultThreshold = 1 << 18;
+    static constexpr int minBlockSize = 1 << 14;
+
+    // Число потоков: 0 - по числу ядер
+    void setThreads(int threads) { threadCount = threads; }
+    int threads() const;
+
+    // Разложение; при вырожденности - std::runtime_error, как у TridiagonalSolver
+    void factor(const std::vector<double> &diag, const std::vector<double> &off);
+    void solve(std::vector<double> &rhs) const; // Решение на месте
+
+    int size() const { return static_cast<int>(d.size()); }
+    int blockCount() const { return static_cast<int>(begin.size()); }
+    double minPivotRatio() const { return pivotRatio; }
+
+    // Оценка числа обусловленности по этому разложению (см. TridiagonalSolver)
+    double conditionEstimate(const std::vector<double> &diag, const std::vector<double> &off,
+                             TridiagonalSolver::EstimateBuffers &buffers) const;
+
+private:
+    int threadCount = 0;
+    std::vector<int> begin, end; // Внутренние строки блока k: [begin[k], end[k]); end[k] - разделитель
+    std::vector<double> d;       // D внутренних частей блоков
+    std::vector<double> l;       // Множители L: l[i] связывает строки i - 1 и i одного блока
+    std::vector<double> leftSpike;  // A_k^-1 e_first * (связь с левым разделителем)
+    std::vector<double> rightSpike; // A_k^-1 e_last * (связь с правым разделителем)
+    std::vector<double> separatorLeft, separatorRight; // off слева и справа от разделителей
+    std::vector<double> reducedD, reducedL; // Разложение дополнения Шура на разделителях
+    double pivotRatio = 1.0;
+
+    // Потоки блоков создаются один раз и используются всеми разложениями и решениями
+    // (в том числе анализа чувствительности и оценки обусловленности)
+    mutable WorkerPool pool;
+    std::vector<double> ratios;            // Рабочие буферы factor()
+    std::vector<char> singular;
+    mutable std::vector<double> separators; // Рабочий буфер solve()
+
+    void solveBlock(int k, double *x) const;
+};
+
+#endif // PARALLELTRIDIAGONALSOLVER_H
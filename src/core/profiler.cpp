@@ -0,0 +1,116 @@
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <locale>
+#include <stdexcept>
+#include <thread>
+
+std::atomic<int64_t> Profiler::allocationCounter{0};
+
+Profiler &Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+int64_t Profiler::now() {
+    static const auto origin = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                 origin)
+        .count();
+}
+
+void Profiler::setEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // Память выделяется заранее, чтобы запись события не искажала счетчик выделений
+    if (enabled && ring.empty()) {
+        ring.resize(capacity);
+        summaries.reserve(64);
+    }
+    active.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    head = 0;
+    count = 0;
+    summaries.clear();
+}
+
+void Profiler::record(const char *name, int64_t start, int64_t end, int64_t allocations) {
+    uint32_t thread =
+        static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ring.empty()) {
+        return; // Профилировщик выключили во время замера до первого включения
+    }
+
+    ring[head] = {name, start, end - start, allocations, thread};
+    head = (head + 1) % capacity;
+    count = std::min(count + 1, capacity);
+
+    // Имен немного (десяток фаз), линейный поиск дешевле ассоциативного контейнера
+    double ms = (end - start) / 1000.0;
+    auto it = std::find_if(summaries.begin(), summaries.end(),
+                           [name](const Summary &s) { return s.name == name; });
+    if (it == summaries.end()) {
+        Summary summary;
+        summary.name = name;
+        summary.min = ms;
+        summaries.push_back(summary);
+        it = summaries.end() - 1;
+    }
+    it->count++;
+    it->total += ms;
+    it->min = std::min(it->min, ms);
+    it->max = std::max(it->max, ms);
+    it->last = ms;
+    it->allocations += allocations;
+}
+
+std::vector<Profiler::Event> Profiler::events() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Event> result;
+    result.reserve(count);
+    size_t first = (head + capacity - count) % capacity;
+    for (size_t i = 0; i < count; i++) {
+        result.push_back(ring[(first + i) % capacity]);
+    }
+    return result;
+}
+
+std::vector<Profiler::Summary> Profiler::summary() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return summaries;
+}
+
+void Profiler::writeChromeTrace(std::ostream &out) const {
+    std::vector<Event> snapshot = events();
+
+    std::locale locale = out.imbue(std::locale::classic());
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    for (size_t i = 0; i < snapshot.size(); i++) {
+        const Event &event = snapshot[i];
+        // Имена - строковые литералы из исходного кода, экранирование не требуется
+        out << (i > 0 ? ",\n" : "\n") << "{\"name\": \"" << event.name
+            << "\", \"cat\": \"sapr\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event.thread
+            << ", \"ts\": " << event.start << ", \"dur\": " << event.duration
+            << ", \"args\": {\"allocations\": " << event.allocations << "}}";
+    }
+    out << "\n]}\n";
+    out.imbue(locale);
+}
+
+void Profiler::saveChromeTrace(const std::filesystem::path &path) const {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Не удалось сохранить файл");
+    }
+    writeChromeTrace(file);
+    file.close();
+    if (file.fail()) {
+        throw std::runtime_error("Ошибка записи файла");
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Встроенный профилировщик: интервалы ProfileScope записываются в кольцевой буфер
+// последних событий и в сводку по именам (число вызовов, время, выделения памяти).
+// По умолчанию выключен; выключенный ProfileScope стоит одну проверку флага.
+// События можно сохранить в формате Chrome trace (chrome://tracing, Perfetto).
+class Profiler {
+public:
+    // Время в микросекундах от первого обращения к профилировщику
+    struct Event {
+        const char *name;
+        int64_t start;
+        int64_t duration;
+        int64_t allocations; // Выделений памяти за интервал (во всех потоках)
+        uint32_t thread;
+    };
+
+    struct Summary {
+        std::string name;
+        int64_t count = 0;
+        double total = 0.0; // мс
+        double min = 0.0;
+        double max = 0.0;
+        double last = 0.0;
+        int64_t allocations = 0;
+    };
+
+    static constexpr size_t capacity = 1 << 16; // Событий в кольцевом буфере
+
+    static Profiler &instance();
+    static bool enabled() { return instance().active.load(std::memory_order_relaxed); }
+    static int64_t now();
+
+    // Счетчик выделений памяти; увеличивается заменой operator new в приложении
+    static void countAllocation() noexcept {
+        allocationCounter.fetch_add(1, std::memory_order_relaxed);
+    }
+    static int64_t allocationCount() noexcept {
+        return allocationCounter.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool enabled);
+    void clear();
+
+    // name должен жить до конца работы программы (обычно строковый литерал)
+    void record(const char *name, int64_t start, int64_t end, int64_t allocations);
+
+    std::vector<Event> events() const; // В порядке записи, не более capacity последних
+    std::vector<Summary> summary() const;
+
+    void writeChromeTrace(std::ostream &out) const;
+    void saveChromeTrace(const std::filesystem::path &path) const;
+
+private:
+    Profiler() = default;
+
+    static std::atomic<int64_t> allocationCounter;
+
+    std::atomic<bool> active{false};
+    mutable std::mutex mutex;
+    std::vector<Event> ring;
+    size_t head = 0;  // Позиция следующей записи
+    size_t count = 0; // Заполнено событий
+    std::vector<Summary> summaries;
+};
+
+// Замер интервала от конструктора до деструктора или stop()
+class ProfileScope {
+public:
+    explicit ProfileScope(const char *name) : name(name), active(Profiler::enabled()) {
+        if (active) {
+            allocations = Profiler::allocationCount();
+            start = Profiler::now();
+        }
+    }
+    ~ProfileScope() { stop(); }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+    void stop() {
+        if (active) {
+            active = false;
+            Profiler::instance().record(name, start, Profiler::now(),
+                                        Profiler::allocationCount() - allocations);
+        }
+    }
+
+private:
+    const char *name;
+    bool active;
+    int64_t start = 0;
+    int64_t allocations = 0;
+};
+
+#endif // PROFILER_H
@@ -0,0 +1,411 @@
+#include "projectreader.h"
+#include "materiallibrary.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <locale>
+#include <map>
+#include <sstream>
+
+namespace {
+
+std::string trimmed(const std::string &s) {
+    const char *spaces = " \t\r\n";
+    size_t begin = s.find_first_not_of(spaces);
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    size_t end = s.find_last_not_of(spaces);
+    return s.substr(begin, end - begin + 1);
+}
+
+// Номер элемента из ключа вида "Bar12" / "Node3" (с 0); -1, если ключ не подходит
+int keyIndex(const std::string &key, const std::string &prefix) {
+    if (key.compare(0, prefix.size(), prefix) != 0 || key.size() == prefix.size()) {
+        return -1;
+    }
+    int index = 0;
+    for (size_t i = prefix.size(); i < key.size(); i++) {
+        if (key[i] < '0' || key[i] > '9' || index > 1000000) {
+            return -1;
+        }
+        index = index * 10 + (key[i] - '0');
+    }
+    return index - 1;
+}
+
+std::vector<std::string> splitFields(const std::string &value) {
+    std::vector<std::string> fields;
+    std::stringstream stream(value);
+    std::string field;
+    while (std::getline(stream, field, ',')) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+bool readU32(std::istream &in, uint32_t &value) {
+    unsigned char bytes[4];
+    if (!in.read(reinterpret_cast<char *>(bytes), sizeof(bytes))) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+    }
+    return true;
+}
+
+bool readColumn(std::istream &in, std::vector<double> &values, size_t count) {
+    values.resize(count);
+    unsigned char bytes[8];
+    for (size_t k = 0; k < count; k++) {
+        if (!in.read(reinterpret_cast<char *>(bytes), sizeof(bytes))) {
+            return false;
+        }
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; i++) {
+            bits |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+        }
+        std::memcpy(&values[k], &bits, sizeof(bits));
+    }
+    return true;
+}
+
+} // namespace
+
+double ProjectReader::toDouble(const std::string &text, double fallback) {
+    // Числа в файле всегда записаны с точкой, независимо от локали системы
+    std::istringstream stream(trimmed(text));
+    stream.imbue(std::locale::classic());
+    double value;
+    if (!(stream >> value) || !(stream >> std::ws).eof()) {
+        return fallback;
+    }
+    return value;
+}
+
+bool ProjectReader::read(std::istream &in, SaprProject &project, std::string *error) {
+    project = SaprProject();
+
+    std::map<std::string, std::map<std::string, std::string>> sections;
+    std::string section;
+    std::string line;
+    while (std::getline(in, line)) {
+        line = trimmed(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (line.front() == '[' && line.back() == ']') {
+            section = line.substr(1, line.size() - 2);
+            continue;
+        }
+        size_t equalsPos = line.find('=');
+        if (equalsPos != std::string::npos) {
+            // Как и в FileHandler, при повторе ключа остается последнее значение
+            sections[section][trimmed(line.substr(0, equalsPos))] =
+                trimmed(line.substr(equalsPos + 1));
+        }
+    }
+
+    const auto &anchors = sections["Anchors"];
+    auto flag = [&](const char *key) {
+        auto it = anchors.find(key);
+        return it != anchors.end() && it->second == "true";
+    };
+    project.leftAnchor = flag("Left");
+    project.rightAnchor = flag("Right");
+
+    const auto &bars = sections["Bars"];
+    auto count = bars.find("Count");
+    if (count == bars.end()) {
+        if (error) {
+            *error = "Нет секции [Bars] с количеством стержней";
+        }
+        return false;
+    }
+    // Число проверяется до приведения к int: файл может прийти от клиента сервера,
+    // а большее значение означало бы неограниченное выделение памяти
+    double countValue = toDouble(count->second, 0.0);
+    if (!(countValue >= 1.0)) {
+        if (error) {
+            *error = "Нет стержней для расчета";
+        }
+        return false;
+    }
+    if (countValue > maxBars) {
+        if (error) {
+            *error = "Слишком много стержней";
+        }
+        return false;
+    }
+    int barCount = static_cast<int>(countValue);
+
+    project.bars.assign(barCount, SaprProject::Bar());
+    project.nodeForces.assign(barCount + 1, 0.0);
+    project.barForces.assign(barCount, 0.0);
+
+    // [Materials]: имя=E,sigma_allow[,rho]; [Sections]: имя=A (порядок номеров - по именам)
+    for (const auto &[name, value] : sections["Materials"]) {
+        std::vector<std::string> fields = splitFields(value);
+        SaprProject::Material material;
+        material.name = name;
+        material.E = fields.size() >= 1 ? toDouble(fields[0], 0.0) : 0.0;
+        if (fields.size() >= 2) {
+            material.sigma_allow = toDouble(fields[1], 200e6);
+        }
+        if (fields.size() >= 3) {
+            material.rho = toDouble(fields[2], 7850.0);
+        }
+        project.materials.push_back(material);
+    }
+    for (const auto &[name, value] : sections["Sections"]) {
+        SaprProject::Section section;
+        section.name = name;
+        section.A = toDouble(value, 0.0);
+        project.sections.push_back(section);
+    }
+
+    for (const auto &[key, value] : bars) {
+        int index = keyIndex(key, "Bar");
+        if (index < 0 || index >= barCount) {
+            continue;
+        }
+
+        std::vector<std::string> fields = splitFields(value);
+        if (fields.size() < 3) {
+            continue;
+        }
+        if (!readBar(fields, project, project.bars[index])) {
+            if (error) {
+                *error = "Неизвестный материал";
+            }
+            return false;
+        }
+    }
+
+    for (const auto &[key, value] : sections["NodeForces"]) {
+        int index = keyIndex(key, "Node");
+        if (index >= 0 && index <= barCount) {
+            project.nodeForces[index] = toDouble(value, 0.0);
+        }
+    }
+
+    for (const auto &[key, value] : sections["BarForces"]) {
+        int index = keyIndex(key, "Bar");
+        if (index >= 0 && index < barCount) {
+            project.barForces[index] = toDouble(value, 0.0);
+        }
+    }
+
+    return readSubstructures(sections, project, error);
+}
+
+bool ProjectReader::readBar(const std::vector<std::string> &fields, const SaprProject &project,
+                            SaprProject::Bar &bar) {
+    bar.L = toDouble(fields[0], 0.0);
+    int section = MaterialLibrary::findSection(project, trimmed(fields[1]));
+    if (section >= 0) {
+        MaterialLibrary::assignSection(project, bar, section);
+    } else {
+        bar.A = toDouble(fields[1], 0.0);
+    }
+
+    // Три поля - длина, площадь или сечение, материал
+    if (fields.size() == 3) {
+        int material = MaterialLibrary::findMaterial(project, trimmed(fields[2]));
+        if (material < 0) {
+            return false;
+        }
+        MaterialLibrary::assignMaterial(project, bar, material);
+        return true;
+    }
+    bar.E = toDouble(fields[2], 0.0);
+    bar.sigma_allow = toDouble(fields[3], 200e6);
+    if (fields.size() >= 5) {
+        bar.rho = toDouble(fields[4], 7850.0);
+    }
+    return true;
+}
+
+bool ProjectReader::readSubstructures(
+    const std::map<std::string, std::map<std::string, std::string>> &sections,
+    SaprProject &project, std::string *error) {
+    auto fail = [&](const char *message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    // Подконструкции нумеруются подряд с единицы (так их пишет ProjectWriter): номер
+    // больше числа секций отвергается до выделения памяти под массив подконструкций
+    int substructureCount = 0;
+    for (const auto &section : sections) {
+        if (keyIndex(section.first, "Substructure") >= 0) {
+            substructureCount++;
+        }
+    }
+
+    // [Substructure1], [Substructure2], ...: стержни, распределенные нагрузки
+    // и силы во внутренних узлах в тех же ключах, что и у проекта
+    for (const auto &[name, values] : sections) {
+        int number = keyIndex(name, "Substructure");
+        if (number < 0) {
+            continue;
+        }
+        if (number >= substructureCount) {
+            return fail("Подконструкции должны нумероваться подряд с 1");
+        }
+        auto count = values.find("Count");
+        double countValue = count == values.end() ? 0.0 : toDouble(count->second, 0.0);
+        if (!(countValue >= 1.0) || countValue > maxBars) {
+            return fail("Некорректная подконструкция");
+        }
+        int barCount = static_cast<int>(countValue);
+        if (number >= static_cast<int>(project.substructures.size())) {
+            project.substructures.resize(number + 1);
+        }
+        SaprProject::Substructure &substructure = project.substructures[number];
+        substructure.bars.assign(barCount, SaprProject::Bar());
+        substructure.barForces.assign(barCount, 0.0);
+        substructure.interiorForces.assign(barCount - 1, 0.0);
+
+        for (const auto &[key, value] : values) {
+            int index = keyIndex(key, "Bar");
+            if (index >= 0 && index < barCount) {
+                std::vector<std::string> fields = splitFields(value);
+                if (fields.size() >= 3 && !readBar(fields, project, substructure.bars[index])) {
+                    return fail("Неизвестный материал");
+                }
+            }
+            index = keyIndex(key, "BarForce");
+            if (index >= 0 && index < barCount) {
+                substructure.barForces[index] = toDouble(value, 0.0);
+            }
+            index = keyIndex(key, "Node");
+            if (index >= 0 && index < barCount - 1) {
+                substructure.interiorForces[index] = toDouble(value, 0.0);
+            }
+        }
+    }
+
+    // [Instances]: InstanceK = подконструкция, первый стержень[, число повторов подряд]
+    auto instances = sections.find("Instances");
+    if (instances == sections.end()) {
+        return true;
+    }
+    int barCount = static_cast<int>(project.bars.size());
+    for (const auto &[key, value] : instances->second) {
+        if (keyIndex(key, "Instance") < 0) {
+            continue;
+        }
+        std::vector<std::string> fields = splitFields(value);
+        if (fields.size() < 2) {
+            return fail("Некорректный экземпляр подконструкции");
+        }
+        int number = static_cast<int>(toDouble(fields[0], 0.0)) - 1;
+        int firstBar = static_cast<int>(toDouble(fields[1], 0.0)) - 1;
+        int repeats = fields.size() >= 3 ? static_cast<int>(toDouble(fields[2], 0.0)) : 1;
+        if (number < 0 || number >= static_cast<int>(project.substructures.size()) ||
+            project.substructures[number].bars.empty() || firstBar < 0 || repeats <= 0) {
+            return fail("Некорректный экземпляр подконструкции");
+        }
+        int size = static_cast<int>(project.substructures[number].bars.size());
+        if (static_cast<long long>(size) * repeats > barCount - firstBar) {
+            return fail("Экземпляр подконструкции выходит за пределы цепочки");
+        }
+        for (int r = 0; r < repeats; r++) {
+            SaprProject::Instance instance;
+            instance.substructure = number;
+            instance.firstBar = firstBar + r * size;
+            project.instances.push_back(instance);
+        }
+    }
+
+    std::sort(project.instances.begin(), project.instances.end(),
+              [](const SaprProject::Instance &a, const SaprProject::Instance &b) {
+                  return a.firstBar < b.firstBar;
+              });
+    int end = 0; // Первый стержень после предыдущего экземпляра
+    for (const SaprProject::Instance &instance : project.instances) {
+        const SaprProject::Substructure &substructure =
+            project.substructures[instance.substructure];
+        if (instance.firstBar < end) {
+            return fail("Экземпляры подконструкций перекрываются");
+        }
+        int size = static_cast<int>(substructure.bars.size());
+        for (int j = 0; j < size; j++) {
+            project.bars[instance.firstBar + j] = substructure.bars[j];
+            project.barForces[instance.firstBar + j] = substructure.barForces[j];
+            if (j > 0) {
+                project.nodeForces[instance.firstBar + j] = substructure.interiorForces[j - 1];
+            }
+        }
+        end = instance.firstBar + size;
+    }
+    return true;
+}
+
+bool ProjectReader::readBinary(std::istream &in, SaprProject &project, std::string *error) {
+    project = SaprProject();
+    auto fail = [&](const char *message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    char magic[8];
+    uint32_t version, barCount, flags;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, "SAPRMDL", 8) != 0 ||
+        !readU32(in, version) || !readU32(in, barCount) || !readU32(in, flags)) {
+        return fail("Неизвестный формат модели");
+    }
+    if (version != 1) {
+        return fail("Неподдерживаемая версия модели");
+    }
+    if (barCount == 0) {
+        return fail("Нет стержней для расчета");
+    }
+    // Как и в текстовом формате, число стержней ограничено миллионом
+    if (barCount > static_cast<uint32_t>(maxBars)) {
+        return fail("Слишком много стержней");
+    }
+
+    project.leftAnchor = (flags & 1u) != 0;
+    project.rightAnchor = (flags & 2u) != 0;
+    project.bars.assign(barCount, SaprProject::Bar());
+
+    std::vector<double> column;
+    for (double SaprProject::Bar::*field : {&SaprProject::Bar::L, &SaprProject::Bar::A,
+                                            &SaprProject::Bar::E, &SaprProject::Bar::sigma_allow,
+                                            &SaprProject::Bar::rho}) {
+        if (!readColumn(in, column, barCount)) {
+            return fail("Модель обрезана");
+        }
+        for (uint32_t i = 0; i < barCount; i++) {
+            project.bars[i].*field = column[i];
+        }
+    }
+    if (!readColumn(in, project.barForces, barCount) ||
+        !readColumn(in, project.nodeForces, barCount + 1)) {
+        return fail("Модель обрезана");
+    }
+    return true;
+}
+
+bool ProjectReader::load(const std::filesystem::path &fileName, SaprProject &project,
+                         std::string *error) {
+    ProfileScope profile("ProjectReader::load");
+    std::ifstream in(fileName);
+    if (!in) {
+        if (error) {
+            *error = "Не удалось открыть файл";
+        }
+        return false;
+    }
+    return read(in, project, error);
+}
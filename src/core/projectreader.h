@@ -0,0 +1,50 @@
+#ifndef PROJECTREADER_H
+#define PROJECTREADER_H
+
+#include "saprproject.h"
+#include <filesystem>
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Чтение файла проекта без интерфейса (пакетный режим). Формат совпадает с FileHandler:
+// секции [Anchors], [Bars], [NodeForces], [BarForces]; пустые и нечисловые поля
+// заменяются теми же значениями по умолчанию, что и в окне программы.
+//
+// Повторяющиеся участки цепочки описываются подконструкциями:
+//   [SubstructureK]  Count, BarN (как в [Bars]), BarForceN, NodeN (внутренние узлы, с 1);
+//                    K - подряд с 1;
+//   [Instances]      InstanceK=<номер подконструкции>,<первый стержень>[,<повторов подряд>].
+// Стержни экземпляров в [Bars] не перечисляются; Count в [Bars] - полное число стержней.
+// При чтении экземпляры разворачиваются в bars, barForces и nodeForces проекта.
+//
+// Общие материалы и сечения ([Materials]: имя=E,sigma_allow[,rho]; [Sections]: имя=A)
+// заменяют числа в строках стержней: вместо площади указывается имя сечения, а вместо
+// E, sigma_allow и rho - имя материала (строка из трех полей: Bar1=2,Труба,Сталь).
+//
+// Двоичная модель (ProjectWriter::writeBinary, все числа little-endian):
+//   "SAPRMDL\0", uint32 версия (1), uint32 число стержней, uint32 флаги (бит 0 - левая
+//   заделка, бит 1 - правая), затем столбцы float64: L, A, E, sigma_allow, rho,
+//   распределенные нагрузки (по числу стержней), сосредоточенные силы (число стержней + 1).
+class ProjectReader {
+public:
+    static bool read(std::istream &in, SaprProject &project, std::string *error = nullptr);
+    static bool readBinary(std::istream &in, SaprProject &project, std::string *error = nullptr);
+    static bool load(const std::filesystem::path &fileName, SaprProject &project,
+                     std::string *error = nullptr);
+
+private:
+    // Наибольшее число стержней в проекте и подконструкции (текстовый и двоичный формат)
+    static constexpr int maxBars = 1000000;
+
+    static double toDouble(const std::string &text, double fallback);
+    // false, если материал из трех полей не найден в библиотеке
+    static bool readBar(const std::vector<std::string> &fields, const SaprProject &project,
+                        SaprProject::Bar &bar);
+    static bool
+    readSubstructures(const std::map<std::string, std::map<std::string, std::string>> &sections,
+                      SaprProject &project, std::string *error);
+};
+
+#endif // PROJECTREADER_H
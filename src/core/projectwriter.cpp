@@ -0,0 +1,291 @@
+#include "projectwriter.h"
+#include "materiallibrary.h"
+#include "superelement.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <locale>
+#include <set>
+#include <sstream>
+
+namespace {
+
+void writeU32(std::ostream &out, uint32_t value) {
+    char bytes[4];
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    out.write(bytes, sizeof(bytes));
+}
+
+void writeColumn(std::ostream &out, const double *values, size_t count) {
+    char bytes[8];
+    for (size_t k = 0; k < count; k++) {
+        uint64_t bits;
+        std::memcpy(&bits, &values[k], sizeof(bits));
+        for (int i = 0; i < 8; i++) {
+            bytes[i] = static_cast<char>(bits >> (8 * i));
+        }
+        out.write(bytes, sizeof(bytes));
+    }
+}
+
+} // namespace
+
+std::string ProjectWriter::number(double value) {
+    // Кратчайшая из двух записей, которая читается обратно без изменения
+    for (int precision : {15, 17}) {
+        std::ostringstream stream;
+        stream.imbue(std::locale::classic());
+        stream.precision(precision);
+        stream << value;
+
+        std::istringstream check(stream.str());
+        check.imbue(std::locale::classic());
+        double parsed;
+        if (precision == 17 || ((check >> parsed) && parsed == value)) {
+            return stream.str();
+        }
+    }
+    return std::string();
+}
+
+void ProjectWriter::write(std::ostream &out, const SaprProject &project) {
+    int barCount = static_cast<int>(project.bars.size());
+
+    // Экземпляры, стержни которых не изменены после чтения, пишутся одной строкой;
+    // измененные записываются как обычные стержни
+    std::vector<SaprProject::Instance> instances;
+    std::vector<char> covered(barCount, 0);
+    std::vector<char> interior(barCount + 1, 0);
+    for (const SaprProject::Instance &instance : project.instances) {
+        if (!Superelement::matches(project, instance) ||
+            std::any_of(covered.begin() + instance.firstBar,
+                        covered.begin() + instance.firstBar +
+                            project.substructures[instance.substructure].bars.size(),
+                        [](char c) { return c != 0; })) {
+            continue;
+        }
+        int size = static_cast<int>(project.substructures[instance.substructure].bars.size());
+        for (int j = 0; j < size; j++) {
+            covered[instance.firstBar + j] = 1;
+            if (j > 0) {
+                interior[instance.firstBar + j] = 1;
+            }
+        }
+        instances.push_back(instance);
+    }
+
+    out << "# SAPR Project File\n\n";
+
+    out << "[Anchors]\n";
+    out << "Left=" << (project.leftAnchor ? "true" : "false") << "\n";
+    out << "Right=" << (project.rightAnchor ? "true" : "false") << "\n\n";
+
+    // Библиотека пишется, только если на нее ссылается хотя бы один стержень
+    Names names;
+    bool library = false;
+    auto uses = [&](const std::vector<SaprProject::Bar> &bars) {
+        for (const SaprProject::Bar &bar : bars) {
+            library = library || MaterialLibrary::usesMaterial(project, bar) ||
+                      MaterialLibrary::usesSection(project, bar);
+        }
+    };
+    uses(project.bars);
+    for (const SaprProject::Substructure &substructure : project.substructures) {
+        uses(substructure.bars);
+    }
+    if (library) {
+        names = libraryNames(project);
+        if (!project.materials.empty()) {
+            out << "[Materials]\n";
+            for (size_t i = 0; i < project.materials.size(); i++) {
+                const SaprProject::Material &material = project.materials[i];
+                out << names.materials[i] << "=" << number(material.E) << ","
+                    << number(material.sigma_allow) << "," << number(material.rho) << "\n";
+            }
+            out << "\n";
+        }
+        if (!project.sections.empty()) {
+            out << "[Sections]\n";
+            for (size_t i = 0; i < project.sections.size(); i++) {
+                out << names.sections[i] << "=" << number(project.sections[i].A) << "\n";
+            }
+            out << "\n";
+        }
+    }
+
+    out << "[Bars]\n";
+    out << "Count=" << barCount << "\n";
+    for (int i = 0; i < barCount; i++) {
+        if (!covered[i]) {
+            writeBar(out, "Bar" + std::to_string(i + 1), project.bars[i], project, names);
+        }
+    }
+    out << "\n";
+
+    out << "[NodeForces]\n";
+    out << "Count=" << project.nodeForces.size() << "\n";
+    for (size_t i = 0; i < project.nodeForces.size(); i++) {
+        if (i >= interior.size() || !interior[i]) {
+            out << "Node" << i + 1 << "=" << number(project.nodeForces[i]) << "\n";
+        }
+    }
+    out << "\n";
+
+    out << "[BarForces]\n";
+    out << "Count=" << project.barForces.size() << "\n";
+    for (size_t i = 0; i < project.barForces.size(); i++) {
+        if (i >= covered.size() || !covered[i]) {
+            out << "Bar" << i + 1 << "=" << number(project.barForces[i]) << "\n";
+        }
+    }
+
+    if (instances.empty()) {
+        return;
+    }
+    for (size_t k = 0; k < project.substructures.size(); k++) {
+        const SaprProject::Substructure &substructure = project.substructures[k];
+        if (substructure.bars.empty()) {
+            continue;
+        }
+        out << "\n[Substructure" << k + 1 << "]\n";
+        out << "Count=" << substructure.bars.size() << "\n";
+        for (size_t j = 0; j < substructure.bars.size(); j++) {
+            writeBar(out, "Bar" + std::to_string(j + 1), substructure.bars[j], project, names);
+        }
+        for (size_t j = 0; j < substructure.barForces.size(); j++) {
+            out << "BarForce" << j + 1 << "=" << number(substructure.barForces[j]) << "\n";
+        }
+        for (size_t j = 0; j < substructure.interiorForces.size(); j++) {
+            out << "Node" << j + 1 << "=" << number(substructure.interiorForces[j]) << "\n";
+        }
+    }
+
+    // Идущие подряд экземпляры одной подконструкции записываются с числом повторов
+    out << "\n[Instances]\n";
+    int line = 0;
+    for (size_t k = 0; k < instances.size();) {
+        int size = static_cast<int>(project.substructures[instances[k].substructure].bars.size());
+        size_t repeats = 1;
+        while (k + repeats < instances.size() &&
+               instances[k + repeats].substructure == instances[k].substructure &&
+               instances[k + repeats].firstBar ==
+                   instances[k].firstBar + static_cast<int>(repeats) * size) {
+            repeats++;
+        }
+        out << "Instance" << ++line << "=" << instances[k].substructure + 1 << ","
+            << instances[k].firstBar + 1;
+        if (repeats > 1) {
+            out << "," << repeats;
+        }
+        out << "\n";
+        k += repeats;
+    }
+}
+
+void ProjectWriter::writeBar(std::ostream &out, const std::string &key,
+                             const SaprProject::Bar &bar, const SaprProject &project,
+                             const Names &names) {
+    out << key << "=" << number(bar.L) << ",";
+    if (!names.sections.empty() && MaterialLibrary::usesSection(project, bar)) {
+        out << names.sections[bar.section];
+    } else {
+        out << number(bar.A);
+    }
+    if (!names.materials.empty() && MaterialLibrary::usesMaterial(project, bar)) {
+        out << "," << names.materials[bar.material] << "\n";
+    } else {
+        out << "," << number(bar.E) << "," << number(bar.sigma_allow) << "," << number(bar.rho)
+            << "\n";
+    }
+}
+
+ProjectWriter::Names ProjectWriter::libraryNames(const SaprProject &project) {
+    // Имя должно читаться обратно как ключ и не совпадать с числом (вместо площади
+    // может стоять и число, и имя сечения); иначе, как и при повторе, дается номер
+    std::set<std::string> used;
+    auto name = [&](const std::string &text, const char *prefix, size_t index) {
+        bool valid = !text.empty() && text.find_first_of(",=#[]\r\n") == std::string::npos &&
+                     text.front() != ' ' && text.back() != ' ' && text.front() != '\t' &&
+                     text.back() != '\t' && text != "Count" && std::isnan(parse(text)) &&
+                     used.count(text) == 0;
+        std::string result = text;
+        for (size_t suffix = index + 1; !valid; suffix++) {
+            result = prefix + std::to_string(suffix);
+            valid = used.count(result) == 0;
+        }
+        used.insert(result);
+        return result;
+    };
+
+    Names names;
+    for (size_t i = 0; i < project.materials.size(); i++) {
+        names.materials.push_back(name(project.materials[i].name, "Material", i));
+    }
+    used.clear();
+    for (size_t i = 0; i < project.sections.size(); i++) {
+        names.sections.push_back(name(project.sections[i].name, "Section", i));
+    }
+    return names;
+}
+
+double ProjectWriter::parse(const std::string &text) {
+    std::istringstream stream(text);
+    stream.imbue(std::locale::classic());
+    double value;
+    if (!(stream >> value) || !(stream >> std::ws).eof()) {
+        return std::nan("");
+    }
+    return value;
+}
+
+void ProjectWriter::writeBinary(std::ostream &out, const SaprProject &project) {
+    size_t barCount = project.bars.size();
+    out.write("SAPRMDL", 8);
+    writeU32(out, 1);
+    writeU32(out, static_cast<uint32_t>(barCount));
+    writeU32(out, (project.leftAnchor ? 1u : 0u) | (project.rightAnchor ? 2u : 0u));
+
+    std::vector<double> column(barCount);
+    for (double SaprProject::Bar::*field : {&SaprProject::Bar::L, &SaprProject::Bar::A,
+                                            &SaprProject::Bar::E, &SaprProject::Bar::sigma_allow,
+                                            &SaprProject::Bar::rho}) {
+        for (size_t i = 0; i < barCount; i++) {
+            column[i] = project.bars[i].*field;
+        }
+        writeColumn(out, column.data(), barCount);
+    }
+
+    // Недостающие нагрузки записываются нулями, как их читает ProjectReader
+    column.assign(barCount, 0.0);
+    std::copy_n(project.barForces.begin(), std::min(barCount, project.barForces.size()),
+                column.begin());
+    writeColumn(out, column.data(), barCount);
+    column.assign(barCount + 1, 0.0);
+    std::copy_n(project.nodeForces.begin(), std::min(barCount + 1, project.nodeForces.size()),
+                column.begin());
+    writeColumn(out, column.data(), barCount + 1);
+}
+
+bool ProjectWriter::save(const std::filesystem::path &fileName, const SaprProject &project,
+                         std::string *error) {
+    std::ofstream out(fileName);
+    if (!out) {
+        if (error) {
+            *error = "Не удалось сохранить файл";
+        }
+        return false;
+    }
+    write(out, project);
+    out.close();
+    if (out.fail()) {
+        if (error) {
+            *error = "Ошибка записи файла";
+        }
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,38 @@
+#ifndef PROJECTWRITER_H
+#define PROJECTWRITER_H
+
+#include "saprproject.h"
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Запись проекта .sapr без интерфейса в формате FileHandler (секции [Anchors], [Bars],
+// [NodeForces], [BarForces]); настройки отображения не записываются, и окно
+// программы при открытии оставляет для них текущие значения.
+// Числа пишутся с точкой и без потери точности: ProjectReader читает их обратно побитово.
+// Экземпляры подконструкций записываются в секции [Instances], общие материалы
+// и сечения - в [Materials] и [Sections] (см. projectreader.h).
+class ProjectWriter {
+public:
+    static void write(std::ostream &out, const SaprProject &project);
+    // Двоичная модель без разбора текста (формат описан в projectreader.h)
+    static void writeBinary(std::ostream &out, const SaprProject &project);
+    static bool save(const std::filesystem::path &fileName, const SaprProject &project,
+                     std::string *error = nullptr);
+
+private:
+    static std::string number(double value);
+    // Имена материалов и сечений в файле (пустые, если библиотека не пишется)
+    struct Names {
+        std::vector<std::string> materials;
+        std::vector<std::string> sections;
+    };
+
+    static void writeBar(std::ostream &out, const std::string &key, const SaprProject::Bar &bar,
+                         const SaprProject &project, const Names &names);
+    static Names libraryNames(const SaprProject &project);
+    static double parse(const std::string &text); // NaN, если текст не число
+};
+
+#endif // PROJECTWRITER_H
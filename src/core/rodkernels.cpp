@@ -0,0 +1,122 @@
+#include "rodkernels.h"
+#include "rodkernels_simd.h"
+#include <atomic>
+
+#if defined(SAPR_X86_KERNELS) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+// Скалярная эталонная реализация: тот же порядок операций, что и в векторных ядрах
+struct ScalarOps {
+    static constexpr int width = 1;
+    static double load(const double *p) { return *p; }
+    static void store(double *p, double v) { *p = v; }
+    static double set1(double v) { return v; }
+    static double add(double a, double b) { return a + b; }
+    static double sub(double a, double b) { return a - b; }
+    static double mul(double a, double b) { return a * b; }
+    static double div(double a, double b) { return a / b; }
+};
+
+constexpr RodKernels::Table scalarTable = RodKernelsSimd::makeTable<ScalarOps>();
+
+RodKernels::Level detectLevel() {
+#if defined(SAPR_X86_KERNELS) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    bool ymm = (xcr0 & 0x6) == 0x6;
+    bool zmm = (xcr0 & 0xE6) == 0xE6;
+    bool avx2 = false;
+    bool avx512 = false;
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+        avx512 = (info[1] & (1 << 16)) != 0;
+    }
+    if (avx && avx2 && avx512 && zmm) {
+        return RodKernels::Level::AVX512;
+    }
+    if (avx && avx2 && ymm) {
+        return RodKernels::Level::AVX2;
+    }
+    return RodKernels::Level::SSE2;
+#elif defined(SAPR_X86_KERNELS)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return RodKernels::Level::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return RodKernels::Level::AVX2;
+    }
+    return RodKernels::Level::SSE2; // Входит в базовый набор x86-64
+#else
+    return RodKernels::Level::Scalar;
+#endif
+}
+
+const RodKernels::Table &tableFor(RodKernels::Level level) {
+#ifdef SAPR_X86_KERNELS
+    switch (level) {
+    case RodKernels::Level::AVX512:
+        return rodKernelsAvx512;
+    case RodKernels::Level::AVX2:
+        return rodKernelsAvx2;
+    case RodKernels::Level::SSE2:
+        return rodKernelsSse2;
+    default:
+        break;
+    }
+#else
+    (void)level;
+#endif
+    return scalarTable;
+}
+
+// Выбранный уровень; -1 - еще не определен
+std::atomic<int> selectedLevel{-1};
+
+} // namespace
+
+RodKernels::Level RodKernels::detectedLevel() {
+    static const Level level = detectLevel();
+    return level;
+}
+
+RodKernels::Level RodKernels::activeLevel() {
+    int level = selectedLevel.load(std::memory_order_acquire);
+    if (level < 0) {
+        return detectedLevel();
+    }
+    return static_cast<Level>(level);
+}
+
+void RodKernels::setLevel(Level level) {
+    if (static_cast<int>(level) > static_cast<int>(detectedLevel())) {
+        level = detectedLevel();
+    }
+    selectedLevel.store(static_cast<int>(level), std::memory_order_release);
+}
+
+const char *RodKernels::levelName(Level level) {
+    switch (level) {
+    case Level::SSE2:
+        return "SSE2";
+    case Level::AVX2:
+        return "AVX2";
+    case Level::AVX512:
+        return "AVX-512";
+    default:
+        return "scalar";
+    }
+}
+
+const RodKernels::Table &RodKernels::table() {
+    return tableFor(activeLevel());
+}
@@ -0,0 +1,62 @@
+#ifndef RODKERNELS_H
+#define RODKERNELS_H
+
+// Ядра поэлементной сборки и постобработки для стержневой системы.
+// Данные стержней передаются непрерывными массивами (по одному на свойство).
+// Реализация выбирается один раз по возможностям процессора (SSE2 / AVX2 / AVX-512);
+// скалярный вариант служит эталоном. Все варианты выполняют одни и те же операции
+// в том же порядке и без FMA, поэтому результаты совпадают побитово.
+class RodKernels {
+public:
+    enum class Level { Scalar, SSE2, AVX2, AVX512 };
+
+    // Таблица реализаций одного уровня
+    struct Table {
+        void (*elementStiffness)(const double *E, const double *A, const double *L, double *k,
+                                 int count);
+        void (*elementLoads)(const double *q, const double *L, double *Q, int count);
+        void (*assemble)(const double *k, const double *Q, const double *F, double *diag,
+                         double *off, double *b, int nodes);
+        void (*elementForces)(const double *k, const double *Q, const double *u, double *N,
+                              int count);
+        void (*elementStresses)(const double *N, const double *A, double *sigma, int count);
+        void (*nodalStresses)(const double *sigma, double *stresses, int nodes);
+    };
+
+    static Level detectedLevel(); // Наилучший уровень, поддерживаемый процессором
+    static Level activeLevel();
+    static void setLevel(Level level); // Принудительный выбор (не выше доступного)
+    static const char *levelName(Level level);
+
+    // k[p] = E[p] * A[p] / L[p]
+    static void elementStiffness(const double *E, const double *A, const double *L, double *k,
+                                 int count) {
+        table().elementStiffness(E, A, L, k, count);
+    }
+    // Q[p] = q[p] * L[p] / 2 (эквивалентные узловые силы от распределенной нагрузки)
+    static void elementLoads(const double *q, const double *L, double *Q, int count) {
+        table().elementLoads(q, L, Q, count);
+    }
+    // diag[i] = k[i-1] + k[i], off[i] = -k[i], b[i] = F[i] + Q[i-1] + Q[i]
+    static void assemble(const double *k, const double *Q, const double *F, double *diag,
+                         double *off, double *b, int nodes) {
+        table().assemble(k, Q, F, diag, off, b, nodes);
+    }
+    // N[p] = k[p] * (u[p+1] - u[p]) - Q[p]
+    static void elementForces(const double *k, const double *Q, const double *u, double *N,
+                              int count) {
+        table().elementForces(k, Q, u, N, count);
+    }
+    // sigma[p] = N[p] / A[p]
+    static void elementStresses(const double *N, const double *A, double *sigma, int count) {
+        table().elementStresses(N, A, sigma, count);
+    }
+    // Напряжения в узлах: на концах - из крайних стержней, внутри - среднее соседних
+    static void nodalStresses(const double *sigma, double *stresses, int nodes) {
+        table().nodalStresses(sigma, stresses, nodes);
+    }
+
+    static const Table &table();
+};
+
+#endif // RODKERNELS_H
@@ -0,0 +1,21 @@
+// Компилируется с поддержкой AVX2 (см. CMakeLists.txt); вызывается только после
+// проверки процессора в RodKernels::detectedLevel()
+#include "rodkernels_simd.h"
+#include <immintrin.h>
+
+namespace {
+
+struct Avx2Ops {
+    static constexpr int width = 4;
+    static __m256d load(const double *p) { return _mm256_loadu_pd(p); }
+    static void store(double *p, __m256d v) { _mm256_storeu_pd(p, v); }
+    static __m256d set1(double v) { return _mm256_set1_pd(v); }
+    static __m256d add(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
+    static __m256d sub(__m256d a, __m256d b) { return _mm256_sub_pd(a, b); }
+    static __m256d mul(__m256d a, __m256d b) { return _mm256_mul_pd(a, b); }
+    static __m256d div(__m256d a, __m256d b) { return _mm256_div_pd(a, b); }
+};
+
+} // namespace
+
+const RodKernels::Table rodKernelsAvx2 = RodKernelsSimd::makeTable<Avx2Ops>();
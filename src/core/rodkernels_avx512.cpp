@@ -0,0 +1,21 @@
+// Компилируется с поддержкой AVX-512F (см. CMakeLists.txt); вызывается только после
+// проверки процессора в RodKernels::detectedLevel()
+#include "rodkernels_simd.h"
+#include <immintrin.h>
+
+namespace {
+
+struct Avx512Ops {
+    static constexpr int width = 8;
+    static __m512d load(const double *p) { return _mm512_loadu_pd(p); }
+    static void store(double *p, __m512d v) { _mm512_storeu_pd(p, v); }
+    static __m512d set1(double v) { return _mm512_set1_pd(v); }
+    static __m512d add(__m512d a, __m512d b) { return _mm512_add_pd(a, b); }
+    static __m512d sub(__m512d a, __m512d b) { return _mm512_sub_pd(a, b); }
+    static __m512d mul(__m512d a, __m512d b) { return _mm512_mul_pd(a, b); }
+    static __m512d div(__m512d a, __m512d b) { return _mm512_div_pd(a, b); }
+};
+
+} // namespace
+
+const RodKernels::Table rodKernelsAvx512 = RodKernelsSimd::makeTable<Avx512Ops>();
@@ -0,0 +1,117 @@
+#ifndef RODKERNELS_SIMD_H
+#define RODKERNELS_SIMD_H
+
+// Обобщенные векторные ядра. Подключается только из rodkernels_*.cpp, каждый из которых
+// компилируется со своим набором инструкций и задает тип V с операциями над регистром:
+// width, load, store, set1, add, sub, mul, div. Стандартная библиотека здесь не используется,
+// чтобы в единицы трансляции с расширенным набором инструкций не попадали общие inline-функции.
+
+#include "rodkernels.h"
+
+namespace RodKernelsSimd {
+
+template <class V>
+void elementStiffness(const double *E, const double *A, const double *L, double *k, int count) {
+    int i = 0;
+    for (; i + V::width <= count; i += V::width) {
+        V::store(k + i, V::div(V::mul(V::load(E + i), V::load(A + i)), V::load(L + i)));
+    }
+    for (; i < count; i++) {
+        k[i] = E[i] * A[i] / L[i];
+    }
+}
+
+template <class V> void elementLoads(const double *q, const double *L, double *Q, int count) {
+    const auto two = V::set1(2.0);
+    int i = 0;
+    for (; i + V::width <= count; i += V::width) {
+        V::store(Q + i, V::div(V::mul(V::load(q + i), V::load(L + i)), two));
+    }
+    for (; i < count; i++) {
+        Q[i] = q[i] * L[i] / 2.0;
+    }
+}
+
+template <class V>
+void assemble(const double *k, const double *Q, const double *F, double *diag, double *off,
+              double *b, int nodes) {
+    int count = nodes - 1;
+    const auto zero = V::set1(0.0);
+
+    // Крайние узлы получают вклад только от одного стержня
+    diag[0] = 0.0 + k[0];
+    b[0] = F[0] + Q[0];
+    diag[count] = 0.0 + k[count - 1];
+    b[count] = F[count] + Q[count - 1];
+
+    int i = 0;
+    for (; i + V::width <= count; i += V::width) {
+        V::store(off + i, V::sub(zero, V::load(k + i)));
+    }
+    for (; i < count; i++) {
+        off[i] = 0.0 - k[i];
+    }
+
+    // Внутренние узлы 1..count-1
+    i = 1;
+    for (; i + V::width <= count; i += V::width) {
+        V::store(diag + i, V::add(V::add(zero, V::load(k + i - 1)), V::load(k + i)));
+        V::store(b + i, V::add(V::add(V::load(F + i), V::load(Q + i - 1)), V::load(Q + i)));
+    }
+    for (; i < count; i++) {
+        diag[i] = (0.0 + k[i - 1]) + k[i];
+        b[i] = (F[i] + Q[i - 1]) + Q[i];
+    }
+}
+
+template <class V>
+void elementForces(const double *k, const double *Q, const double *u, double *N, int count) {
+    int i = 0;
+    for (; i + V::width <= count; i += V::width) {
+        auto delta = V::sub(V::load(u + i + 1), V::load(u + i));
+        V::store(N + i, V::sub(V::mul(V::load(k + i), delta), V::load(Q + i)));
+    }
+    for (; i < count; i++) {
+        N[i] = k[i] * (u[i + 1] - u[i]) - Q[i];
+    }
+}
+
+template <class V> void elementStresses(const double *N, const double *A, double *sigma, int count) {
+    int i = 0;
+    for (; i + V::width <= count; i += V::width) {
+        V::store(sigma + i, V::div(V::load(N + i), V::load(A + i)));
+    }
+    for (; i < count; i++) {
+        sigma[i] = N[i] / A[i];
+    }
+}
+
+template <class V> void nodalStresses(const double *sigma, double *stresses, int nodes) {
+    int count = nodes - 1;
+    const auto two = V::set1(2.0);
+
+    stresses[0] = sigma[0];
+    stresses[count] = sigma[count - 1];
+
+    int i = 1;
+    for (; i + V::width <= count; i += V::width) {
+        V::store(stresses + i, V::div(V::add(V::load(sigma + i - 1), V::load(sigma + i)), two));
+    }
+    for (; i < count; i++) {
+        stresses[i] = (sigma[i - 1] + sigma[i]) / 2.0;
+    }
+}
+
+template <class V> constexpr RodKernels::Table makeTable() {
+    return {elementStiffness<V>, elementLoads<V>,    assemble<V>,
+            elementForces<V>,    elementStresses<V>, nodalStresses<V>};
+}
+
+} // namespace RodKernelsSimd
+
+// Таблицы, определенные в rodkernels_sse2.cpp, rodkernels_avx2.cpp и rodkernels_avx512.cpp
+extern const RodKernels::Table rodKernelsSse2;
+extern const RodKernels::Table rodKernelsAvx2;
+extern const RodKernels::Table rodKernelsAvx512;
+
+#endif // RODKERNELS_SIMD_H
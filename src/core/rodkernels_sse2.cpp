@@ -0,0 +1,20 @@
+// Компилируется только для x86-64, где SSE2 входит в базовый набор инструкций
+#include "rodkernels_simd.h"
+#include <emmintrin.h>
+
+namespace {
+
+struct Sse2Ops {
+    static constexpr int width = 2;
+    static __m128d load(const double *p) { return _mm_loadu_pd(p); }
+    static void store(double *p, __m128d v) { _mm_storeu_pd(p, v); }
+    static __m128d set1(double v) { return _mm_set1_pd(v); }
+    static __m128d add(__m128d a, __m128d b) { return _mm_add_pd(a, b); }
+    static __m128d sub(__m128d a, __m128d b) { return _mm_sub_pd(a, b); }
+    static __m128d mul(__m128d a, __m128d b) { return _mm_mul_pd(a, b); }
+    static __m128d div(__m128d a, __m128d b) { return _mm_div_pd(a, b); }
+};
+
+} // namespace
+
+const RodKernels::Table rodKernelsSse2 = RodKernelsSimd::makeTable<Sse2Ops>();
@@ -0,0 +1,205 @@
+#include "rodsystembatch.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
+
+int RodSystemBatch::add(const SaprProject &project) {
+    models.push_back(project);
+    return size() - 1;
+}
+
+std::string RodSystemBatch::validate(const SaprProject &project) {
+    if (project.bars.empty()) {
+        return "Нет стержней для расчета";
+    }
+    if (!project.leftAnchor && !project.rightAnchor) {
+        return "Система должна иметь хотя бы одну заделку";
+    }
+    if (project.nodeForces.size() != project.bars.size() + 1 ||
+        project.barForces.size() != project.bars.size()) {
+        return "Количество нагрузок не соответствует количеству стержней";
+    }
+    for (const SaprProject::Bar &bar : project.bars) {
+        if (bar.L <= 0 || bar.A <= 0 || bar.E <= 0) {
+            return "Длина, площадь и модуль упругости должны быть положительными";
+        }
+    }
+    return std::string();
+}
+
+std::vector<RodSystemBatch::Result> RodSystemBatch::solve() const {
+    ProfileScope profile("RodSystemBatch::solve");
+    std::vector<Result> results(models.size());
+
+    // Группировка моделей близкого размера уменьшает долю холостых строк
+    std::vector<int> order;
+    for (int m = 0; m < size(); m++) {
+        results[m].error = validate(models[m]);
+        if (results[m].error.empty()) {
+            order.push_back(m);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return models[a].bars.size() < models[b].bars.size();
+    });
+
+    std::vector<double> diag, off, b, d, l;
+    for (size_t start = 0; start < order.size(); start += lanes) {
+        int group = static_cast<int>(std::min<size_t>(lanes, order.size() - start));
+        int rows = static_cast<int>(models[order[start + group - 1]].bars.size()) + 1;
+
+        // Холостые строки и дорожки: единичная матрица и нулевая правая часть
+        diag.assign(rows * lanes, 1.0);
+        off.assign(rows * lanes, 0.0);
+        b.assign(rows * lanes, 0.0);
+        d.assign(rows * lanes, 0.0);
+        l.assign(rows * lanes, 0.0);
+
+        // Сборка каждой модели в свою дорожку (формулы как в RodKernels)
+        for (int j = 0; j < group; j++) {
+            const SaprProject &model = models[order[start + j]];
+            int count = static_cast<int>(model.bars.size());
+            int n = count + 1;
+
+            for (int i = 0; i < n; i++) {
+                diag[i * lanes + j] = 0.0;
+                b[i * lanes + j] = model.nodeForces[i];
+            }
+            for (int p = 0; p < count; p++) {
+                const SaprProject::Bar &bar = model.bars[p];
+                double k = bar.E * bar.A / bar.L;
+                double Q = model.barForces[p] * bar.L / 2.0;
+                diag[p * lanes + j] += k;
+                diag[(p + 1) * lanes + j] += k;
+                off[p * lanes + j] = 0.0 - k;
+                b[p * lanes + j] += Q;
+                b[(p + 1) * lanes + j] += Q;
+            }
+
+            if (model.leftAnchor) {
+                diag[j] = 1.0;
+                off[j] = 0.0;
+                b[j] = 0.0;
+            }
+            if (model.rightAnchor) {
+                diag[(n - 1) * lanes + j] = 1.0;
+                off[(n - 2) * lanes + j] = 0.0;
+                b[(n - 1) * lanes + j] = 0.0;
+            }
+        }
+
+        // Разложение L D L^T всех дорожек одновременно. Вырожденность определяется
+        // относительным порогом для каждой строки, как в TridiagonalSolver::factor.
+        bool singular[lanes];
+        for (int j = 0; j < lanes; j++) {
+            d[j] = diag[j];
+            singular[j] = !(std::abs(d[j]) > std::abs(diag[j]) * 1e-14);
+        }
+        for (int i = 1; i < rows; i++) {
+            const double *dPrev = &d[(i - 1) * lanes];
+            const double *offPrev = &off[(i - 1) * lanes];
+            double *lPrev = &l[(i - 1) * lanes];
+            const double *diagRow = &diag[i * lanes];
+            double *dRow = &d[i * lanes];
+            for (int j = 0; j < lanes; j++) {
+                lPrev[j] = offPrev[j] / dPrev[j];
+                double eliminated = lPrev[j] * offPrev[j];
+                double pivot = diagRow[j] - eliminated;
+                double tiny = (std::abs(diagRow[j]) + std::abs(eliminated)) * 1e-14;
+                singular[j] |= !(std::abs(pivot) > tiny);
+                dRow[j] = pivot;
+            }
+        }
+
+        // Прямой ход, деление на D и обратный ход
+        for (int i = 1; i < rows; i++) {
+            for (int j = 0; j < lanes; j++) {
+                b[i * lanes + j] -= l[(i - 1) * lanes + j] * b[(i - 1) * lanes + j];
+            }
+        }
+        for (int i = 0; i < rows * lanes; i++) {
+            b[i] /= d[i];
+        }
+        for (int i = rows - 2; i >= 0; i--) {
+            for (int j = 0; j < lanes; j++) {
+                b[i * lanes + j] -= l[i * lanes + j] * b[(i + 1) * lanes + j];
+            }
+        }
+
+        for (int j = 0; j < group; j++) {
+            int m = order[start + j];
+            Result &result = results[m];
+            if (singular[j]) {
+                result.error = "Система уравнений вырождена";
+                continue;
+            }
+            int n = static_cast<int>(models[m].bars.size()) + 1;
+            std::vector<double> &u = result.solution.displacements;
+            u.resize(n);
+            for (int i = 0; i < n; i++) {
+                u[i] = b[i * lanes + j];
+            }
+            recover(models[m], result);
+            result.ok = true;
+        }
+    }
+
+    return results;
+}
+
+void RodSystemBatch::recover(const SaprProject &project, Result &result) {
+    // Усилия, напряжения и реакции по тем же формулам, что и RodSystemCalculator::calculate
+    Solution &solution = result.solution;
+    const std::vector<double> &u = solution.displacements;
+    int count = static_cast<int>(project.bars.size());
+    int n = count + 1;
+
+    std::vector<double> L(count), A(count), E(count), sigma_allow(count);
+    std::vector<double> k(count), Q(count), rodStress(count);
+    solution.forces.resize(count);
+    for (int p = 0; p < count; p++) {
+        const SaprProject::Bar &bar = project.bars[p];
+        L[p] = bar.L;
+        A[p] = bar.A;
+        E[p] = bar.E;
+        sigma_allow[p] = bar.sigma_allow;
+        k[p] = bar.E * bar.A / bar.L;
+        Q[p] = project.barForces[p] * bar.L / 2.0;
+        solution.forces[p] = k[p] * (u[p + 1] - u[p]) - Q[p];
+        rodStress[p] = solution.forces[p] / bar.A;
+    }
+
+    solution.nodalStresses.resize(n);
+    solution.nodalStresses[0] = rodStress[0];
+    solution.nodalStresses[n - 1] = rodStress[count - 1];
+    for (int i = 1; i < n - 1; i++) {
+        solution.nodalStresses[i] = (rodStress[i - 1] + rodStress[i]) / 2.0;
+    }
+
+    // Реакция заделки R = K u - f для строки без граничного условия
+    solution.leftAnchor = project.leftAnchor;
+    solution.rightAnchor = project.rightAnchor;
+    solution.reactions.assign(n, 0.0);
+    for (int i : {0, n - 1}) {
+        if ((i == 0 && !project.leftAnchor) || (i == n - 1 && !project.rightAnchor)) {
+            continue;
+        }
+        double residual = project.nodeForces[i];
+        if (i > 0) {
+            residual += Q[i - 1] - k[i - 1] * (u[i] - u[i - 1]);
+        }
+        if (i < n - 1) {
+            residual += Q[i] - k[i] * (u[i] - u[i + 1]);
+        }
+        solution.reactions[i] = -residual;
+    }
+
+    RodView rods;
+    rods.count = count;
+    rods.L = L.data();
+    rods.A = A.data();
+    rods.E = E.data();
+    rods.q = project.barForces.data();
+    rods.sigma_allow = sigma_allow.data();
+    solution.completeSections(rods);
+}
@@ -0,0 +1,43 @@
+#ifndef RODSYSTEMBATCH_H
+#define RODSYSTEMBATCH_H
+
+#include "projectreader.h"
+#include "solution.h"
+#include <string>
+#include <vector>
+
+// Пакетный расчет множества небольших независимых стержневых систем.
+// Модели сортируются по числу узлов и группируются по lanes штук; матрицы группы
+// хранятся с чередованием (элемент i модели j лежит в [i * lanes + j]), короткие
+// системы дополняются единичными строками. Разложение и решение выполняются для всей
+// группы одновременно: внутренний цикл по моделям не содержит ветвлений
+// и векторизуется компилятором. Операции те же, что в RodSystemCalculator
+// и TridiagonalSolver, поэтому результаты совпадают с поштучным расчетом.
+class RodSystemBatch {
+public:
+    static constexpr int lanes = 8;
+
+    struct Result {
+        bool ok = false;
+        std::string error;
+        Solution solution; // Тот же состав, что и у RodSystemCalculator::solve()
+    };
+
+    // Добавление модели; возвращает ее номер в пакете
+    int add(const SaprProject &project);
+    void clear() { models.clear(); }
+    int size() const { return static_cast<int>(models.size()); }
+
+    // Расчет всех моделей; результаты в порядке добавления
+    std::vector<Result> solve() const;
+
+    // Проверка исходных данных модели; пустая строка - модель можно решать
+    static std::string validate(const SaprProject &project);
+
+private:
+    std::vector<SaprProject> models;
+
+    static void recover(const SaprProject &project, Result &result);
+};
+
+#endif // RODSYSTEMBATCH_H
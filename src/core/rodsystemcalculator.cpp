@@ -0,0 +1,920 @@
+#include "rodsystemcalculator.h"
+#include "materiallibrary.h"
+#include "profiler.h"
+#include "rodkernels.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+RodSystemCalculator::RodSystemCalculator(int num_nodes) : n(num_nodes) {
+    F.resize(n, 0.0);
+    int count = n > 1 ? n - 1 : 0;
+    rods.L.assign(count, 0.0);
+    rods.A.assign(count, 0.0);
+    rods.E.assign(count, 0.0);
+    rods.q.assign(count, 0.0);
+    rods.sigma_allow.assign(count, 0.0);
+    rods.rho.assign(count, 7850.0);
+}
+
+RodSystemCalculator::RodSystemCalculator(const SaprProject &project) : n(0) { load(project); }
+
+void RodSystemCalculator::load(const SaprProject &project) {
+    n = static_cast<int>(project.bars.size()) + 1;
+    int count = getRodCount();
+    F.assign(n, 0.0);
+    rods.L.assign(count, 0.0);
+    rods.A.assign(count, 0.0);
+    rods.E.assign(count, 0.0);
+    rods.q.assign(count, 0.0);
+    rods.sigma_allow.assign(count, 0.0);
+    rods.rho.assign(count, 7850.0);
+    solvedDisplacements.clear(); // Прежнее разложение к новой модели не относится
+
+    for (int p = 0; p < count; p++) {
+        const SaprProject::Bar &bar = project.bars[p];
+        double q = p < static_cast<int>(project.barForces.size()) ? project.barForces[p] : 0.0;
+        setRod(p + 1, bar.L, bar.A, bar.E, q, bar.sigma_allow);
+        setRodDensity(p + 1, bar.rho);
+    }
+    rodMaterials.assign(count, -1);
+    rodSections.assign(count, -1);
+    for (int p = 0; p < count; p++) {
+        if (MaterialLibrary::usesMaterial(project, project.bars[p])) {
+            rodMaterials[p] = project.bars[p].material;
+        }
+        if (MaterialLibrary::usesSection(project, project.bars[p])) {
+            rodSections[p] = project.bars[p].section;
+        }
+    }
+    for (int i = 0; i < static_cast<int>(project.nodeForces.size()); i++) {
+        setForce(i + 1, project.nodeForces[i]);
+    }
+
+    // Конденсируются только экземпляры, стержни которых совпадают с подконструкцией;
+    // остальные рассчитываются как обычные стержни. Используемые подконструкции
+    // перенумеровываются подряд.
+    substructures.clear();
+    instances.clear();
+    superelements.clear();
+    std::vector<int> numbers(project.substructures.size(), -1);
+    int end = 0;
+    for (const SaprProject::Instance &instance : project.instances) {
+        if (instance.firstBar < end || !Superelement::matches(project, instance)) {
+            continue;
+        }
+        int &number = numbers[instance.substructure];
+        if (number < 0) {
+            number = static_cast<int>(substructures.size());
+            substructures.push_back(project.substructures[instance.substructure]);
+        }
+        instances.push_back({number, instance.firstBar});
+        end = instance.firstBar + static_cast<int>(substructures[number].bars.size());
+    }
+}
+
+int RodSystemCalculator::setMaterial(int material, double E, double sigma_allow, double rho) {
+    int changed = 0;
+    for (size_t p = 0; p < rodMaterials.size(); p++) {
+        if (rodMaterials[p] == material) {
+            rods.E[p] = E;
+            rods.sigma_allow[p] = sigma_allow;
+            rods.rho[p] = rho;
+            changed++;
+        }
+    }
+    // Подконструкции конденсируются заново при следующем расчете
+    for (SaprProject::Substructure &substructure : substructures) {
+        for (SaprProject::Bar &bar : substructure.bars) {
+            if (bar.material == material) {
+                bar.E = E;
+                bar.sigma_allow = sigma_allow;
+                bar.rho = rho;
+            }
+        }
+    }
+    superelements.clear();
+    return changed;
+}
+
+int RodSystemCalculator::setSection(int section, double A) {
+    int changed = 0;
+    for (size_t p = 0; p < rodSections.size(); p++) {
+        if (rodSections[p] == section) {
+            rods.A[p] = A;
+            changed++;
+        }
+    }
+    for (SaprProject::Substructure &substructure : substructures) {
+        for (SaprProject::Bar &bar : substructure.bars) {
+            if (bar.section == section) {
+                bar.A = A;
+            }
+        }
+    }
+    superelements.clear();
+    return changed;
+}
+
+void RodSystemCalculator::dropSubstructures() {
+    substructures.clear();
+    instances.clear();
+    superelements.clear();
+}
+
+void RodSystemCalculator::setRod(int p, double L, double A, double E, double q,
+                                 double sigma_allow) {
+    if (p >= 1 && p < n) {
+        dropSubstructures();
+        if (p - 1 < static_cast<int>(rodMaterials.size())) {
+            rodMaterials[p - 1] = -1;
+            rodSections[p - 1] = -1;
+        }
+        rods.L[p - 1] = L;
+        rods.A[p - 1] = A;
+        rods.E[p - 1] = E;
+        rods.q[p - 1] = q;
+        rods.sigma_allow[p - 1] = sigma_allow;
+    }
+}
+
+void RodSystemCalculator::setRodDensity(int p, double rho) {
+    if (p >= 1 && p < n) {
+        rods.rho[p - 1] = rho;
+    }
+}
+
+void RodSystemCalculator::setForce(int node, double force) {
+    if (node >= 1 && node <= n) {
+        dropSubstructures();
+        F[node - 1] = force;
+    }
+}
+
+void RodSystemCalculator::setRods(const double *L, const double *A, const double *E,
+                                  const double *q, const double *sigma_allow, const double *rho) {
+    int count = getRodCount();
+    if (count <= 0) {
+        return;
+    }
+    dropSubstructures();
+    rodMaterials.clear();
+    rodSections.clear();
+    rods.L.assign(L, L + count);
+    rods.A.assign(A, A + count);
+    rods.E.assign(E, E + count);
+    rods.q.assign(q, q + count);
+    if (sigma_allow) {
+        rods.sigma_allow.assign(sigma_allow, sigma_allow + count);
+    }
+    if (rho) {
+        rods.rho.assign(rho, rho + count);
+    }
+}
+
+void RodSystemCalculator::setForces(const double *forces) {
+    dropSubstructures();
+    F.assign(forces, forces + n);
+}
+
+#include <iostream>
+
+namespace {
+
+// Ошибки разложения (нулевой ведущий элемент, плохая обусловленность) передаются
+// вызывающему коду как вырожденность системы
+template <class Factor> void factorChecked(Factor &&factor) {
+    try {
+        factor();
+    } catch (const CalculationError &) {
+        throw;
+    } catch (const std::runtime_error &e) {
+        throw CalculationError(CalculationError::Code::Singular, e.what());
+    }
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point from,
+                 std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+} // namespace
+
+std::ostream &RodSystemCalculator::log() const {
+    // Поток без буфера игнорирует вывод: используется, когда журнал отключен
+    static thread_local std::ostream nullStream(nullptr);
+    return logging ? std::cout : nullStream;
+}
+
+void RodSystemCalculator::calculate(std::vector<double> &displacements, std::vector<double> &forces,
+                                    std::vector<double> &stresses, bool leftAnchor,
+                                    bool rightAnchor) {
+    workspace.fit(displacements, n);
+    workspace.fit(forces, std::max(getRodCount(), 0));
+    workspace.fit(stresses, n);
+    calculateInto(displacements.data(), forces.data(), stresses.data(), leftAnchor, rightAnchor);
+}
+
+void RodSystemCalculator::calculateInto(double *displacements, double *forces, double *stresses,
+                                        bool leftAnchor, bool rightAnchor) {
+    ProfileScope profile("RodSystemCalculator::calculate");
+
+    int rodCount = getRodCount();
+
+    log() << "RodSystemCalculator::calculate called" << std::endl;
+    log() << "n (nodes): " << n << ", rods: " << rodCount << std::endl;
+    log() << "Anchors - left: " << leftAnchor << ", right: " << rightAnchor << std::endl;
+
+    if (rodCount <= 0) {
+        log() << "ERROR: No rods for calculation" << std::endl;
+        throw CalculationError(CalculationError::Code::NoRods, "Нет стержней для расчета");
+    }
+
+    // Проверяем данные стержней
+    if (logging) {
+        for (int p = 0; p < rodCount; p++) {
+            log() << "Rod " << p + 1 << ": L=" << rods.L[p] << " A=" << rods.A[p]
+                  << " E=" << rods.E[p] << " q=" << rods.q[p] << std::endl;
+        }
+    }
+
+    // Повторяющиеся подконструкции: решается только система узлов между экземплярами
+    if (condensation && !instances.empty() && solverMode == SolverMode::Direct) {
+        calculateCondensed(displacements, forces, stresses, leftAnchor, rightAnchor);
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    timings = SolveTimings();
+    ProfileScope assemblyProfile("RodSystemCalculator::assembly");
+
+    // Матрица жесткости трехдиагональна: хранятся главная диагональ и поддиагональ.
+    // Буферы берутся из рабочей области и не выделяются заново при том же размере.
+    workspace.prepare(n);
+    std::vector<double> &diag = workspace.diag;
+    std::vector<double> &off = workspace.off;
+    std::vector<double> &b = workspace.rhs;
+    std::vector<double> &k = workspace.stiffness;
+    std::vector<double> &Q = workspace.load;
+
+    log() << "Building stiffness matrix and load vector..." << std::endl;
+
+    // Поэлементные жесткости EA/L и узловые силы qL/2 от распределенной нагрузки,
+    // затем сборка: diag[i] = k[i-1] + k[i], off[i] = -k[i], b[i] = F[i] + Q[i-1] + Q[i]
+    RodKernels::elementStiffness(rods.E.data(), rods.A.data(), rods.L.data(), k.data(), rodCount);
+    RodKernels::elementLoads(rods.q.data(), rods.L.data(), Q.data(), rodCount);
+    RodKernels::assemble(k.data(), Q.data(), F.data(), diag.data(), off.data(), b.data(), n);
+
+    if (logging) {
+        for (int p = 0; p < rodCount; p++) {
+            log() << "Stiffness for rod " << p + 1 << ": " << k[p] << std::endl;
+        }
+        for (int i = 0; i < n; i++) {
+            log() << "Node " << i + 1 << " concentrated force: " << F[i] << std::endl;
+        }
+        for (int p = 0; p < rodCount; p++) {
+            log() << "Rod " << p + 1 << " distributed load: " << rods.q[p]
+                  << ", total load: " << (rods.q[p] * rods.L[p]) << ", fixed end forces: " << Q[p]
+                  << " at both ends" << std::endl;
+        }
+
+        log() << "Load vector before BC: [";
+        for (int i = 0; i < n; i++) {
+            log() << b[i] << (i < n - 1 ? ", " : "]");
+        }
+        log() << std::endl;
+    }
+
+    log() << "Applying boundary conditions..." << std::endl;
+
+    // Применение граничных условий: строка и столбец заделки заменяются единичными
+    if (leftAnchor) {
+        log() << "Applying left anchor" << std::endl;
+        diag[0] = 1.0;
+        off[0] = 0.0;
+        b[0] = 0.0; // Перемещение фиксировано = 0
+    }
+
+    if (rightAnchor) {
+        log() << "Applying right anchor" << std::endl;
+        diag[n - 1] = 1.0;
+        off[n - 2] = 0.0;
+        b[n - 1] = 0.0; // Перемещение фиксировано = 0
+    }
+
+    log() << "Solving linear system..." << std::endl;
+
+    auto assembled = std::chrono::steady_clock::now();
+    timings.assembly = elapsedMs(start, assembled);
+    assemblyProfile.stop();
+    ProfileScope solveProfile("RodSystemCalculator::solve");
+
+    report = SolveReport();
+    report.mixedPrecision = (solverMode == SolverMode::MixedPrecision);
+
+    // Разложение сохраняется для последующего анализа чувствительности
+    if (solverMode == SolverMode::MixedPrecision) {
+        factorChecked([&]() { workspace.mixedSolver.factor(diag, off); });
+        // Итоги уточнения относятся к этому решению; решения анализа чувствительности
+        // с тем же разложением отчет не меняют
+        MixedPrecisionSolver::Refinement refinement = workspace.mixedSolver.solve(b);
+
+        const MixedPrecisionSolver::Report &mixed = workspace.mixedSolver.report();
+        report.floatFactorization = mixed.mixed;
+        report.conditionEstimate = mixed.condition;
+        report.minPivotRatio = mixed.minPivotRatio;
+        report.refinementSteps = refinement.steps;
+        report.backwardError = refinement.backwardError;
+    } else {
+        // Масштабирование S K S степенями двойки не меняет результат ни в одном разряде,
+        // но делает проверку ведущих элементов и оценку обусловленности независимыми
+        // от единиц измерения и от единичных строк заделок
+        std::vector<double> &scale = workspace.scale;
+        if (!TridiagonalSolver::equilibrate(diag, off, scale)) {
+            throw CalculationError(CalculationError::Code::Singular, "Система уравнений вырождена");
+        }
+        // Длинные системы делятся на блоки, решаемые параллельно
+        ParallelTridiagonalSolver &parallel = workspace.parallelSolver;
+        bool useParallel = n >= parallelThreshold && parallel.threads() > 1;
+        if (useParallel) {
+            factorChecked([&]() { parallel.factor(diag, off); });
+        } else {
+            factorChecked([&]() { workspace.solver.factor(diag, off); });
+        }
+        for (int i = 0; i < n; i++) {
+            b[i] *= scale[i];
+        }
+        if (useParallel) {
+            parallel.solve(b);
+        } else {
+            workspace.solver.solve(b);
+        }
+        for (int i = 0; i < n; i++) {
+            b[i] *= scale[i];
+        }
+
+        report.minPivotRatio =
+            useParallel ? parallel.minPivotRatio() : workspace.solver.minPivotRatio();
+        if (diagnostics) {
+            workspace.prepareEstimate(n);
+            report.conditionEstimate =
+                useParallel ? parallel.conditionEstimate(diag, off, workspace.estimate)
+                            : workspace.solver.conditionEstimate(diag, off, workspace.estimate);
+        }
+        solvedParallel = useParallel;
+    }
+    solvedMode = solverMode;
+
+    solvedCondensed = false;
+
+    auto factored = std::chrono::steady_clock::now();
+    timings.factorization = elapsedMs(assembled, factored);
+    solveProfile.stop();
+
+    std::copy(b.begin(), b.end(), displacements);
+    recover(displacements, forces, stresses, leftAnchor, rightAnchor);
+    timings.recovery = elapsedMs(factored, std::chrono::steady_clock::now());
+    timings.total = elapsedMs(start, std::chrono::steady_clock::now());
+
+    log() << "RodSystemCalculator::calculate finished successfully" << std::endl;
+}
+
+void RodSystemCalculator::recover(const double *displacements, double *forces, double *stresses,
+                                  bool leftAnchor, bool rightAnchor) {
+    ProfileScope recoveryProfile("RodSystemCalculator::recovery");
+    int rodCount = getRodCount();
+    const std::vector<double> &k = workspace.stiffness;
+    const std::vector<double> &Q = workspace.load;
+
+    workspace.fit(solvedDisplacements, n);
+    std::copy(displacements, displacements + n, solvedDisplacements.begin());
+    solvedLeftAnchor = leftAnchor;
+    solvedRightAnchor = rightAnchor;
+
+    checkEquilibrium(displacements, leftAnchor, rightAnchor);
+
+    log() << "Condition estimate: " << report.conditionEstimate
+          << ", equilibrium residual: " << report.equilibriumResidual
+          << ", global residual: " << report.globalResidual << std::endl;
+    if (logging) {
+        for (int i = 0; i < n; i++) {
+            if ((i == 0 && leftAnchor) || (i == n - 1 && rightAnchor)) {
+                log() << "Node " << i + 1 << " reaction: " << reactions[i] << std::endl;
+            }
+        }
+    }
+
+    if (logging) {
+        log() << "Displacements: [";
+        for (int i = 0; i < n; i++) {
+            log() << displacements[i] << (i < n - 1 ? ", " : "]");
+        }
+        log() << std::endl;
+    }
+
+    // Усилия в стержнях: N = (EA/L) * (u_j - u_i) - (qL/2)
+    RodKernels::elementForces(k.data(), Q.data(), displacements, forces, rodCount);
+
+    if (logging) {
+        for (int p = 0; p < rodCount; p++) {
+            log() << "Rod " << p + 1 << " delta_U: " << displacements[p + 1] - displacements[p]
+                  << ", force: " << forces[p] << std::endl;
+        }
+    }
+
+    // Напряжения в УЗЛАХ: крайние узлы - из крайних стержней,
+    // промежуточные - среднее напряжение из двух соседних стержней
+    RodKernels::elementStresses(forces, rods.A.data(), workspace.rodStress.data(), rodCount);
+    RodKernels::nodalStresses(workspace.rodStress.data(), stresses, n);
+
+    if (logging) {
+        for (int i = 0; i < n; i++) {
+            log() << "Node " << i + 1 << " stress: " << stresses[i] << std::endl;
+        }
+    }
+}
+
+void RodSystemCalculator::calculateCondensed(double *displacements, double *forces,
+                                             double *stresses, bool leftAnchor,
+                                             bool rightAnchor) {
+    auto start = std::chrono::steady_clock::now();
+    timings = SolveTimings();
+    ProfileScope assemblyProfile("RodSystemCalculator::assembly");
+    int rodCount = getRodCount();
+
+    // Конденсация выполняется один раз для всех экземпляров подконструкции
+    if (superelements.size() != substructures.size()) {
+        superelements.clear();
+        for (const SaprProject::Substructure &substructure : substructures) {
+            superelements.emplace_back(substructure);
+        }
+    }
+
+    // Жесткости и нагрузки всех стержней нужны для усилий и реакций
+    workspace.prepare(n);
+    std::vector<double> &k = workspace.stiffness;
+    std::vector<double> &Q = workspace.load;
+    RodKernels::elementStiffness(rods.E.data(), rods.A.data(), rods.L.data(), k.data(), rodCount);
+    RodKernels::elementLoads(rods.q.data(), rods.L.data(), Q.data(), rodCount);
+
+    // Сокращенная цепочка: узлы на концах стержней вне экземпляров и на концах экземпляров
+    reducedNodes.clear();
+    reducedNodes.push_back(0);
+    for (size_t next = 0, p = 0; static_cast<int>(p) < rodCount;) {
+        if (next < instances.size() && instances[next].firstBar == static_cast<int>(p)) {
+            p += superelements[instances[next++].substructure].barCount();
+        } else {
+            p++;
+        }
+        reducedNodes.push_back(static_cast<int>(p));
+    }
+    int size = static_cast<int>(reducedNodes.size());
+    log() << "Condensed system: " << size << " of " << n << " nodes, " << instances.size()
+          << " substructure instances" << std::endl;
+
+    std::vector<double> &diag = workspace.diag;
+    std::vector<double> &off = workspace.off;
+    std::vector<double> &b = workspace.rhs;
+    workspace.fit(diag, size);
+    workspace.fit(off, size - 1);
+    workspace.fit(b, size);
+    for (int i = 0; i < size; i++) {
+        diag[i] = 0.0;
+        b[i] = F[reducedNodes[i]];
+    }
+    for (size_t next = 0, e = 0; static_cast<int>(e) + 1 < size; e++) {
+        int first = reducedNodes[e];
+        double stiffness, loadStart, loadEnd;
+        if (next < instances.size() && instances[next].firstBar == first) {
+            const Superelement &element = superelements[instances[next++].substructure];
+            stiffness = element.stiffness();
+            loadStart = element.loadStart();
+            loadEnd = element.loadEnd();
+        } else {
+            stiffness = k[first];
+            loadStart = Q[first];
+            loadEnd = Q[first];
+        }
+        diag[e] += stiffness;
+        diag[e + 1] += stiffness;
+        off[e] = -stiffness;
+        b[e] += loadStart;
+        b[e + 1] += loadEnd;
+    }
+
+    if (leftAnchor) {
+        diag[0] = 1.0;
+        off[0] = 0.0;
+        b[0] = 0.0;
+    }
+    if (rightAnchor) {
+        diag[size - 1] = 1.0;
+        off[size - 2] = 0.0;
+        b[size - 1] = 0.0;
+    }
+
+    auto assembled = std::chrono::steady_clock::now();
+    timings.assembly = elapsedMs(start, assembled);
+    assemblyProfile.stop();
+    ProfileScope solveProfile("RodSystemCalculator::solve");
+
+    report = SolveReport();
+    std::vector<double> &scale = workspace.scale;
+    if (!TridiagonalSolver::equilibrate(diag, off, scale)) {
+        throw CalculationError(CalculationError::Code::Singular, "Система уравнений вырождена");
+    }
+    factorChecked([&]() { workspace.solver.factor(diag, off); });
+    for (int i = 0; i < size; i++) {
+        b[i] *= scale[i];
+    }
+    workspace.solver.solve(b);
+    for (int i = 0; i < size; i++) {
+        b[i] *= scale[i];
+    }
+    report.minPivotRatio = workspace.solver.minPivotRatio();
+    if (diagnostics) {
+        workspace.prepareEstimate(size);
+        report.conditionEstimate =
+            workspace.solver.conditionEstimate(diag, off, workspace.estimate);
+    }
+    solvedMode = SolverMode::Direct;
+    solvedParallel = false;
+    // Разложение относится к сокращенной системе и для анализа чувствительности не годится
+    solvedCondensed = true;
+
+    // Перемещения внутренних узлов экземпляров - по перемещениям их концов
+    for (size_t next = 0, e = 0; static_cast<int>(e) < size; e++) {
+        int node = reducedNodes[e];
+        displacements[node] = b[e];
+        if (e > 0 && next < instances.size() && instances[next].firstBar == reducedNodes[e - 1]) {
+            superelements[instances[next++].substructure].recover(
+                b[e - 1], b[e], displacements + reducedNodes[e - 1] + 1);
+        }
+    }
+
+    auto factored = std::chrono::steady_clock::now();
+    timings.factorization = elapsedMs(assembled, factored);
+    solveProfile.stop();
+
+    recover(displacements, forces, stresses, leftAnchor, rightAnchor);
+    timings.recovery = elapsedMs(factored, std::chrono::steady_clock::now());
+    timings.total = elapsedMs(start, std::chrono::steady_clock::now());
+
+    log() << "RodSystemCalculator::calculate finished successfully" << std::endl;
+}
+
+std::vector<RodSystemCalculator::StrengthCheck>
+RodSystemCalculator::checkStrength(const std::vector<double> &displacements) const {
+    if (displacements.size() != static_cast<size_t>(n)) {
+        throw CalculationError(CalculationError::Code::NoSolution,
+                               "Нет результатов расчета для проверки прочности");
+    }
+    return Solution::checkStrength(rodView(), displacements);
+}
+
+void RodSystemCalculator::checkStrength(const std::vector<double> &displacements,
+                                        std::vector<StrengthCheck> &checks) const {
+    if (displacements.size() != static_cast<size_t>(n)) {
+        throw CalculationError(CalculationError::Code::NoSolution,
+                               "Нет результатов расчета для проверки прочности");
+    }
+    Solution::checkStrength(rodView(), displacements, checks);
+}
+
+RodView RodSystemCalculator::rodView() const {
+    RodView view;
+    view.count = getRodCount();
+    view.L = rods.L.data();
+    view.A = rods.A.data();
+    view.E = rods.E.data();
+    view.q = rods.q.data();
+    view.sigma_allow = rods.sigma_allow.data();
+    return view;
+}
+
+Solution RodSystemCalculator::solve(bool leftAnchor, bool rightAnchor) {
+    auto start = std::chrono::steady_clock::now();
+
+    Solution solution;
+    calculate(solution.displacements, solution.forces, solution.nodalStresses, leftAnchor,
+              rightAnchor);
+    solution.leftAnchor = leftAnchor;
+    solution.rightAnchor = rightAnchor;
+    solution.reactions = std::move(reactions);
+    solution.diagnostics = report;
+
+    auto sections = std::chrono::steady_clock::now();
+    solution.completeSections(rodView());
+    auto finish = std::chrono::steady_clock::now();
+
+    solution.timings = timings;
+    solution.timings.recovery += elapsedMs(sections, finish);
+    solution.timings.total = elapsedMs(start, finish);
+    return solution;
+}
+
+void RodSystemCalculator::sortByUtilization(std::vector<StrengthCheck> &checks) {
+    std::stable_sort(checks.begin(), checks.end(),
+                     [](const StrengthCheck &a, const StrengthCheck &b) {
+                         return a.utilization > b.utilization;
+                     });
+}
+
+std::vector<RodSystemCalculator::StrengthCheck>
+RodSystemCalculator::filterOverloaded(const std::vector<StrengthCheck> &checks, double threshold) {
+    std::vector<StrengthCheck> result;
+    for (const StrengthCheck &check : checks) {
+        if (check.utilization > threshold) {
+            result.push_back(check);
+        }
+    }
+    return result;
+}
+
+void RodSystemCalculator::requireSolution() const {
+    if (solvedDisplacements.size() != static_cast<size_t>(n)) {
+        throw CalculationError(CalculationError::Code::NoSolution,
+                               "Сначала необходимо выполнить расчет");
+    }
+    if (solvedCondensed) {
+        throw CalculationError(CalculationError::Code::NoSolution,
+                               "Анализ чувствительности требует расчета без конденсации");
+    }
+}
+
+void RodSystemCalculator::solveFactored(std::vector<double> &v) const {
+    if (solvedMode == SolverMode::MixedPrecision) {
+        workspace.mixedSolver.solve(v);
+        return;
+    }
+
+    // Разложение хранится для S K S: x = S (S K S)^-1 S v
+    const std::vector<double> &scale = workspace.scale;
+    for (int i = 0; i < n; i++) {
+        v[i] *= scale[i];
+    }
+    if (solvedParallel) {
+        workspace.parallelSolver.solve(v);
+    } else {
+        workspace.solver.solve(v);
+    }
+    for (int i = 0; i < n; i++) {
+        v[i] *= scale[i];
+    }
+}
+
+void RodSystemCalculator::checkEquilibrium(const double *u, bool leftAnchor,
+                                           bool rightAnchor) {
+    // Дисбаланс узла по поэлементным жесткостям (полная матрица не хранится):
+    // r_i = F_i + Q_i-1 + Q_i - k_i-1 (u_i - u_i-1) - k_i (u_i - u_i+1).
+    // В свободном узле это невязка решения, в заделке r_i + R_i = 0, то есть реакция
+    // R = K u - f для строки без граничного условия.
+    const std::vector<double> &k = workspace.stiffness;
+    const std::vector<double> &Q = workspace.load;
+    workspace.fit(reactions, n);
+
+    double total = 0.0;          // sum R + sum F + sum qL
+    double totalMagnitude = 0.0; // Сумма модулей тех же слагаемых
+
+    for (int i = 0; i < n; i++) {
+        double residual = F[i];
+        double magnitude = std::abs(F[i]);
+        if (i > 0) {
+            double internal = k[i - 1] * (u[i] - u[i - 1]);
+            residual += Q[i - 1] - internal;
+            magnitude += std::abs(Q[i - 1]) + std::abs(internal);
+        }
+        if (i < n - 1) {
+            double internal = k[i] * (u[i] - u[i + 1]);
+            residual += Q[i] - internal;
+            magnitude += std::abs(Q[i]) + std::abs(internal);
+        }
+
+        total += F[i];
+        totalMagnitude += std::abs(F[i]);
+        if (i < n - 1) {
+            total += 2.0 * Q[i];
+            totalMagnitude += 2.0 * std::abs(Q[i]);
+        }
+
+        if ((i == 0 && leftAnchor) || (i == n - 1 && rightAnchor)) {
+            reactions[i] = -residual;
+            total += reactions[i];
+            totalMagnitude += std::abs(reactions[i]);
+            continue;
+        }
+        reactions[i] = 0.0;
+
+        // Невязка свободного узла относится к сумме модулей слагаемых
+        double relative = magnitude > 0.0 ? std::abs(residual) / magnitude : 0.0;
+        if (relative > report.equilibriumResidual || report.worstNode < 0) {
+            report.equilibriumResidual = relative;
+            report.worstNode = i;
+        }
+    }
+
+    // Равновесие системы в целом: внутренние усилия взаимно уничтожаются
+    report.globalResidual = totalMagnitude > 0.0 ? std::abs(total) / totalMagnitude : 0.0;
+}
+
+void RodSystemCalculator::zeroAnchored(std::vector<double> &v) const {
+    if (solvedLeftAnchor) {
+        v[0] = 0.0;
+    }
+    if (solvedRightAnchor) {
+        v[n - 1] = 0.0;
+    }
+}
+
+double RodSystemCalculator::stiffnessDerivative(int p, Parameter parameter) const {
+    const Rod rod = rodAt(p);
+    switch (parameter) {
+    case Parameter::Area:
+        return rod.E / rod.L;
+    case Parameter::ElasticModulus:
+        return rod.A / rod.L;
+    case Parameter::Length:
+        return -rod.E * rod.A / (rod.L * rod.L);
+    default:
+        return 0.0;
+    }
+}
+
+double RodSystemCalculator::loadDerivative(int p, Parameter parameter) const {
+    const Rod rod = rodAt(p);
+    switch (parameter) {
+    case Parameter::Length:
+        return rod.q / 2.0;
+    case Parameter::DistributedLoad:
+        return rod.L / 2.0;
+    default:
+        return 0.0;
+    }
+}
+
+double RodSystemCalculator::forceExplicitDerivative(int p, Parameter parameter) const {
+    // N = (EA/L) * (u_j - u_i) - qL/2 при фиксированных перемещениях
+    double delta_U = solvedDisplacements[p + 1] - solvedDisplacements[p];
+    return stiffnessDerivative(p, parameter) * delta_U - loadDerivative(p, parameter);
+}
+
+std::vector<double> RodSystemCalculator::sensitivityRow(Response response, int index,
+                                                        Parameter parameter) const {
+    requireSolution();
+
+    const std::vector<double> &u = solvedDisplacements;
+    int count = (response == Response::Force) ? n - 1 : n;
+    if (index < 0 || index >= count) {
+        throw CalculationError(CalculationError::Code::InvalidInput,
+                               "Некорректный номер величины для анализа чувствительности");
+    }
+
+    // Величина как линейная комбинация усилий: sum w_p * N_p (или w_p * N_p / A_p для напряжений)
+    struct Term {
+        int rod;
+        double weight;
+    };
+    std::vector<Term> terms;
+    if (response == Response::Force) {
+        terms.push_back({index, 1.0});
+    } else if (response == Response::Stress) {
+        if (index == 0) {
+            terms.push_back({0, 1.0});
+        } else if (index == n - 1) {
+            terms.push_back({n - 2, 1.0});
+        } else {
+            terms.push_back({index - 1, 0.5});
+            terms.push_back({index, 0.5});
+        }
+    }
+
+    // Правая часть сопряженной задачи dR/du и явная часть dR/dtheta
+    std::vector<double> lambda(n, 0.0);
+    std::vector<double> row(n - 1, 0.0);
+
+    if (response == Response::Displacement) {
+        lambda[index] = 1.0;
+    }
+    for (const Term &term : terms) {
+        const Rod rod = rodAt(term.rod);
+        double scale = (response == Response::Stress) ? term.weight / rod.A : term.weight;
+        double k = rod.E * rod.A / rod.L;
+
+        lambda[term.rod + 1] += scale * k;
+        lambda[term.rod] -= scale * k;
+
+        row[term.rod] += scale * forceExplicitDerivative(term.rod, parameter);
+        if (response == Response::Stress && parameter == Parameter::Area) {
+            double N = k * (u[term.rod + 1] - u[term.rod]) - rod.q * rod.L / 2.0;
+            row[term.rod] -= term.weight * N / (rod.A * rod.A);
+        }
+    }
+
+    addAdjointTerms(lambda, row, parameter);
+    return row;
+}
+
+std::vector<double> RodSystemCalculator::sensitivityWeighted(const std::vector<double> &weights,
+                                                             Parameter parameter) const {
+    requireSolution();
+    if (static_cast<int>(weights.size()) != n - 1) {
+        throw CalculationError(CalculationError::Code::InvalidInput,
+                               "Некорректное число весов для анализа чувствительности");
+    }
+
+    std::vector<double> lambda(n, 0.0);
+    std::vector<double> row(n - 1, 0.0);
+    for (int p = 0; p < n - 1; p++) {
+        if (weights[p] == 0.0) {
+            continue;
+        }
+        const Rod rod = rodAt(p);
+        double k = rod.E * rod.A / rod.L;
+        lambda[p + 1] += weights[p] * k;
+        lambda[p] -= weights[p] * k;
+        row[p] += weights[p] * forceExplicitDerivative(p, parameter);
+    }
+
+    addAdjointTerms(lambda, row, parameter);
+    return row;
+}
+
+void RodSystemCalculator::addAdjointTerms(std::vector<double> &lambda, std::vector<double> &row,
+                                          Parameter parameter) const {
+    const std::vector<double> &u = solvedDisplacements;
+
+    // K lambda = dR/du; в заделках перемещения не зависят от параметров
+    solveFactored(lambda);
+    zeroAnchored(lambda);
+
+    // dR/dtheta_p = явная часть + lambda^T (dF/dtheta_p - dK/dtheta_p u)
+    for (int p = 0; p < n - 1; p++) {
+        double dk = stiffnessDerivative(p, parameter);
+        double df = loadDerivative(p, parameter);
+        row[p] += (lambda[p] + lambda[p + 1]) * df -
+                  dk * (lambda[p + 1] - lambda[p]) * (u[p + 1] - u[p]);
+    }
+}
+
+std::vector<std::vector<double>>
+RodSystemCalculator::sensitivityJacobian(Response response, Parameter parameter) const {
+    requireSolution();
+
+    const std::vector<double> &u = solvedDisplacements;
+    int count = (response == Response::Force) ? n - 1 : n;
+    std::vector<std::vector<double>> jacobian(count, std::vector<double>(n - 1, 0.0));
+
+    std::vector<double> du(n);
+    std::vector<double> dN(n - 1);
+
+    for (int i = 0; i < n - 1; i++) {
+        // K du = dF/dtheta_i - dK/dtheta_i u (ненулевые только в узлах стержня i)
+        double dk = stiffnessDerivative(i, parameter);
+        double df = loadDerivative(i, parameter);
+        std::fill(du.begin(), du.end(), 0.0);
+        du[i] = df - dk * (u[i] - u[i + 1]);
+        du[i + 1] = df - dk * (u[i + 1] - u[i]);
+        zeroAnchored(du);
+        solveFactored(du);
+
+        if (response == Response::Displacement) {
+            for (int j = 0; j < n; j++) {
+                jacobian[j][i] = du[j];
+            }
+            continue;
+        }
+
+        for (int p = 0; p < n - 1; p++) {
+            const Rod rod = rodAt(p);
+            dN[p] = rod.E * rod.A / rod.L * (du[p + 1] - du[p]);
+        }
+        dN[i] += forceExplicitDerivative(i, parameter);
+
+        if (response == Response::Force) {
+            for (int p = 0; p < n - 1; p++) {
+                jacobian[p][i] = dN[p];
+            }
+            continue;
+        }
+
+        // d(N_p / A_p) с учетом явной зависимости от площади стержня i
+        auto stressDerivative = [&](int p) {
+            const Rod rod = rodAt(p);
+            double value = dN[p] / rod.A;
+            if (p == i && parameter == Parameter::Area) {
+                double N = rod.E * rod.A / rod.L * (u[p + 1] - u[p]) - rod.q * rod.L / 2.0;
+                value -= N / (rod.A * rod.A);
+            }
+            return value;
+        };
+
+        jacobian[0][i] = stressDerivative(0);
+        jacobian[n - 1][i] = stressDerivative(n - 2);
+        for (int j = 1; j < n - 1; j++) {
+            jacobian[j][i] = (stressDerivative(j - 1) + stressDerivative(j)) / 2.0;
+        }
+    }
+
+    return jacobian;
+}
@@ -0,0 +1,218 @@
+#ifndef RODSYSTEMCALCULATOR_H
+#define RODSYSTEMCALCULATOR_H
+
+#include "saprproject.h"
+#include "solution.h"
+#include "solverworkspace.h"
+#include "superelement.h"
+#include <cmath>
+#include <ostream>
+#include <vector>
+
+class RodSystemCalculator {
+private:
+    struct Rod {
+        double L;           // Длина стержня
+        double A;           // Площадь поперечного сечения
+        double E;           // Модуль упругости
+        double q;           // Распределенная нагрузка
+        double sigma_allow; // Допустимое напряжение
+        double rho;         // Плотность материала
+    };
+
+    // Свойства стержней хранятся по столбцам, чтобы ядра сборки читали их подряд
+    struct RodArrays {
+        std::vector<double> L, A, E, q, sigma_allow, rho;
+    };
+
+    RodArrays rods;
+    std::vector<double> F; // Сосредоточенные силы в узлах
+    int n;                 // Количество узлов
+
+    // Буферы, переиспользуемые между расчетами; разложение последней матрицы
+    // хранится в workspace.solver и используется анализом чувствительности
+    SolverWorkspace workspace;
+    std::vector<double> solvedDisplacements;
+    bool solvedLeftAnchor = false;
+    bool solvedRightAnchor = false;
+
+    bool logging = true; // Отладочный вывод хода расчета в std::cout
+    std::ostream &log() const;
+
+    Rod rodAt(int p) const {
+        return {rods.L[p], rods.A[p], rods.E[p], rods.q[p], rods.sigma_allow[p], rods.rho[p]};
+    }
+
+public:
+    using StrengthCheck = ::StrengthCheck;
+    using SolveReport = SolveDiagnostics;
+
+    // Способ решения системы уравнений
+    enum class SolverMode {
+        Direct,        // Разложение L D L^T в double
+        MixedPrecision // Разложение во float с уточнением до double и оценкой обусловленности
+    };
+
+    // Параметры стержня, по которым вычисляются производные
+    enum class Parameter { Area, ElasticModulus, Length, DistributedLoad };
+
+    // Величины, производные которых вычисляются (совпадают с результатами calculate)
+    enum class Response {
+        Displacement, // Перемещение узла
+        Force,        // Усилие в стержне
+        Stress        // Напряжение в узле
+    };
+
+    RodSystemCalculator(int num_nodes);
+    // Калькулятор с данными проекта (стержни, плотности, сосредоточенные и распределенные силы)
+    explicit RodSystemCalculator(const SaprProject &project);
+
+    // Замена всех данных моделью проекта. Рабочие буферы сохраняются, поэтому один
+    // калькулятор может последовательно решать разные задачи без повторных выделений.
+    // Экземпляры подконструкций проекта рассчитываются конденсацией (см. setCondensation);
+    // setRod, setRods, setForce и setForces отменяют ее до следующего load().
+    void load(const SaprProject &project);
+
+    void setRod(int p, double L, double A, double E, double q,
+                double sigma_allow);
+    void setRodDensity(int p, double rho);
+    void setForce(int node, double force);
+    // Все стержни и силы сразу из массивов по getRodCount() / getNodeCount() значений;
+    // sigma_allow и rho могут быть nullptr (значения не меняются)
+    void setRods(const double *L, const double *A, const double *E, const double *q,
+                 const double *sigma_allow = nullptr, const double *rho = nullptr);
+    void setForces(const double *forces);
+    void setLogging(bool enabled) { logging = enabled; }
+    void setSolverMode(SolverMode mode) { solverMode = mode; }
+    // Новые значения материала или сечения библиотеки проекта (номер - как в
+    // SaprProject::materials / sections последнего load()) для всех стержней, которые на него
+    // ссылаются, включая стержни подконструкций; следующий расчет учитывает их.
+    // Возвращается число измененных стержней.
+    int setMaterial(int material, double E, double sigma_allow, double rho);
+    int setSection(int section, double A);
+    // В прямом режиме экземпляры подконструкций заменяются суперэлементами: решается
+    // система узлов на их концах, внутренние перемещения восстанавливаются по ним.
+    // Анализ чувствительности после такого расчета недоступен.
+    void setCondensation(bool enabled) { condensation = enabled; }
+    int getInstanceCount() const { return static_cast<int>(instances.size()); }
+    SolverMode getSolverMode() const { return solverMode; }
+    void calculate(std::vector<double> & displacements,
+                   std::vector<double> & forces, std::vector<double> & stresses,
+                   bool leftAnchor, bool rightAnchor);
+    // То же с записью в буферы вызывающей стороны: displacements и stresses - по
+    // getNodeCount() значений, forces - getRodCount(); размеры не проверяются
+    void calculateInto(double *displacements, double *forces, double *stresses,
+                       bool leftAnchor, bool rightAnchor);
+
+    // Расчет с полным результатом: перемещения, усилия, напряжения в узлах и сечениях,
+    // реакции, координаты, проверка прочности, диагностика и время этапов.
+    // Буферы результата принадлежат Solution и передаются без копирования.
+    Solution solve(bool leftAnchor, bool rightAnchor);
+
+    // Проверка прочности по уже найденным перемещениям (повторного решения не требует)
+    std::vector<StrengthCheck> checkStrength(const std::vector<double> &displacements) const;
+    // То же в готовый вектор, без выделения памяти при повторных проверках
+    void checkStrength(const std::vector<double> &displacements,
+                       std::vector<StrengthCheck> &checks) const;
+    static void sortByUtilization(std::vector<StrengthCheck> &checks);
+    static std::vector<StrengthCheck> filterOverloaded(const std::vector<StrengthCheck> &checks,
+                                                       double threshold = 1.0);
+
+    // Анализ чувствительности по результатам последнего calculate() с той же факторизацией.
+    // Сопряженный метод: производные одной величины по параметру всех стержней, O(n).
+    std::vector<double> sensitivityRow(Response response, int index, Parameter parameter) const;
+    // Производные взвешенной суммы усилий sum w_p N_p (weights - по getRodCount() значений)
+    // по параметру всех стержней за одно сопряженное решение
+    std::vector<double> sensitivityWeighted(const std::vector<double> &weights,
+                                            Parameter parameter) const;
+    // Прямой метод: полный якобиан [номер величины][номер стержня], O(n) на каждый стержень
+    std::vector<std::vector<double>> sensitivityJacobian(Response response,
+                                                         Parameter parameter) const;
+
+    // Оценка обусловленности требует нескольких дополнительных решений;
+    // при массовых расчетах (Монте-Карло) ее можно отключить
+    void setDiagnostics(bool enabled) { diagnostics = enabled; }
+
+    // Системы от threshold узлов в прямом режиме решаются ParallelTridiagonalSolver на
+    // threads потоках (0 - по числу ядер); на одном потоке всегда TridiagonalSolver
+    void setParallelThreshold(int threshold) { parallelThreshold = threshold; }
+    void setThreads(int threads) { workspace.parallelSolver.setThreads(threads); }
+    const SolveReport &getSolveReport() const { return report; }
+    const SolveTimings &getTimings() const { return timings; }
+    // Реакции в узлах после calculate() (0 в свободных узлах); solve() забирает их в Solution
+    const std::vector<double> &getReactions() const { return reactions; }
+
+    // Сколько раз пришлось увеличивать буферы рабочей области (не растет при повторных
+    // расчетах). Это не число всех выделений памяти в куче: их проверяет test_allocations
+    long long getAllocationCount() const { return workspace.allocations(); }
+
+    // Геттеры для получения данных о стержнях
+    int getNodeCount() const { return n; }
+    int getRodCount() const { return n - 1; }
+    double getRodLength(int index) const {
+        return (index >= 0 && index < getRodCount()) ? rods.L[index] : 0.0;
+    }
+    double getRodArea(int index) const {
+        return (index >= 0 && index < getRodCount()) ? rods.A[index] : 0.0;
+    }
+    double getRodElasticModulus(int index) const {
+        return (index >= 0 && index < getRodCount()) ? rods.E[index] : 0.0;
+    }
+    double getRodDistributedLoad(int index) const {
+        return (index >= 0 && index < getRodCount()) ? rods.q[index] : 0.0;
+    }
+    double getRodAllowedStress(int index) const {
+        return (index >= 0 && index < getRodCount()) ? rods.sigma_allow[index] : 0.0;
+    }
+    double getRodDensity(int index) const {
+        return (index >= 0 && index < getRodCount()) ? rods.rho[index] : 0.0;
+    }
+    double getNodeForce(int index) const {
+        return (index >= 0 && index < n) ? F[index] : 0.0;
+    }
+
+private:
+    SolverMode solverMode = SolverMode::Direct;
+    SolverMode solvedMode = SolverMode::Direct; // Режим, в котором получено разложение
+    bool diagnostics = true;
+    int parallelThreshold = ParallelTridiagonalSolver::defaultThreshold;
+    bool solvedParallel = false; // Последнее разложение - в workspace.parallelSolver
+    SolveReport report;
+    SolveTimings timings;
+    std::vector<double> reactions; // Реакции последнего calculate(), забираются solve()
+
+    // Подконструкции последнего load() и их экземпляры (по возрастанию firstBar);
+    // суперэлементы строятся при первом расчете с конденсацией
+    std::vector<SaprProject::Substructure> substructures;
+    std::vector<SaprProject::Instance> instances;
+    std::vector<Superelement> superelements;
+    std::vector<int> reducedNodes; // Узлы сокращенной системы
+    // Номера материала и сечения каждого стержня по последнему load() (-1 - без ссылки)
+    std::vector<int> rodMaterials;
+    std::vector<int> rodSections;
+    bool condensation = true;
+    bool solvedCondensed = false; // Последний расчет - с конденсацией
+
+    RodView rodView() const;
+
+    // Производные жесткости EA/L, узловой нагрузки qL/2 и явная производная усилия
+    double stiffnessDerivative(int p, Parameter parameter) const;
+    double loadDerivative(int p, Parameter parameter) const;
+    double forceExplicitDerivative(int p, Parameter parameter) const;
+    void zeroAnchored(std::vector<double> &v) const;
+    // Решение сопряженной задачи K lambda = dR/du и добавление lambda^T (dF - dK u) к row
+    void addAdjointTerms(std::vector<double> &lambda, std::vector<double> &row,
+                         Parameter parameter) const;
+    void solveFactored(std::vector<double> &v) const; // Решение с последним разложением
+    void checkEquilibrium(const double *u, bool leftAnchor, bool rightAnchor);
+    // Усилия, напряжения и реакции по найденным перемещениям (жесткости и нагрузки
+    // стержней уже в workspace)
+    void recover(const double *displacements, double *forces, double *stresses,
+                 bool leftAnchor, bool rightAnchor);
+    void calculateCondensed(double *displacements, double *forces, double *stresses,
+                            bool leftAnchor, bool rightAnchor);
+    void dropSubstructures();
+    void requireSolution() const;
+};
+
+#endif // RODSYSTEMCALCULATOR_H
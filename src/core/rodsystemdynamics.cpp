@@ -0,0 +1,257 @@
+#include "rodsystemdynamics.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+static const double PI = 3.14159265358979323846;
+
+RodSystemDynamics::RodSystemDynamics(const RodSystemCalculator &calculator, bool leftAnchor,
+                                     bool rightAnchor, MassMatrix massType)
+    : n(calculator.getNodeCount()) {
+    if (calculator.getRodCount() <= 0) {
+        throw std::runtime_error("Нет стержней для расчета");
+    }
+
+    // Сборка полных трехдиагональных матриц K и M
+    std::vector<double> Kd(n, 0.0), Ko(n - 1, 0.0);
+    std::vector<double> Md(n, 0.0), Mo(n - 1, 0.0);
+    std::vector<double> b(n, 0.0);
+
+    for (int i = 0; i < n; i++) {
+        b[i] = calculator.getNodeForce(i);
+    }
+
+    for (int p = 0; p < n - 1; p++) {
+        double L = calculator.getRodLength(p);
+        double A = calculator.getRodArea(p);
+        double E = calculator.getRodElasticModulus(p);
+        double rho = calculator.getRodDensity(p);
+        double q = calculator.getRodDistributedLoad(p);
+
+        if (rho <= 0) {
+            throw std::runtime_error("Плотность стержня должна быть положительной");
+        }
+
+        double k = E * A / L;
+        double m = rho * A * L;
+
+        Kd[p] += k;
+        Kd[p + 1] += k;
+        Ko[p] -= k;
+
+        if (massType == MassMatrix::Consistent) {
+            Md[p] += m / 3.0;
+            Md[p + 1] += m / 3.0;
+            Mo[p] += m / 6.0;
+            spectrumUpperBound = std::max(spectrumUpperBound, 12.0 * k / m);
+        } else {
+            Md[p] += m / 2.0;
+            Md[p + 1] += m / 2.0;
+            spectrumUpperBound = std::max(spectrumUpperBound, 4.0 * k / m);
+        }
+
+        b[p] += q * L / 2.0;
+        b[p + 1] += q * L / 2.0;
+    }
+
+    // Заделки возможны только на концах, поэтому свободные узлы идут подряд
+    int first = leftAnchor ? 1 : 0;
+    int last = rightAnchor ? n - 2 : n - 1;
+    if (last < first) {
+        throw std::runtime_error("Нет свободных узлов для динамического расчета");
+    }
+
+    for (int i = first; i <= last; i++) {
+        freeDofs.push_back(i);
+        kDiag.push_back(Kd[i]);
+        mDiag.push_back(Md[i]);
+        load.push_back(b[i]);
+        if (i < last) {
+            kOff.push_back(Ko[i]);
+            mOff.push_back(Mo[i]);
+        }
+    }
+}
+
+void RodSystemDynamics::setRayleighDamping(double alpha, double beta) {
+    dampingAlpha = alpha;
+    dampingBeta = beta;
+}
+
+std::vector<double> RodSystemDynamics::expand(const std::vector<double> &reduced) const {
+    std::vector<double> full(n, 0.0);
+    for (size_t i = 0; i < freeDofs.size(); i++) {
+        full[freeDofs[i]] = reduced[i];
+    }
+    return full;
+}
+
+std::vector<RodSystemDynamics::Mode> RodSystemDynamics::computeModes(int k) const {
+    int size = static_cast<int>(freeDofs.size());
+    k = std::min(k, size);
+
+    std::vector<Mode> modes;
+    if (k <= 0) {
+        return modes;
+    }
+
+    double upper = spectrumUpperBound * 1.01;
+    double lower = -1e-8 * upper; // Жесткие смещения (без заделок) дают lambda = 0
+
+    TridiagonalSolver solver;
+    std::vector<double> x(size), y(size), shifted(size), shiftedOff(size > 0 ? size - 1 : 0);
+
+    for (int j = 0; j < k; j++) {
+        // Бисекция: ищем lambda_j, при котором счетчик Штурма переходит j -> j+1
+        double lo = lower;
+        double hi = upper;
+        for (int iter = 0; iter < 200 && hi - lo > 1e-14 * std::max(std::abs(hi), 1.0); iter++) {
+            double mid = 0.5 * (lo + hi);
+            if (TridiagonalSolver::countNegativePivots(kDiag, kOff, mDiag, mOff, mid) > j) {
+                hi = mid;
+            } else {
+                lo = mid;
+            }
+        }
+        double lambda = 0.5 * (lo + hi);
+        lower = lo;
+
+        // Обратные итерации со сдвигом lambda для формы колебаний
+        for (int i = 0; i < size; i++) {
+            shifted[i] = kDiag[i] - lambda * mDiag[i];
+            if (i < size - 1) {
+                shiftedOff[i] = kOff[i] - lambda * mOff[i];
+            }
+        }
+        solver.factor(shifted, shiftedOff, true);
+
+        std::fill(x.begin(), x.end(), 1.0);
+        for (int i = 0; i < size; i++) {
+            x[i] += 0.01 * (i % 7); // Несимметричное начальное приближение
+        }
+
+        for (int iter = 0; iter < 3; iter++) {
+            TridiagonalSolver::multiply(mDiag, mOff, x, y);
+            solver.solve(y);
+
+            // Нормировка по матрице масс: x^T M x = 1
+            TridiagonalSolver::multiply(mDiag, mOff, y, x);
+            double norm = 0.0;
+            for (int i = 0; i < size; i++) {
+                norm += y[i] * x[i];
+            }
+            norm = std::sqrt(norm);
+            for (int i = 0; i < size; i++) {
+                x[i] = y[i] / norm;
+            }
+        }
+
+        double omega = std::sqrt(std::max(lambda, 0.0));
+        modes.push_back({omega, omega / (2.0 * PI), expand(x)});
+    }
+
+    return modes;
+}
+
+void RodSystemDynamics::integrateNewmark(double dt, int steps,
+                                         const std::function<double(double)> &loadFactor,
+                                         std::ostream &out, int outputEvery, double beta,
+                                         double gamma) const {
+    // beta = 0 - деление на нуль в эффективной жесткости, gamma < 1/2 - отрицательное
+    // численное демпфирование; NaN отвергается теми же сравнениями
+    if (!(dt > 0) || steps <= 0 || outputEvery <= 0 || !(beta > 0) || !(gamma >= 0.5)) {
+        throw std::runtime_error("Некорректные параметры интегрирования");
+    }
+
+    int size = static_cast<int>(freeDofs.size());
+
+    // Коэффициенты схемы Ньюмарка
+    double a0 = 1.0 / (beta * dt * dt);
+    double a1 = gamma / (beta * dt);
+    double a2 = 1.0 / (beta * dt);
+    double a3 = 1.0 / (2.0 * beta) - 1.0;
+    double a4 = gamma / beta - 1.0;
+    double a5 = dt / 2.0 * (gamma / beta - 2.0);
+
+    // C = alpha*M + beta*K
+    std::vector<double> cDiag(size), cOff(kOff.size());
+    for (int i = 0; i < size; i++) {
+        cDiag[i] = dampingAlpha * mDiag[i] + dampingBeta * kDiag[i];
+    }
+    for (size_t i = 0; i < kOff.size(); i++) {
+        cOff[i] = dampingAlpha * mOff[i] + dampingBeta * kOff[i];
+    }
+
+    // Эффективная жесткость раскладывается один раз на весь расчет
+    std::vector<double> effDiag(size), effOff(kOff.size());
+    for (int i = 0; i < size; i++) {
+        effDiag[i] = kDiag[i] + a0 * mDiag[i] + a1 * cDiag[i];
+    }
+    for (size_t i = 0; i < kOff.size(); i++) {
+        effOff[i] = kOff[i] + a0 * mOff[i] + a1 * cOff[i];
+    }
+    TridiagonalSolver effective;
+    effective.factor(effDiag, effOff);
+
+    std::vector<double> u(size, 0.0), v(size, 0.0), a(size, 0.0);
+    std::vector<double> rhs(size), tmp(size), work(size), uNext(size);
+
+    // Начальное ускорение: M a0 = F(0) - K u0 - C v0 (u0 = v0 = 0)
+    TridiagonalSolver mass;
+    mass.factor(mDiag, mOff);
+    double f0 = loadFactor(0.0);
+    for (int i = 0; i < size; i++) {
+        a[i] = f0 * load[i];
+    }
+    mass.solve(a);
+
+    auto writeRow = [&](double t) {
+        out << t;
+        int j = 0;
+        for (int i = 0; i < n; i++) {
+            out << ';';
+            if (j < size && freeDofs[j] == i) {
+                out << u[j++];
+            } else {
+                out << 0.0;
+            }
+        }
+        out << '\n';
+    };
+
+    writeRow(0.0);
+
+    for (int step = 1; step <= steps; step++) {
+        double t = step * dt;
+        double f = loadFactor(t);
+
+        // F_eff = F + M(a0 u + a2 v + a3 a) + C(a1 u + a4 v + a5 a)
+        for (int i = 0; i < size; i++) {
+            work[i] = a0 * u[i] + a2 * v[i] + a3 * a[i];
+        }
+        TridiagonalSolver::multiply(mDiag, mOff, work, rhs);
+
+        for (int i = 0; i < size; i++) {
+            work[i] = a1 * u[i] + a4 * v[i] + a5 * a[i];
+        }
+        TridiagonalSolver::multiply(cDiag, cOff, work, tmp);
+
+        for (int i = 0; i < size; i++) {
+            uNext[i] = f * load[i] + rhs[i] + tmp[i];
+        }
+        effective.solve(uNext);
+
+        for (int i = 0; i < size; i++) {
+            double aNext = a0 * (uNext[i] - u[i]) - a2 * v[i] - a3 * a[i];
+            v[i] += dt * ((1.0 - gamma) * a[i] + gamma * aNext);
+            a[i] = aNext;
+            u[i] = uNext[i];
+        }
+
+        if (step % outputEvery == 0) {
+            writeRow(t);
+        }
+    }
+
+    out.flush();
+}
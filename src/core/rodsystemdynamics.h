@@ -0,0 +1,63 @@
+#ifndef RODSYSTEMDYNAMICS_H
+#define RODSYSTEMDYNAMICS_H
+
+#include "rodsystemcalculator.h"
+#include "tridiagonalsolver.h"
+#include <functional>
+#include <ostream>
+#include <vector>
+
+// Динамический расчет стержневой системы: продольные колебания.
+// Матрицы жесткости и масс трехдиагональные, поэтому хранятся только диагонали
+// для незакрепленных узлов.
+class RodSystemDynamics {
+public:
+    enum class MassMatrix {
+        Consistent, // Согласованная матрица масс: rho*A*L/6 * [2 1; 1 2]
+        Lumped      // Сосредоточенная матрица масс: rho*A*L/2 * [1 0; 0 1]
+    };
+
+    struct Mode {
+        double omega;              // Круговая частота, рад/с
+        double frequency;          // Частота, Гц
+        std::vector<double> shape; // Форма колебаний во всех узлах (нормирована по M)
+    };
+
+    RodSystemDynamics(const RodSystemCalculator &calculator, bool leftAnchor, bool rightAnchor,
+                      MassMatrix massType = MassMatrix::Consistent);
+
+    // Рэлеевское демпфирование C = alpha*M + beta*K
+    void setRayleighDamping(double alpha, double beta);
+
+    // Низшие k собственных форм (бисекция по Штурму + обратные итерации)
+    std::vector<Mode> computeModes(int k) const;
+
+    // Интегрирование по Ньюмарку при нагрузке F(t) = loadFactor(t) * F_статическая.
+    // Каждая outputEvery-я строка "t;u1;...;un" сразу пишется в out, история в памяти не хранится.
+    // dt, steps, outputEvery и beta должны быть положительными, gamma >= 0.5,
+    // иначе std::runtime_error.
+    void integrateNewmark(double dt, int steps, const std::function<double(double)> &loadFactor,
+                          std::ostream &out, int outputEvery = 1, double beta = 0.25,
+                          double gamma = 0.5) const;
+
+    int getFreeDofCount() const { return static_cast<int>(freeDofs.size()); }
+
+private:
+    int n; // Количество узлов
+    std::vector<int> freeDofs;
+
+    // Трехдиагональные матрицы для свободных узлов
+    std::vector<double> kDiag, kOff;
+    std::vector<double> mDiag, mOff;
+    std::vector<double> load; // Статическая нагрузка на свободные узлы
+
+    double dampingAlpha = 0.0;
+    double dampingBeta = 0.0;
+
+    // Верхняя граница спектра: максимум по собственным значениям отдельных элементов
+    double spectrumUpperBound = 0.0;
+
+    std::vector<double> expand(const std::vector<double> &reduced) const;
+};
+
+#endif // RODSYSTEMDYNAMICS_H
@@ -0,0 +1,242 @@
+#include "rodsystemoptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+RodSystemOptimizer::RodSystemOptimizer(const RodSystemCalculator &calculator, bool leftAnchor,
+                                       bool rightAnchor)
+    : calculator(calculator), leftAnchor(leftAnchor), rightAnchor(rightAnchor),
+      n(calculator.getNodeCount()) {
+    if (calculator.getRodCount() <= 0) {
+        throw std::runtime_error("Нет стержней для расчета");
+    }
+    if (!leftAnchor && !rightAnchor) {
+        throw std::runtime_error("Система должна иметь хотя бы одну заделку");
+    }
+    if (n == 2 && leftAnchor && rightAnchor) {
+        throw std::runtime_error("Нет свободных узлов для расчета");
+    }
+
+    for (int p = 0; p < n - 1; p++) {
+        if (calculator.getRodAllowedStress(p) <= 0) {
+            throw std::runtime_error("Допустимое напряжение должно быть положительным");
+        }
+        L.push_back(calculator.getRodLength(p));
+        E.push_back(calculator.getRodElasticModulus(p));
+        q.push_back(calculator.getRodDistributedLoad(p));
+        sigma_allow.push_back(calculator.getRodAllowedStress(p));
+        rho.push_back(calculator.getRodDensity(p));
+        A0.push_back(calculator.getRodArea(p));
+    }
+
+    // Промежуточные расчеты не выводятся и не оцениваются
+    this->calculator.setLogging(false);
+    this->calculator.setDiagnostics(false);
+}
+
+void RodSystemOptimizer::solve(const std::vector<double> &areas) {
+    calculator.setRods(L.data(), areas.data(), E.data(), q.data());
+    calculator.calculate(displacements, forces, stresses, leftAnchor, rightAnchor);
+    factorizations++;
+}
+
+double RodSystemOptimizer::mass(const std::vector<double> &areas) const {
+    double m = 0.0;
+    for (size_t p = 0; p < L.size(); p++) {
+        m += rho[p] * areas[p] * L[p];
+    }
+    return m;
+}
+
+double RodSystemOptimizer::startStress(int p, const std::vector<double> &areas) const {
+    // Усилие калькулятора N = EA/L (u_j - u_i) - qL/2 относится к концу стержня,
+    // в начале оно больше на qL
+    return (forces[p] + q[p] * L[p]) / areas[p];
+}
+
+double RodSystemOptimizer::endStress(int p, const std::vector<double> &areas) const {
+    return forces[p] / areas[p];
+}
+
+double RodSystemOptimizer::maxUtilization(const std::vector<double> &areas,
+                                          std::vector<double> *rodUtilization) const {
+    double result = 0.0;
+    for (int p = 0; p < n - 1; p++) {
+        double util = std::max(std::abs(startStress(p, areas)), std::abs(endStress(p, areas))) /
+                      sigma_allow[p];
+        if (rodUtilization) {
+            (*rodUtilization)[p] = util;
+        }
+        result = std::max(result, util);
+    }
+    return result;
+}
+
+double RodSystemOptimizer::penalty(const std::vector<double> &areas,
+                                   std::vector<double> *dPdA) const {
+    // P = sum max(0, (sigma/[sigma])^2 - 1)^2 по обоим концам каждого стержня.
+    // sigma = (N + c) / A, поэтому dP/dA_i = sum_p w_p dN_p/dA_i - [явная часть 1/A],
+    // где w_p = (dP/dsigma0 + dP/dsigmaL) / A_p; первое слагаемое дает калькулятор.
+    double P = 0.0;
+    std::vector<double> weights, explicitPart;
+    if (dPdA) {
+        weights.assign(n - 1, 0.0);
+        explicitPart.assign(n - 1, 0.0);
+    }
+
+    for (int p = 0; p < n - 1; p++) {
+        const double stress[2] = {startStress(p, areas), endStress(p, areas)};
+        for (int e = 0; e < 2; e++) {
+            double ratio = stress[e] / sigma_allow[p];
+            double g = ratio * ratio - 1.0;
+            if (g <= 0.0) {
+                continue;
+            }
+            P += g * g;
+
+            if (dPdA) {
+                double dPds = 4.0 * g * stress[e] / (sigma_allow[p] * sigma_allow[p]);
+                weights[p] += dPds / areas[p];
+                explicitPart[p] -= dPds * stress[e] / areas[p];
+            }
+        }
+    }
+
+    if (dPdA) {
+        *dPdA = calculator.sensitivityWeighted(weights, RodSystemCalculator::Parameter::Area);
+        for (int p = 0; p < n - 1; p++) {
+            (*dPdA)[p] += explicitPart[p];
+        }
+    }
+    return P;
+}
+
+RodSystemOptimizer::Result RodSystemOptimizer::optimize(const Settings &settings) {
+    int rodCount = n - 1;
+    factorizations = 0;
+
+    Result result;
+    std::vector<double> areas(rodCount), util(rodCount);
+    for (int p = 0; p < rodCount; p++) {
+        double initial = A0[p] > 0 ? A0[p] : 1.0;
+        areas[p] = std::clamp(initial, settings.minArea, settings.maxArea);
+    }
+    result.initialMass = mass(areas);
+
+    // Этап 1: равнопрочное проектирование A_new = A * sigma_max / [sigma]
+    for (int iter = 0; iter < settings.fsdIterations; iter++) {
+        solve(areas);
+        maxUtilization(areas, &util);
+        result.fsdIterations++;
+
+        double change = 0.0;
+        for (int p = 0; p < rodCount; p++) {
+            double updated = std::clamp(areas[p] * util[p], settings.minArea, settings.maxArea);
+            change = std::max(change, std::abs(updated - areas[p]) / areas[p]);
+            areas[p] = updated;
+        }
+        if (change < settings.tolerance) {
+            break;
+        }
+    }
+
+    // Равномерное масштабирование сохраняет распределение усилий (напряжения ~ 1/s).
+    // Если часть площадей упирается в границы, распределение меняется, поэтому
+    // масштабирование повторяется по новому расчету до допустимого проекта.
+    // Возвращается true, если проект допустим.
+    auto makeFeasible = [&](std::vector<double> &design) {
+        double utilization = 0.0;
+        for (int pass = 0;; pass++) {
+            solve(design);
+            utilization = maxUtilization(design);
+            bool reached = utilization <= 1.0 && utilization >= 1.0 - settings.tolerance;
+            if (!(utilization > 0) || reached || pass == 50) {
+                break;
+            }
+            bool changed = false;
+            for (double &A : design) {
+                double scaled = std::clamp(A * utilization, settings.minArea, settings.maxArea);
+                changed = changed || scaled != A;
+                A = scaled;
+            }
+            if (!changed) {
+                break; // Все площади на границах
+            }
+        }
+        return utilization <= 1.0 + settings.tolerance;
+    };
+    bool feasible = makeFeasible(areas);
+    std::vector<double> best = areas;
+    double bestMass = mass(best);
+
+    // Этап 2: градиентный спуск по log A с квадратичным штрафом
+    double m0 = bestMass > 0 ? bestMass : 1.0;
+    std::vector<double> dPdA, grad(rodCount), trial(rodCount);
+    int budget = settings.gradientIterations;
+
+    for (double mu = 10.0; mu <= 1e6 && budget > 0; mu *= 10.0) {
+        double step = 1.0;
+
+        solve(areas);
+        double J = mass(areas) / m0 + mu * penalty(areas, &dPdA);
+
+        while (budget-- > 0) {
+            result.gradientIterations++;
+
+            // dJ/dA_i = rho_i L_i / m0 + mu * dP/dA_i
+            for (int p = 0; p < rodCount; p++) {
+                double dJ = rho[p] * L[p] / m0 + mu * dPdA[p];
+                grad[p] = areas[p] * dJ; // Градиент по log A
+            }
+
+            // Поиск шага с условием Армихо
+            bool accepted = false;
+            double Jtrial = J;
+            for (int attempt = 0; attempt < 30; attempt++) {
+                double decrease = 0.0;
+                for (int p = 0; p < rodCount; p++) {
+                    trial[p] = std::clamp(areas[p] * std::exp(-step * grad[p]), settings.minArea,
+                                          settings.maxArea);
+                    decrease += grad[p] * std::log(areas[p] / trial[p]);
+                }
+                solve(trial);
+                Jtrial = mass(trial) / m0 + mu * penalty(trial, nullptr);
+                if (Jtrial <= J - 1e-4 * decrease) {
+                    accepted = true;
+                    break;
+                }
+                step *= 0.5;
+            }
+            if (!accepted) {
+                break;
+            }
+
+            double relative = std::abs(J - Jtrial) / std::max(std::abs(J), 1e-300);
+            areas = trial;
+            // Последнее разложение соответствует новым площадям
+            J = mass(areas) / m0 + mu * penalty(areas, &dPdA);
+            step = std::min(step * 2.0, 1e3);
+
+            if (relative < settings.tolerance) {
+                break;
+            }
+        }
+
+        std::vector<double> candidate = areas;
+        if (makeFeasible(candidate)) {
+            double candidateMass = mass(candidate);
+            if (!feasible || candidateMass < bestMass) {
+                best = candidate;
+                bestMass = candidateMass;
+                feasible = true;
+            }
+        }
+    }
+
+    solve(best);
+    result.areas = best;
+    result.mass = bestMass;
+    result.maxUtilization = maxUtilization(best);
+    result.factorizations = factorizations;
+    return result;
+}
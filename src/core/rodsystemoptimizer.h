@@ -0,0 +1,57 @@
+#ifndef RODSYSTEMOPTIMIZER_H
+#define RODSYSTEMOPTIMIZER_H
+
+#include "rodsystemcalculator.h"
+#include <vector>
+
+// Подбор площадей сечений минимальной массы при ограничениях по допускаемым напряжениям.
+// Сначала выполняются итерации равнопрочного проектирования, затем градиентный спуск
+// со штрафом. Расчеты выполняет копия исходного RodSystemCalculator (те же сборка,
+// масштабирование, проверка ведущих элементов и выбор решателя), градиент штрафа -
+// его сопряженный анализ чувствительности (sensitivityWeighted): на итерацию
+// приходится одно разложение матрицы жесткости и одно дополнительное решение с ним.
+class RodSystemOptimizer {
+public:
+    struct Settings {
+        double minArea = 1e-8;         // Нижняя граница площади
+        double maxArea = 1e6;          // Верхняя граница площади
+        int fsdIterations = 100;       // Итерации равнопрочного проектирования
+        int gradientIterations = 3000; // Итерации градиентного метода (суммарно)
+        double tolerance = 1e-6;       // Относительная точность
+    };
+
+    struct Result {
+        std::vector<double> areas;   // Оптимальные площади стержней
+        double mass = 0.0;           // Масса конструкции
+        double initialMass = 0.0;    // Масса исходной конструкции
+        double maxUtilization = 0.0; // Максимальный коэффициент использования
+        int fsdIterations = 0;
+        int gradientIterations = 0;
+        int factorizations = 0; // Количество разложений матрицы жесткости
+    };
+
+    RodSystemOptimizer(const RodSystemCalculator &calculator, bool leftAnchor, bool rightAnchor);
+
+    Result optimize() { return optimize(Settings()); }
+    Result optimize(const Settings &settings);
+
+private:
+    RodSystemCalculator calculator; // Копия исходного калькулятора; площади меняются в ней
+    bool leftAnchor, rightAnchor;
+    int n; // Количество узлов
+    std::vector<double> L, E, q, sigma_allow, rho, A0;
+    std::vector<double> displacements, forces, stresses; // Результаты последнего расчета
+    int factorizations = 0;
+
+    void solve(const std::vector<double> &areas);
+    double mass(const std::vector<double> &areas) const;
+    // Напряжения в начале и в конце стержня p по усилию последнего расчета
+    double startStress(int p, const std::vector<double> &areas) const;
+    double endStress(int p, const std::vector<double> &areas) const;
+    double maxUtilization(const std::vector<double> &areas,
+                          std::vector<double> *rodUtilization = nullptr) const;
+    // Штраф и, если dPdA не nullptr, его производные по площадям всех стержней
+    double penalty(const std::vector<double> &areas, std::vector<double> *dPdA) const;
+};
+
+#endif // RODSYSTEMOPTIMIZER_H
@@ -0,0 +1,314 @@
+#include "rodsystemstochastic.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+P2Quantile::P2Quantile(double probability) : p(probability) {
+    for (int i = 0; i < 5; i++) {
+        heights[i] = 0.0;
+        positions[i] = i + 1;
+    }
+    desired[0] = 1.0;
+    desired[1] = 1.0 + 2.0 * p;
+    desired[2] = 1.0 + 4.0 * p;
+    desired[3] = 3.0 + 2.0 * p;
+    desired[4] = 5.0;
+    increments[0] = 0.0;
+    increments[1] = p / 2.0;
+    increments[2] = p;
+    increments[3] = (1.0 + p) / 2.0;
+    increments[4] = 1.0;
+}
+
+void P2Quantile::add(double x) {
+    // Первые пять наблюдений запоминаются как есть
+    if (count < 5) {
+        heights[count++] = x;
+        if (count == 5) {
+            std::sort(heights, heights + 5);
+        }
+        return;
+    }
+    count++;
+
+    int k;
+    if (x < heights[0]) {
+        heights[0] = x;
+        k = 0;
+    } else if (x >= heights[4]) {
+        heights[4] = x;
+        k = 3;
+    } else {
+        k = 0;
+        while (k < 3 && x >= heights[k + 1]) {
+            k++;
+        }
+    }
+
+    for (int i = k + 1; i < 5; i++) {
+        positions[i] += 1.0;
+    }
+    for (int i = 0; i < 5; i++) {
+        desired[i] += increments[i];
+    }
+
+    // Коррекция средних маркеров параболической (или линейной) интерполяцией
+    for (int i = 1; i < 4; i++) {
+        double d = desired[i] - positions[i];
+        if ((d >= 1.0 && positions[i + 1] - positions[i] > 1.0) ||
+            (d <= -1.0 && positions[i - 1] - positions[i] < -1.0)) {
+            int ds = d > 0 ? 1 : -1;
+            double parabolic =
+                heights[i] +
+                ds / (positions[i + 1] - positions[i - 1]) *
+                    ((positions[i] - positions[i - 1] + ds) * (heights[i + 1] - heights[i]) /
+                         (positions[i + 1] - positions[i]) +
+                     (positions[i + 1] - positions[i] - ds) * (heights[i] - heights[i - 1]) /
+                         (positions[i] - positions[i - 1]));
+
+            if (heights[i - 1] < parabolic && parabolic < heights[i + 1]) {
+                heights[i] = parabolic;
+            } else {
+                heights[i] += ds * (heights[i + ds] - heights[i]) /
+                              (positions[i + ds] - positions[i]);
+            }
+            positions[i] += ds;
+        }
+    }
+}
+
+double P2Quantile::value() const {
+    if (count == 0) {
+        return 0.0;
+    }
+    if (count < 5) {
+        // Не больше четырех значений: сортировка вставками
+        std::array<double, 4> sorted;
+        int size = std::min(count, 4);
+        for (int i = 0; i < size; i++) {
+            int j = i;
+            for (; j > 0 && sorted[j - 1] > heights[i]; j--) {
+                sorted[j] = sorted[j - 1];
+            }
+            sorted[j] = heights[i];
+        }
+        int index = static_cast<int>(std::round(p * (size - 1)));
+        return sorted[index];
+    }
+    return heights[2];
+}
+
+void OnlineStatistics::add(double x) {
+    n++;
+    if (n == 1) {
+        minimum = maximum = x;
+    } else {
+        minimum = std::min(minimum, x);
+        maximum = std::max(maximum, x);
+    }
+
+    double delta = x - m;
+    m += delta / n;
+    m2 += delta * (x - m);
+
+    q05.add(x);
+    q50.add(x);
+    q95.add(x);
+}
+
+double OnlineStatistics::stddev() const { return std::sqrt(variance()); }
+
+RodSystemMonteCarlo::RodSystemMonteCarlo(const RodSystemCalculator &nominal, bool leftAnchor,
+                                         bool rightAnchor)
+    : n(nominal.getNodeCount()), leftAnchor(leftAnchor), rightAnchor(rightAnchor) {
+    if (nominal.getRodCount() <= 0) {
+        throw std::runtime_error("Нет стержней для расчета");
+    }
+
+    for (int p = 0; p < n - 1; p++) {
+        rods.push_back({nominal.getRodLength(p), nominal.getRodArea(p),
+                        nominal.getRodElasticModulus(p), nominal.getRodDistributedLoad(p),
+                        nominal.getRodAllowedStress(p)});
+    }
+    for (int i = 0; i < n; i++) {
+        forces.push_back(nominal.getNodeForce(i));
+    }
+}
+
+namespace {
+
+double sample(std::mt19937_64 &rng, const RodSystemMonteCarlo::Scatter &scatter, double nominal,
+              bool positive) {
+    using Distribution = RodSystemMonteCarlo::Distribution;
+    if (scatter.type == Distribution::Fixed || scatter.cov <= 0.0 || nominal == 0.0) {
+        return nominal;
+    }
+
+    switch (scatter.type) {
+    case Distribution::LogNormal: {
+        // Параметры логнормального распределения по среднему и коэффициенту вариации
+        double s2 = std::log(1.0 + scatter.cov * scatter.cov);
+        std::normal_distribution<double> normal(-0.5 * s2, std::sqrt(s2));
+        return nominal * std::exp(normal(rng));
+    }
+    case Distribution::Uniform: {
+        double half = std::sqrt(3.0) * scatter.cov;
+        std::uniform_real_distribution<double> uniform(1.0 - half, 1.0 + half);
+        return nominal * uniform(rng);
+    }
+    default: {
+        std::normal_distribution<double> normal(1.0, scatter.cov);
+        double value = nominal * normal(rng);
+        // Положительные величины (E, A, L) не могут стать нулевыми или отрицательными
+        for (int attempt = 0; positive && value <= 0.0 && attempt < 100; attempt++) {
+            value = nominal * normal(rng);
+        }
+        return value;
+    }
+    }
+}
+
+} // namespace
+
+RodSystemMonteCarlo::Result RodSystemMonteCarlo::run(const Settings &settings) const {
+    const long long blockSize = 256;
+    int rodCount = n - 1;
+    long long blocks = (settings.samples + blockSize - 1) / blockSize;
+
+    int threadCount = settings.threads > 0 ? settings.threads
+                                           : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = static_cast<int>(std::max(1LL, std::min<long long>(threadCount, blocks)));
+
+    Result result;
+    result.displacements.resize(n);
+    result.stresses.resize(rodCount);
+    result.utilization.resize(rodCount);
+    std::vector<long long> rodFailures(rodCount, 0);
+    long long systemFailures = 0;
+
+    // Блоки сливаются с накопителями строго по возрастанию номера: квантили P^2 и суммы
+    // Уэлфорда зависят от порядка наблюдений, поэтому иначе результат менялся бы от запуска
+    // к запуску. Поток с готовым блоком ждет своей очереди, памяти нужно по блоку на поток.
+    std::mutex mutex;
+    std::condition_variable merged;
+    long long nextMerge = 0;
+    std::atomic<long long> nextBlock{0};
+
+    auto worker = [&]() {
+        // Собственный калькулятор и буферы потока используются повторно для всех выборок.
+        // Параллельность - по выборкам, поэтому решатель калькулятора однопоточный
+        RodSystemCalculator calculator(n);
+        calculator.setLogging(false);
+        calculator.setDiagnostics(false);
+        calculator.setThreads(1);
+        std::vector<double> displacements, rodForces, stresses;
+        std::vector<RodSystemCalculator::StrengthCheck> checks;
+
+        // Буфер блока: перемещения, max |sigma| и коэффициенты использования
+        int stride = n + 2 * rodCount;
+        std::vector<double> buffer(blockSize * stride);
+        std::vector<char> solved(blockSize);
+        long long localFailed = 0;
+
+        for (long long block = nextBlock++; block < blocks; block = nextBlock++) {
+            // Генератор зависит только от номера блока, а блоки сливаются по порядку:
+            // результат не зависит от числа потоков
+            std::seed_seq seq{static_cast<std::uint32_t>(settings.seed),
+                              static_cast<std::uint32_t>(settings.seed >> 32),
+                              static_cast<std::uint32_t>(block),
+                              static_cast<std::uint32_t>(block >> 32)};
+            std::mt19937_64 rng(seq);
+
+            long long begin = block * blockSize;
+            long long count = std::min(blockSize, settings.samples - begin);
+
+            for (long long s = 0; s < count; s++) {
+                for (int p = 0; p < rodCount; p++) {
+                    const RodData &rod = rods[p];
+                    calculator.setRod(p + 1, sample(rng, settings.length, rod.L, true),
+                                      sample(rng, settings.area, rod.A, true),
+                                      sample(rng, settings.elasticModulus, rod.E, true),
+                                      sample(rng, settings.distributedLoad, rod.q, false),
+                                      rod.sigma_allow);
+                }
+                for (int i = 0; i < n; i++) {
+                    calculator.setForce(i + 1, sample(rng, settings.nodeForce, forces[i], false));
+                }
+
+                double *row = &buffer[s * stride];
+                try {
+                    calculator.calculate(displacements, rodForces, stresses, leftAnchor,
+                                         rightAnchor);
+                    calculator.checkStrength(displacements, checks);
+
+                    std::copy(displacements.begin(), displacements.end(), row);
+                    for (int p = 0; p < rodCount; p++) {
+                        row[n + p] = checks[p].maxStress;
+                        row[n + rodCount + p] = checks[p].utilization;
+                    }
+                    solved[s] = 1;
+                } catch (const std::exception &) {
+                    solved[s] = 0;
+                    localFailed++;
+                }
+            }
+
+            // Слияние блока с общими накопителями в порядке номеров блоков
+            std::unique_lock<std::mutex> lock(mutex);
+            merged.wait(lock, [&]() { return nextMerge == block; });
+            for (long long s = 0; s < count; s++) {
+                if (!solved[s]) {
+                    continue;
+                }
+                const double *row = &buffer[s * stride];
+                bool anyFailure = false;
+                for (int i = 0; i < n; i++) {
+                    result.displacements[i].add(row[i]);
+                }
+                for (int p = 0; p < rodCount; p++) {
+                    result.stresses[p].add(row[n + p]);
+                    result.utilization[p].add(row[n + rodCount + p]);
+                    if (row[n + rodCount + p] > 1.0) {
+                        rodFailures[p]++;
+                        anyFailure = true;
+                    }
+                }
+                if (anyFailure) {
+                    systemFailures++;
+                }
+                result.samples++;
+            }
+            nextMerge++;
+            lock.unlock();
+            merged.notify_all();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        result.failedSolves += localFailed;
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threadCount; t++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    result.failureProbability.resize(rodCount, 0.0);
+    if (result.samples > 0) {
+        for (int p = 0; p < rodCount; p++) {
+            result.failureProbability[p] = static_cast<double>(rodFailures[p]) / result.samples;
+        }
+        result.systemFailureProbability = static_cast<double>(systemFailures) / result.samples;
+    }
+
+    return result;
+}
@@ -0,0 +1,106 @@
+#ifndef RODSYSTEMSTOCHASTIC_H
+#define RODSYSTEMSTOCHASTIC_H
+
+#include "rodsystemcalculator.h"
+#include <cstdint>
+#include <vector>
+
+// Оценка квантиля без хранения выборки (алгоритм P^2, Jain & Chlamtac)
+class P2Quantile {
+private:
+    double p;
+    int count = 0;
+    double heights[5];
+    double positions[5];
+    double desired[5];
+    double increments[5];
+
+public:
+    explicit P2Quantile(double probability = 0.5);
+    void add(double x);
+    double value() const;
+};
+
+// Накопитель статистики за один проход: среднее и дисперсия (Уэлфорд),
+// экстремумы и квантили 5%, 50%, 95%. Память не зависит от числа наблюдений.
+class OnlineStatistics {
+private:
+    long long n = 0;
+    double m = 0.0;
+    double m2 = 0.0;
+    double minimum = 0.0;
+    double maximum = 0.0;
+    P2Quantile q05{0.05};
+    P2Quantile q50{0.50};
+    P2Quantile q95{0.95};
+
+public:
+    void add(double x);
+
+    long long count() const { return n; }
+    double mean() const { return m; }
+    double variance() const { return n > 1 ? m2 / (n - 1) : 0.0; }
+    double stddev() const;
+    double min() const { return minimum; }
+    double max() const { return maximum; }
+    double quantile05() const { return q05.value(); }
+    double median() const { return q50.value(); }
+    double quantile95() const { return q95.value(); }
+};
+
+// Вероятностный расчет методом Монте-Карло: свойства стержней и нагрузки случайны,
+// выборки решаются параллельно, каждый поток использует собственный калькулятор.
+// При одном зерне результат одинаков при любом числе потоков.
+class RodSystemMonteCarlo {
+public:
+    enum class Distribution {
+        Fixed,     // Без разброса
+        Normal,    // Нормальное с заданным коэффициентом вариации
+        LogNormal, // Логнормальное с заданным коэффициентом вариации
+        Uniform    // Равномерное на [x(1 - sqrt(3) v), x(1 + sqrt(3) v)]
+    };
+
+    // Разброс величины относительно номинального значения
+    struct Scatter {
+        Distribution type = Distribution::Fixed;
+        double cov = 0.0; // Коэффициент вариации
+    };
+
+    struct Settings {
+        long long samples = 10000;
+        int threads = 0; // 0 - по числу ядер
+        std::uint64_t seed = 12345;
+        Scatter area = {Distribution::LogNormal, 0.03};
+        Scatter elasticModulus = {Distribution::LogNormal, 0.05};
+        Scatter length = {Distribution::Fixed, 0.0};
+        Scatter distributedLoad = {Distribution::Normal, 0.10};
+        Scatter nodeForce = {Distribution::Normal, 0.10};
+    };
+
+    struct Result {
+        std::vector<OnlineStatistics> displacements; // По узлам
+        std::vector<OnlineStatistics> stresses;      // max |sigma| по стержням
+        std::vector<OnlineStatistics> utilization;   // Коэффициент использования по стержням
+        std::vector<double> failureProbability;      // P(max |sigma| > [sigma]) по стержням
+        double systemFailureProbability = 0.0;       // P(превышение хотя бы в одном стержне)
+        long long samples = 0;
+        long long failedSolves = 0; // Выборки с вырожденной системой
+    };
+
+    RodSystemMonteCarlo(const RodSystemCalculator &nominal, bool leftAnchor, bool rightAnchor);
+
+    Result run(const Settings &settings) const;
+
+private:
+    struct RodData {
+        double L, A, E, q, sigma_allow;
+    };
+
+    int n;
+    bool leftAnchor;
+    bool rightAnchor;
+    std::vector<RodData> rods;
+    std::vector<double> forces;
+};
+
+#endif // RODSYSTEMSTOCHASTIC_H
@@ -0,0 +1,63 @@
+#ifndef SAPRPROJECT_H
+#define SAPRPROJECT_H
+
+#include <string>
+#include <vector>
+
+// Расчетные данные проекта .sapr (без настроек отображения)
+struct SaprProject {
+    struct Bar {
+        double L = 0.0;             // Длина
+        double A = 0.0;             // Площадь поперечного сечения
+        double E = 0.0;             // Модуль упругости
+        double sigma_allow = 200e6; // Допустимое напряжение
+        double rho = 7850.0;        // Плотность
+        int material = -1;          // Номер материала библиотеки или -1
+        int section = -1;           // Номер сечения библиотеки или -1
+    };
+
+    // Библиотека проекта: материалы и сечения описываются один раз, стержни ссылаются
+    // на них по номеру. Значения стержня, ссылающегося на материал (E, sigma_allow, rho)
+    // или сечение (A), совпадают со значениями библиотеки, поэтому расчет читает
+    // стержни без обращения к ней; изменения вносит MaterialLibrary.
+    struct Material {
+        std::string name;
+        double E = 0.0;
+        double sigma_allow = 200e6;
+        double rho = 7850.0;
+    };
+    struct Section {
+        std::string name;
+        double A = 0.0;
+    };
+
+    // Подконструкция - цепочка стержней, описанная один раз и повторяемая в проекте
+    struct Substructure {
+        std::vector<Bar> bars;
+        std::vector<double> barForces;      // Распределенные нагрузки, bars.size() значений
+        std::vector<double> interiorForces; // Силы во внутренних узлах, bars.size() - 1 значений
+    };
+
+    // Экземпляр подконструкции: стержни firstBar .. firstBar + bars.size() - 1 (с 0)
+    struct Instance {
+        int substructure = 0;
+        int firstBar = 0;
+    };
+
+    bool leftAnchor = false;
+    bool rightAnchor = false;
+    std::vector<Bar> bars;
+    std::vector<double> nodeForces; // Сосредоточенные силы, bars.size() + 1 значений
+    std::vector<double> barForces;  // Распределенные нагрузки, bars.size() значений
+
+    // Стержни и силы экземпляров развернуты в bars, nodeForces и barForces, поэтому код,
+    // не знающий о подконструкциях, видит обычную цепочку. Экземпляры упорядочены
+    // по firstBar и не перекрываются.
+    std::vector<Substructure> substructures;
+    std::vector<Instance> instances;
+
+    std::vector<Material> materials;
+    std::vector<Section> sections;
+};
+
+#endif // SAPRPROJECT_H
@@ -0,0 +1,23 @@
+#ifndef SCALARTRAITS_H
+#define SCALARTRAITS_H
+
+#include <type_traits>
+
+// Свойства скалярного типа для обобщенного расчета (BasicRodSystem): вещественная часть,
+// по которой проверяются ведущие элементы и подбирается масштаб, и порог вырожденности.
+// Для float, double и long double вещественная часть - само число; типы с производными
+// (Dual) специализируют шаблон.
+template <class Scalar> struct ScalarTraits {
+    static_assert(std::is_floating_point<Scalar>::value,
+                  "ScalarTraits нужно специализировать для нестандартного скаляра");
+    using Real = Scalar;
+
+    static Real real(const Scalar &x) { return x; }
+
+    // Ведущий элемент считается нулевым, если после исключения он меньше этой доли
+    // суммы модулей слагаемых; для float порог соответствует его точности
+    static constexpr Real singularTolerance =
+        std::is_same<Scalar, float>::value ? Real(1e-5) : Real(1e-14);
+};
+
+#endif // SCALARTRAITS_H
@@ -0,0 +1,119 @@
+#include "solution.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+double Solution::forceAt(int rod, double x) const {
+    double t = lengths[rod] > 0 ? x / lengths[rod] : 0.0;
+    return startForces[rod] + (forces[rod] - startForces[rod]) * t;
+}
+
+double Solution::stressAt(int rod, double x) const {
+    double t = lengths[rod] > 0 ? x / lengths[rod] : 0.0;
+    return startStresses[rod] + (endStresses[rod] - startStresses[rod]) * t;
+}
+
+double Solution::displacementAt(int rod, double x) const {
+    double t = lengths[rod] > 0 ? x / lengths[rod] : 0.0;
+    double ui = displacements[rod];
+    double uj = displacements[rod + 1];
+    return ui + (uj - ui) * t + bulge[rod] * x * (lengths[rod] - x);
+}
+
+double Solution::maxDisplacement() const {
+    double result = 0.0;
+    for (double u : displacements) {
+        result = std::max(result, std::abs(u));
+    }
+    return result;
+}
+
+double Solution::maxStress() const {
+    double result = 0.0;
+    for (const StrengthCheck &check : strength) {
+        result = std::max(result, check.maxStress);
+    }
+    return result;
+}
+
+double Solution::maxUtilization() const {
+    double result = 0.0;
+    for (const StrengthCheck &check : strength) {
+        result = std::max(result, check.utilization);
+    }
+    return result;
+}
+
+void Solution::completeSections(const RodView &rods) {
+    int count = rods.count;
+
+    coordinates.resize(count + 1);
+    coordinates[0] = 0.0;
+    for (int p = 0; p < count; p++) {
+        coordinates[p + 1] = coordinates[p] + rods.L[p];
+    }
+
+    lengths.assign(rods.L, rods.L + count);
+    startForces.resize(count);
+    startStresses.resize(count);
+    endStresses.resize(count);
+    bulge.resize(count);
+    for (int p = 0; p < count; p++) {
+        // N(0) = N(L) + qL
+        startForces[p] = forces[p] + rods.q[p] * rods.L[p];
+        startStresses[p] = startForces[p] / rods.A[p];
+        endStresses[p] = forces[p] / rods.A[p];
+        bulge[p] = rods.q[p] / (2.0 * rods.E[p] * rods.A[p]);
+    }
+
+    strength = checkStrength(rods, displacements);
+}
+
+std::vector<StrengthCheck> Solution::checkStrength(const RodView &rods,
+                                                   const std::vector<double> &displacements) {
+    std::vector<StrengthCheck> checks;
+    checkStrength(rods, displacements, checks);
+    return checks;
+}
+
+void Solution::checkStrength(const RodView &rods, const std::vector<double> &displacements,
+                             std::vector<StrengthCheck> &checks) {
+    checks.clear();
+    checks.reserve(rods.count);
+
+    double start = 0.0;
+    for (int p = 0; p < rods.count; p++) {
+        double L = rods.L[p];
+        double A = rods.A[p];
+        double q = rods.q[p];
+        double sigma_allow = rods.sigma_allow[p];
+        double delta_U = displacements[p + 1] - displacements[p];
+
+        // N(x) = (EA/L) * (u_j - u_i) + q * (L/2 - x)
+        double N0 = (rods.E[p] * A / L) * delta_U + q * L / 2.0;
+        double NL = N0 - q * L;
+
+        StrengthCheck check;
+        check.rod = p;
+        check.allowedStress = sigma_allow;
+        if (std::abs(N0) >= std::abs(NL)) {
+            check.maxStress = std::abs(N0) / A;
+            check.criticalX = 0.0;
+        } else {
+            check.maxStress = std::abs(NL) / A;
+            check.criticalX = L;
+        }
+        check.criticalCoordinate = start + check.criticalX;
+
+        if (sigma_allow > 0) {
+            check.utilization = check.maxStress / sigma_allow;
+        } else {
+            check.utilization = check.maxStress > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+        }
+        check.reserveFactor = check.maxStress > 0 ? sigma_allow / check.maxStress
+                                                  : std::numeric_limits<double>::infinity();
+
+        checks.push_back(check);
+        start += L;
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef SOLUTION_H
+#define SOLUTION_H
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Результат проверки прочности одного стержня
+struct StrengthCheck {
+    int rod;                   // Номер стержня (с 0)
+    double maxStress;          // max |sigma(x)| по длине стержня
+    double allowedStress;      // Допустимое напряжение стержня
+    double utilization;        // Коэффициент использования maxStress / allowedStress
+    double reserveFactor;      // Коэффициент запаса allowedStress / maxStress
+    double criticalX;          // Положение опасного сечения от начала стержня
+    double criticalCoordinate; // Положение опасного сечения в глобальной системе
+};
+
+// Диагностика решения системы уравнений
+struct SolveDiagnostics {
+    bool mixedPrecision = false;      // Расчет в режиме смешанной точности
+    bool floatFactorization = false;  // Разложение во float (только при mixedPrecision)
+    double conditionEstimate = 0.0;   // Оценка числа обусловленности S K S в норме 1
+    double minPivotRatio = 0.0;       // Минимальная доля ведущего элемента после исключения
+    int refinementSteps = 0;          // Шаги итерационного уточнения
+    double backwardError = 0.0;       // Обратная ошибка после уточнения
+    double equilibriumResidual = 0.0; // max относительной невязки равновесия узлов
+    int worstNode = -1;               // Узел с наибольшей невязкой (с 0)
+    double globalResidual = 0.0;      // |sum R + sum F + sum qL|, отнесенная к сумме модулей
+};
+
+// Продолжительность этапов расчета, мс
+struct SolveTimings {
+    double assembly = 0.0;      // Жесткости, нагрузки, сборка и граничные условия
+    double factorization = 0.0; // Разложение, решение и диагностика
+    double recovery = 0.0;      // Усилия, напряжения, реакции, сечения и прочность
+    double total = 0.0;
+};
+
+// Ошибка расчета: код причины для программной обработки и текст для пользователя
+class CalculationError : public std::runtime_error {
+public:
+    enum class Code {
+        NoRods,       // Нет стержней
+        InvalidInput, // Некорректные исходные данные или аргументы
+        Singular,     // Система уравнений вырождена
+        NoSolution    // Операция требует выполненного расчета
+    };
+
+    CalculationError(Code code, const std::string &message)
+        : std::runtime_error(message), errorCode(code) {}
+    Code code() const noexcept { return errorCode; }
+
+private:
+    Code errorCode;
+};
+
+// Свойства стержней в виде массивов по столбцам (указатели на данные владельца)
+struct RodView {
+    int count = 0;
+    const double *L = nullptr;           // Длины
+    const double *A = nullptr;           // Площади
+    const double *E = nullptr;           // Модули упругости
+    const double *q = nullptr;           // Распределенные нагрузки
+    const double *sigma_allow = nullptr; // Допустимые напряжения
+};
+
+// Полный результат статического расчета. Создается калькулятором и передается
+// (перемещается) в интерфейс, экспорт и пакетные инструменты без пересчета.
+struct Solution {
+    bool leftAnchor = false;
+    bool rightAnchor = false;
+
+    // По узлам
+    std::vector<double> coordinates;   // Координаты узлов
+    std::vector<double> displacements; // Перемещения
+    std::vector<double> nodalStresses; // Напряжения (среднее соседних стержней)
+    std::vector<double> reactions;     // Реакции опор (0 в свободных узлах)
+
+    // По стержням
+    std::vector<double> lengths;
+    std::vector<double> startForces;   // N(0)
+    std::vector<double> forces;        // N(L)
+    std::vector<double> startStresses; // sigma(0)
+    std::vector<double> endStresses;   // sigma(L)
+    std::vector<double> bulge;         // q / (2EA): u(x) = u_i + x/L du + bulge x (L - x)
+    std::vector<StrengthCheck> strength;
+
+    SolveDiagnostics diagnostics;
+    SolveTimings timings;
+
+    int nodeCount() const { return static_cast<int>(displacements.size()); }
+    int rodCount() const { return static_cast<int>(forces.size()); }
+
+    // Значения в сечении x (от начала стержня, 0 <= x <= L)
+    double forceAt(int rod, double x) const;
+    double stressAt(int rod, double x) const;
+    double displacementAt(int rod, double x) const;
+
+    double maxDisplacement() const; // max |u|
+    double maxStress() const;       // max |sigma(x)| по всем стержням
+    double maxUtilization() const;  // max коэффициента использования
+
+    // Заполнение координат, сечений и проверки прочности по уже найденным
+    // перемещениям и усилиям N(L)
+    void completeSections(const RodView &rods);
+
+    // Проверка прочности по перемещениям; N(x) линейна по x,
+    // поэтому максимум |sigma| достигается на одном из концов стержня
+    static std::vector<StrengthCheck> checkStrength(const RodView &rods,
+                                                    const std::vector<double> &displacements);
+    // То же в готовый вектор: при достаточной емкости память не выделяется
+    static void checkStrength(const RodView &rods, const std::vector<double> &displacements,
+                              std::vector<StrengthCheck> &checks);
+};
+
+#endif // SOLUTION_H
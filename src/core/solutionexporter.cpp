@@ -0,0 +1,301 @@
+#include "solutionexporter.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <locale>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Сечение s из samples на стержне длиной L
+double sampleX(double L, int s, int samples) { return L * s / (samples - 1); }
+
+// Числа в JSON: бесконечный коэффициент использования (нулевое допустимое) пишется как null
+void writeJsonNumber(std::ostream &out, double value) {
+    if (std::isfinite(value)) {
+        out << value;
+    } else {
+        out << "null";
+    }
+}
+
+// Буферизованная запись чисел little-endian независимо от порядка байт процессора
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::ostream &out) : out(out) {}
+    ~BinaryWriter() { flush(); }
+
+    void bytes(const char *data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            put(static_cast<unsigned char>(data[i]));
+        }
+    }
+
+    void u32(uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            put(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+
+    void f64(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < 8; i++) {
+            put(static_cast<unsigned char>(bits >> (8 * i)));
+        }
+    }
+
+    void flush() {
+        if (used > 0) {
+            out.write(buffer, static_cast<std::streamsize>(used));
+            used = 0;
+        }
+    }
+
+private:
+    void put(unsigned char byte) {
+        if (used == sizeof(buffer)) {
+            flush();
+        }
+        buffer[used++] = static_cast<char>(byte);
+    }
+
+    std::ostream &out;
+    char buffer[8192];
+    size_t used = 0;
+};
+
+} // namespace
+
+bool SolutionExporter::formatForPath(const std::filesystem::path &path, Format &format) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == ".csv") {
+        format = Format::Csv;
+    } else if (extension == ".json") {
+        format = Format::Json;
+    } else if (extension == ".bin") {
+        format = Format::Binary;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void SolutionExporter::write(const Solution &solution, std::ostream &out, Format format,
+                             int samples) {
+    if (solution.nodeCount() < 2 || solution.rodCount() != solution.nodeCount() - 1 ||
+        solution.lengths.size() != static_cast<size_t>(solution.rodCount()) ||
+        solution.strength.size() != static_cast<size_t>(solution.rodCount())) {
+        throw CalculationError(CalculationError::Code::NoSolution,
+                               "Нет результатов расчета для экспорта");
+    }
+    if (samples < 2) {
+        throw CalculationError(CalculationError::Code::InvalidInput,
+                               "Число сечений на стержень должно быть не меньше 2");
+    }
+
+    // Числа пишутся без потери точности и с точкой независимо от локали системы
+    std::locale locale = out.imbue(std::locale::classic());
+    std::streamsize precision = out.precision(std::numeric_limits<double>::max_digits10);
+
+    switch (format) {
+    case Format::Csv:
+        writeCsv(solution, out, samples);
+        break;
+    case Format::Json:
+        writeJson(solution, out, samples);
+        break;
+    case Format::Binary:
+        writeBinary(solution, out, samples);
+        break;
+    }
+
+    out.precision(precision);
+    out.imbue(locale);
+}
+
+void SolutionExporter::save(const Solution &solution, const std::filesystem::path &path,
+                            Format format, int samples) {
+    std::ofstream file;
+    // Крупный буфер потока: запись идет блоками, а не построчно
+    std::vector<char> buffer(1 << 16);
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.open(path, format == Format::Binary ? std::ios::out | std::ios::binary : std::ios::out);
+    if (!file) {
+        throw std::runtime_error("Не удалось сохранить файл");
+    }
+
+    write(solution, file, format, samples);
+    file.close();
+    if (file.fail()) {
+        throw std::runtime_error("Ошибка записи файла");
+    }
+}
+
+void SolutionExporter::writeCsv(const Solution &solution, std::ostream &out, int samples) {
+    int nodes = solution.nodeCount();
+    int rods = solution.rodCount();
+
+    out << "Узел;Координата (м);Перемещение (м);Напряжение (Па);Реакция (Н)\n";
+    for (int i = 0; i < nodes; i++) {
+        out << i + 1 << ';' << solution.coordinates[i] << ';' << solution.displacements[i] << ';'
+            << solution.nodalStresses[i] << ';' << solution.reactions[i] << '\n';
+    }
+
+    out << "\nСтержень;Длина (м);N(0) (Н);N(L) (Н);sigma(0) (Па);sigma(L) (Па);max |sigma| (Па);"
+           "Допустимое (Па);Использование\n";
+    for (int p = 0; p < rods; p++) {
+        const StrengthCheck &check = solution.strength[p];
+        out << p + 1 << ';' << solution.lengths[p] << ';' << solution.startForces[p] << ';'
+            << solution.forces[p] << ';' << solution.startStresses[p] << ';'
+            << solution.endStresses[p] << ';' << check.maxStress << ';' << check.allowedStress
+            << ';' << check.utilization << '\n';
+    }
+
+    out << "\nСтержень;x (м);Координата (м);N (Н);sigma (Па);u (м)\n";
+    for (int p = 0; p < rods; p++) {
+        for (int s = 0; s < samples; s++) {
+            double x = sampleX(solution.lengths[p], s, samples);
+            out << p + 1 << ';' << x << ';' << solution.coordinates[p] + x << ';'
+                << solution.forceAt(p, x) << ';' << solution.stressAt(p, x) << ';'
+                << solution.displacementAt(p, x) << '\n';
+        }
+    }
+}
+
+void SolutionExporter::writeJson(const Solution &solution, std::ostream &out, int samples) {
+    int nodes = solution.nodeCount();
+    int rods = solution.rodCount();
+    const SolveDiagnostics &diagnostics = solution.diagnostics;
+
+    out << "{\n  \"leftAnchor\": " << (solution.leftAnchor ? "true" : "false")
+        << ",\n  \"rightAnchor\": " << (solution.rightAnchor ? "true" : "false") << ",\n";
+
+    out << "  \"diagnostics\": {\"mixedPrecision\": "
+        << (diagnostics.mixedPrecision ? "true" : "false") << ", \"conditionEstimate\": ";
+    writeJsonNumber(out, diagnostics.conditionEstimate);
+    out << ", \"minPivotRatio\": ";
+    writeJsonNumber(out, diagnostics.minPivotRatio);
+    out << ", \"equilibriumResidual\": ";
+    writeJsonNumber(out, diagnostics.equilibriumResidual);
+    out << ", \"globalResidual\": ";
+    writeJsonNumber(out, diagnostics.globalResidual);
+    out << "},\n";
+
+    out << "  \"nodes\": [";
+    for (int i = 0; i < nodes; i++) {
+        out << (i > 0 ? ",\n    " : "\n    ") << "{\"node\": " << i + 1 << ", \"x\": ";
+        writeJsonNumber(out, solution.coordinates[i]);
+        out << ", \"u\": ";
+        writeJsonNumber(out, solution.displacements[i]);
+        out << ", \"sigma\": ";
+        writeJsonNumber(out, solution.nodalStresses[i]);
+        out << ", \"reaction\": ";
+        writeJsonNumber(out, solution.reactions[i]);
+        out << '}';
+    }
+    out << "\n  ],\n";
+
+    out << "  \"rods\": [";
+    for (int p = 0; p < rods; p++) {
+        const StrengthCheck &check = solution.strength[p];
+        out << (p > 0 ? ",\n    " : "\n    ") << "{\"rod\": " << p + 1 << ", \"length\": ";
+        writeJsonNumber(out, solution.lengths[p]);
+        out << ", \"N0\": ";
+        writeJsonNumber(out, solution.startForces[p]);
+        out << ", \"NL\": ";
+        writeJsonNumber(out, solution.forces[p]);
+        out << ", \"sigma0\": ";
+        writeJsonNumber(out, solution.startStresses[p]);
+        out << ", \"sigmaL\": ";
+        writeJsonNumber(out, solution.endStresses[p]);
+        out << ", \"maxStress\": ";
+        writeJsonNumber(out, check.maxStress);
+        out << ", \"allowedStress\": ";
+        writeJsonNumber(out, check.allowedStress);
+        out << ", \"utilization\": ";
+        writeJsonNumber(out, check.utilization);
+        out << '}';
+    }
+    out << "\n  ],\n";
+
+    out << "  \"fields\": [";
+    for (int p = 0; p < rods; p++) {
+        for (int s = 0; s < samples; s++) {
+            double x = sampleX(solution.lengths[p], s, samples);
+            out << (p > 0 || s > 0 ? ",\n    " : "\n    ") << "{\"rod\": " << p + 1 << ", \"x\": ";
+            writeJsonNumber(out, x);
+            out << ", \"coordinate\": ";
+            writeJsonNumber(out, solution.coordinates[p] + x);
+            out << ", \"N\": ";
+            writeJsonNumber(out, solution.forceAt(p, x));
+            out << ", \"sigma\": ";
+            writeJsonNumber(out, solution.stressAt(p, x));
+            out << ", \"u\": ";
+            writeJsonNumber(out, solution.displacementAt(p, x));
+            out << '}';
+        }
+    }
+    out << "\n  ]\n}\n";
+}
+
+void SolutionExporter::writeBinary(const Solution &solution, std::ostream &out, int samples) {
+    int nodes = solution.nodeCount();
+    int rods = solution.rodCount();
+
+    BinaryWriter writer(out);
+    writer.bytes("SAPRRES", 8); // Включая завершающий ноль
+    writer.u32(1);
+    writer.u32(static_cast<uint32_t>(nodes));
+    writer.u32(static_cast<uint32_t>(rods));
+    writer.u32(static_cast<uint32_t>(samples));
+    writer.u32((solution.leftAnchor ? 1u : 0u) | (solution.rightAnchor ? 2u : 0u));
+
+    for (const std::vector<double> *column :
+         {&solution.coordinates, &solution.displacements, &solution.nodalStresses,
+          &solution.reactions, &solution.lengths, &solution.startForces, &solution.forces,
+          &solution.startStresses, &solution.endStresses}) {
+        for (double value : *column) {
+            writer.f64(value);
+        }
+    }
+    for (const StrengthCheck &check : solution.strength) {
+        writer.f64(check.maxStress);
+    }
+    for (const StrengthCheck &check : solution.strength) {
+        writer.f64(check.allowedStress);
+    }
+    for (const StrengthCheck &check : solution.strength) {
+        writer.f64(check.utilization);
+    }
+
+    // Поля по сечениям вычисляются заново для каждого столбца, а не хранятся
+    for (int column = 0; column < 4; column++) {
+        for (int p = 0; p < rods; p++) {
+            for (int s = 0; s < samples; s++) {
+                double x = sampleX(solution.lengths[p], s, samples);
+                switch (column) {
+                case 0:
+                    writer.f64(solution.coordinates[p] + x);
+                    break;
+                case 1:
+                    writer.f64(solution.forceAt(p, x));
+                    break;
+                case 2:
+                    writer.f64(solution.stressAt(p, x));
+                    break;
+                default:
+                    writer.f64(solution.displacementAt(p, x));
+                    break;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef SOLUTIONEXPORTER_H
+#define SOLUTIONEXPORTER_H
+
+#include "solution.h"
+#include <filesystem>
+#include <ostream>
+
+// Экспорт результата расчета: узлы, стержни и поля N(x), sigma(x), u(x) в равноотстоящих
+// сечениях каждого стержня. Данные пишутся в поток по мере формирования (строка за строкой
+// или столбец за столбцом), документ целиком в памяти не собирается.
+//
+// Двоичный формат (все числа little-endian):
+//   "SAPRRES\0", uint32 версия (1), uint32 число узлов, uint32 число стержней,
+//   uint32 сечений на стержень, uint32 флаги (бит 0 - левая заделка, бит 1 - правая),
+//   затем столбцы float64 подряд:
+//   узлы     - координата, перемещение, напряжение, реакция;
+//   стержни  - длина, N(0), N(L), sigma(0), sigma(L), max |sigma|, допустимое, использование;
+//   сечения  - координата, N, sigma, u (стержень за стержнем).
+class SolutionExporter {
+public:
+    enum class Format { Csv, Json, Binary };
+
+    static constexpr int defaultSamples = 11;
+
+    // Формат по расширению (.csv, .json, .bin); false, если расширение не распознано
+    static bool formatForPath(const std::filesystem::path &path, Format &format);
+
+    // samples - число сечений на стержень, включая концы (не меньше 2)
+    static void write(const Solution &solution, std::ostream &out, Format format,
+                      int samples = defaultSamples);
+    static void save(const Solution &solution, const std::filesystem::path &path, Format format,
+                     int samples = defaultSamples);
+
+private:
+    static void writeCsv(const Solution &solution, std::ostream &out, int samples);
+    static void writeJson(const Solution &solution, std::ostream &out, int samples);
+    static void writeBinary(const Solution &solution, std::ostream &out, int samples);
+};
+
+#endif // SOLUTIONEXPORTER_H
@@ -0,0 +1,30 @@
+#include "solverworkspace.h"
+#include <cstddef>
+
+void SolverWorkspace::prepare(int size) {
+    fit(diag, size);
+    fit(off, size > 0 ? size - 1 : 0);
+    fit(rhs, size);
+    fit(stiffness, size > 0 ? size - 1 : 0);
+    fit(load, size > 0 ? size - 1 : 0);
+    fit(rodStress, size > 0 ? size - 1 : 0);
+    fit(scale, size);
+
+    if (solver.capacity() < size) {
+        allocationCount++;
+        solver.reserve(size);
+    }
+}
+
+void SolverWorkspace::prepareEstimate(int size) {
+    fit(estimate.x, size);
+    fit(estimate.y, size);
+    fit(estimate.z, size);
+}
+
+void SolverWorkspace::fit(std::vector<double> &v, int size) {
+    if (v.capacity() < static_cast<std::size_t>(size)) {
+        allocationCount++;
+    }
+    v.resize(size);
+}
@@ -0,0 +1,42 @@
+#ifndef SOLVERWORKSPACE_H
+#define SOLVERWORKSPACE_H
+
+#include "mixedprecisionsolver.h"
+#include "paralleltridiagonalsolver.h"
+#include "tridiagonalsolver.h"
+#include <vector>
+
+// Рабочие буферы решателя, сохраняемые между расчетами.
+// Повторный расчет системы того же размера не выделяет память в куче:
+// буферы только перезаполняются, а счетчик allocations() увеличивается
+// лишь тогда, когда какой-либо буфер приходится увеличивать. Выделения вне
+// рабочей области он не видит; отсутствие любых выделений в куче проверяет
+// тест src/tests/test_allocations.cpp.
+class SolverWorkspace {
+public:
+    std::vector<double> diag; // Главная диагональ матрицы жесткости
+    std::vector<double> off;  // Поддиагональ матрицы жесткости
+    std::vector<double> rhs;  // Вектор нагрузок / решение
+    std::vector<double> stiffness; // Жесткости стержней EA/L
+    std::vector<double> load;      // Узловые силы от распределенной нагрузки qL/2
+    std::vector<double> rodStress; // Напряжения в стержнях N/A
+    std::vector<double> scale;     // Масштабирование матрицы (TridiagonalSolver::equilibrate)
+    TridiagonalSolver::EstimateBuffers estimate; // Оценка обусловленности
+    TridiagonalSolver solver; // Разложение последней матрицы
+    MixedPrecisionSolver mixedSolver; // То же в режиме смешанной точности
+    ParallelTridiagonalSolver parallelSolver; // То же для длинных систем на нескольких потоках
+
+    // Подготовка буферов для системы из size узлов (содержимое не сохраняется)
+    void prepare(int size);
+    // То же для буферов оценки обусловленности
+    void prepareEstimate(int size);
+    // Изменение размера внешнего вектора (например, результатов) с учетом выделений
+    void fit(std::vector<double> &v, int size);
+
+    long long allocations() const { return allocationCount; }
+
+private:
+    long long allocationCount = 0;
+};
+
+#endif // SOLVERWORKSPACE_H
@@ -0,0 +1,89 @@
+#include "superelement.h"
+#include "solution.h"
+#include "tridiagonalsolver.h"
+
+Superelement::Superelement(const SaprProject::Substructure &substructure)
+    : bars(static_cast<int>(substructure.bars.size())) {
+    if (bars == 0 || substructure.barForces.size() != static_cast<size_t>(bars) ||
+        substructure.interiorForces.size() != static_cast<size_t>(bars - 1)) {
+        throw CalculationError(CalculationError::Code::InvalidInput,
+                               "Некорректная подконструкция");
+    }
+
+    // Жесткости EA/L и узловые силы qL/2 стержней, как в RodKernels
+    std::vector<double> stiffnesses(bars), loads(bars);
+    double totalCompliance = 0.0;
+    for (int p = 0; p < bars; p++) {
+        const SaprProject::Bar &bar = substructure.bars[p];
+        if (bar.L <= 0 || bar.A <= 0 || bar.E <= 0) {
+            throw CalculationError(CalculationError::Code::InvalidInput,
+                                   "Длина, площадь и модуль упругости должны быть положительными");
+        }
+        stiffnesses[p] = bar.E * bar.A / bar.L;
+        loads[p] = substructure.barForces[p] * bar.L / 2.0;
+        totalCompliance += 1.0 / stiffnesses[p];
+    }
+    k = 1.0 / totalCompliance;
+
+    int interior = bars - 1;
+    compliance.resize(interior);
+    double accumulated = 0.0;
+    for (int j = 0; j < interior; j++) {
+        accumulated += 1.0 / stiffnesses[j];
+        compliance[j] = accumulated / totalCompliance;
+    }
+
+    // Перемещения внутренних узлов при закрепленных концах: K_ii u0 = f_i
+    fixed.assign(interior, 0.0);
+    if (interior > 0) {
+        std::vector<double> diag(interior), off(interior - 1);
+        for (int j = 0; j < interior; j++) {
+            diag[j] = stiffnesses[j] + stiffnesses[j + 1];
+            fixed[j] = substructure.interiorForces[j] + loads[j] + loads[j + 1];
+        }
+        for (int j = 0; j + 1 < interior; j++) {
+            off[j] = -stiffnesses[j + 1];
+        }
+        TridiagonalSolver solver;
+        solver.factor(diag, off);
+        solver.solve(fixed);
+    }
+
+    // Реакции закрепленных концов: стержень у конца нагружен своей qL/2 и усилием от u0
+    fa = loads[0] + (interior > 0 ? stiffnesses[0] * fixed[0] : 0.0);
+    fb = loads[bars - 1] + (interior > 0 ? stiffnesses[bars - 1] * fixed[interior - 1] : 0.0);
+}
+
+void Superelement::recover(double ua, double ub, double *interior) const {
+    double delta = ub - ua;
+    for (int j = 0; j < bars - 1; j++) {
+        interior[j] = ua + delta * compliance[j] + fixed[j];
+    }
+}
+
+bool Superelement::matches(const SaprProject &project, const SaprProject::Instance &instance) {
+    if (instance.substructure < 0 ||
+        instance.substructure >= static_cast<int>(project.substructures.size())) {
+        return false;
+    }
+    const SaprProject::Substructure &substructure = project.substructures[instance.substructure];
+    size_t size = substructure.bars.size();
+    if (size == 0 || instance.firstBar < 0 || instance.firstBar + size > project.bars.size() ||
+        substructure.barForces.size() != size || substructure.interiorForces.size() + 1 != size ||
+        project.barForces.size() != project.bars.size() ||
+        project.nodeForces.size() != project.bars.size() + 1) {
+        return false;
+    }
+    for (size_t j = 0; j < size; j++) {
+        const SaprProject::Bar &bar = project.bars[instance.firstBar + j];
+        const SaprProject::Bar &reference = substructure.bars[j];
+        if (bar.L != reference.L || bar.A != reference.A || bar.E != reference.E ||
+            bar.sigma_allow != reference.sigma_allow || bar.rho != reference.rho ||
+            project.barForces[instance.firstBar + j] != substructure.barForces[j] ||
+            (j > 0 &&
+             project.nodeForces[instance.firstBar + j] != substructure.interiorForces[j - 1])) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef SUPERELEMENT_H
+#define SUPERELEMENT_H
+
+#include "saprproject.h"
+#include <vector>
+
+// Статическая конденсация подконструкции: внутренние узлы исключаются, и цепочка стержней
+// заменяется двухузловым элементом
+//   [ k  -k ] [ua]   [fa]
+//   [-k   k ] [ub] = [fb],
+// где k - жесткость последовательного соединения стержней, fa и fb - узловые силы,
+// эквивалентные нагрузкам подконструкции (реакции закрепленной по концам подконструкции
+// с обратным знаком). Конденсация выполняется один раз для всех экземпляров.
+//
+// Перемещения внутренних узлов восстанавливаются по перемещениям концов без решения системы:
+//   u_j = ua + (ub - ua) c_j + u0_j,
+// c_j - доля податливости стержней до узла j, u0_j - перемещения при закрепленных концах.
+class Superelement {
+public:
+    // CalculationError (InvalidInput) при непустых, но некорректных данных подконструкции
+    explicit Superelement(const SaprProject::Substructure &substructure);
+
+    int barCount() const { return bars; }
+    int interiorCount() const { return bars - 1; }
+    double stiffness() const { return k; }
+    double loadStart() const { return fa; }
+    double loadEnd() const { return fb; }
+
+    // Перемещения внутренних узлов (interiorCount() значений) по перемещениям концов
+    void recover(double ua, double ub, double *interior) const;
+
+    // Стержни, распределенные нагрузки и силы во внутренних узлах экземпляра в проекте
+    // совпадают с его подконструкцией
+    static bool matches(const SaprProject &project, const SaprProject::Instance &instance);
+
+private:
+    int bars;
+    double k;
+    double fa;
+    double fb;
+    std::vector<double> compliance; // c_j
+    std::vector<double> fixed;      // u0_j
+};
+
+#endif // SUPERELEMENT_H
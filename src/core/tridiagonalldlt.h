@@ -0,0 +1,119 @@
+#ifndef TRIDIAGONALLDLT_H
+#define TRIDIAGONALLDLT_H
+
+#include "scalartraits.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Разложение L D L^T симметричной трехдиагональной матрицы над скалярным типом Scalar:
+// масштабирование строк степенями двойки, исключение с проверкой ведущих элементов
+// и решение. Единственная реализация этих шагов: ими пользуются TridiagonalSolver,
+// ParallelTridiagonalSolver (внутри блоков), OutOfCoreSolver (построчно)
+// и BasicRodSystem, поэтому BasicRodSystem<double> не может разойтись с расчетом
+// RodSystemCalculator. Проверки выполняются по вещественной части (ScalarTraits).
+template <class Scalar> class TridiagonalLdlt {
+public:
+    using Traits = ScalarTraits<Scalar>;
+    using Real = typename Traits::Real;
+
+    // Ведущий элемент строки и сумма модулей величин, из которых он получен
+    struct Pivot {
+        Scalar value;
+        Real magnitude;
+    };
+
+    // Масштаб строки - степень двойки, приводящая |a_ii| к [0.25, 2).
+    // false, если элемент нулевой или не число
+    static bool rowScale(const Scalar &diag, Real &scale) {
+        Real value = Traits::real(diag);
+        if (!(std::abs(value) > Real(0)) || !std::isfinite(value)) {
+            return false;
+        }
+        int exponent;
+        std::frexp(std::abs(value), &exponent);
+        scale = std::ldexp(Real(1), -(exponent / 2));
+        return true;
+    }
+
+    // Первая строка: исключать нечего
+    static Pivot pivot(const Scalar &diag) { return {diag, std::abs(Traits::real(diag))}; }
+
+    // Строка i > 0: l = a_i,i-1 / d_i-1, pivot = a_ii - l a_i,i-1
+    static Pivot pivot(const Scalar &diag, const Scalar &offPrevious, const Scalar &dPrevious,
+                       Scalar &l) {
+        Pivot result = pivot(diag);
+        l = offPrevious / dPrevious;
+        Scalar eliminated = l * offPrevious;
+        result.value -= eliminated;
+        result.magnitude += std::abs(Traits::real(eliminated));
+        return result;
+    }
+
+    // Ведущий элемент считается нулевым, если при вычитании остались только ошибки
+    // округления. Порог относителен для каждой строки: общий порог от max|diag| ложно
+    // срабатывал на заделках (единица на диагонали) рядом с жесткими стержнями
+    // и пропускал вырождение в мягкой части системы.
+    // pivotRatio уменьшается до |pivot| / magnitude; false - элемент нулевой
+    static bool accept(const Pivot &p, Real &pivotRatio) {
+        if (p.magnitude > Real(0)) {
+            pivotRatio = std::min(pivotRatio, std::abs(Traits::real(p.value)) / p.magnitude);
+        }
+        return std::abs(Traits::real(p.value)) > tiny(p);
+    }
+
+    static Real tiny(const Pivot &p) { return p.magnitude * Traits::singularTolerance; }
+
+    // A := S A S, scale - диагональ S; false, если на диагонали нуль или не число
+    static bool equilibrate(Scalar *diag, Scalar *off, Real *scale, int size) {
+        for (int i = 0; i < size; i++) {
+            if (!rowScale(diag[i], scale[i])) {
+                return false;
+            }
+        }
+        for (int i = 0; i < size; i++) {
+            diag[i] = Scalar(scale[i]) * diag[i] * Scalar(scale[i]);
+            if (i < size - 1) {
+                off[i] = Scalar(scale[i]) * off[i] * Scalar(scale[i + 1]);
+            }
+        }
+        return true;
+    }
+
+    // Разложение: d[0..size-1], l[0..size-2]; pivotRatio - min |d_i| / magnitude.
+    // При allowSingular нулевые ведущие элементы заменяются малой величиной того же знака,
+    // иначе возвращается false
+    static bool factor(const Scalar *diag, const Scalar *off, Scalar *d, Scalar *l, int size,
+                       Real &pivotRatio, bool allowSingular = false) {
+        pivotRatio = Real(1);
+        for (int i = 0; i < size; i++) {
+            Pivot p = i > 0 ? pivot(diag[i], off[i - 1], d[i - 1], l[i - 1]) : pivot(diag[i]);
+            if (!accept(p, pivotRatio)) {
+                if (!allowSingular) {
+                    return false;
+                }
+                // Наименьшая величина, представимая в Real (1e-300 для double)
+                const Real floor = std::max(Real(1e-300), std::numeric_limits<Real>::min());
+                Real small = tiny(p) > Real(0) ? tiny(p) : floor;
+                p.value = Scalar(Traits::real(p.value) < Real(0) ? -small : small);
+            }
+            d[i] = p.value;
+        }
+        return true;
+    }
+
+    // Решение на месте по разложению: L y = b, D z = y, L^T x = z
+    static void solve(const Scalar *d, const Scalar *l, Scalar *rhs, int size) {
+        for (int i = 1; i < size; i++) {
+            rhs[i] -= l[i - 1] * rhs[i - 1];
+        }
+        for (int i = 0; i < size; i++) {
+            rhs[i] /= d[i];
+        }
+        for (int i = size - 2; i >= 0; i--) {
+            rhs[i] -= l[i] * rhs[i + 1];
+        }
+    }
+};
+
+#endif // TRIDIAGONALLDLT_H
@@ -0,0 +1,100 @@
+#include "tridiagonalsolver.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+void TridiagonalSolver::factor(const std::vector<double> &diag, const std::vector<double> &off,
+                               bool allowSingular) {
+    int size = static_cast<int>(diag.size());
+    d.assign(size, 0.0);
+    l.assign(size > 0 ? size - 1 : 0, 0.0);
+    if (!Ldlt::factor(diag.data(), off.data(), d.data(), l.data(), size, pivotRatio,
+                      allowSingular)) {
+        throw std::runtime_error("Система уравнений вырождена");
+    }
+}
+
+void TridiagonalSolver::reserve(int size) {
+    d.reserve(size);
+    l.reserve(size > 0 ? size - 1 : 0);
+}
+
+void TridiagonalSolver::solve(std::vector<double> &rhs) const {
+    Ldlt::solve(d.data(), l.data(), rhs.data(), size());
+}
+
+bool TridiagonalSolver::equilibrate(std::vector<double> &diag, std::vector<double> &off,
+                                    std::vector<double> &scale) {
+    int size = static_cast<int>(diag.size());
+    scale.resize(size);
+    return Ldlt::equilibrate(diag.data(), off.data(), scale.data(), size);
+}
+
+double TridiagonalSolver::norm1(const std::vector<double> &diag, const std::vector<double> &off) {
+    // Для симметричной матрицы норма по столбцам равна норме по строкам
+    int size = static_cast<int>(diag.size());
+    double norm = 0.0;
+    for (int i = 0; i < size; i++) {
+        double sum = std::abs(diag[i]);
+        if (i > 0) {
+            sum += std::abs(off[i - 1]);
+        }
+        if (i < size - 1) {
+            sum += std::abs(off[i]);
+        }
+        norm = std::max(norm, sum);
+    }
+    return norm;
+}
+
+double TridiagonalSolver::conditionEstimate(const std::vector<double> &diag,
+                                            const std::vector<double> &off,
+                                            EstimateBuffers &buffers) const {
+    double inverse =
+        inverseNorm1Estimate(size(), [this](std::vector<double> &v) { solve(v); }, buffers);
+    return norm1(diag, off) * inverse;
+}
+
+void TridiagonalSolver::multiply(const std::vector<double> &diag, const std::vector<double> &off,
+                                 const std::vector<double> &x, std::vector<double> &y) {
+    int size = static_cast<int>(diag.size());
+    y.assign(size, 0.0);
+
+    for (int i = 0; i < size; i++) {
+        y[i] = diag[i] * x[i];
+        if (i > 0) {
+            y[i] += off[i - 1] * x[i - 1];
+        }
+        if (i < size - 1) {
+            y[i] += off[i] * x[i + 1];
+        }
+    }
+}
+
+int TridiagonalSolver::countNegativePivots(const std::vector<double> &diag,
+                                           const std::vector<double> &off,
+                                           const std::vector<double> &mdiag,
+                                           const std::vector<double> &moff, double shift) {
+    // Закон инерции Сильвестра: число отрицательных элементов D в разложении
+    // K - shift*M = L D L^T равно числу собственных значений пучка (K, M), меньших shift
+    int size = static_cast<int>(diag.size());
+    int count = 0;
+    double prev = 1.0;
+
+    for (int i = 0; i < size; i++) {
+        double pivot = diag[i] - shift * mdiag[i];
+        if (i > 0) {
+            double b = off[i - 1] - shift * moff[i - 1];
+            pivot -= b * b / prev;
+        }
+        if (pivot == 0.0) {
+            pivot = -1e-300;
+        }
+        if (pivot < 0.0) {
+            count++;
+        }
+        prev = pivot;
+    }
+
+    return count;
+}
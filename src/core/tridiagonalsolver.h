@@ -0,0 +1,137 @@
+#ifndef TRIDIAGONALSOLVER_H
+#define TRIDIAGONALSOLVER_H
+
+#include "tridiagonalldlt.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Решатель для симметричных трехдиагональных матриц (разложение A = L D L^T).
+// Матрица задается главной диагональю diag[0..n-1] и поддиагональю off[0..n-2].
+// Разложение, решение и масштабирование - TridiagonalLdlt<double>.
+class TridiagonalSolver {
+private:
+    using Ldlt = TridiagonalLdlt<double>;
+
+    std::vector<double> d; // Диагональ D
+    std::vector<double> l; // Поддиагональ L (единичная диагональ подразумевается)
+    double pivotRatio = 1.0;
+
+public:
+    // При allowSingular нулевые ведущие элементы заменяются малой величиной
+    // (используется в обратных итерациях со сдвигом, близким к собственному значению)
+    void factor(const std::vector<double> &diag, const std::vector<double> &off,
+                bool allowSingular = false);
+    void solve(std::vector<double> &rhs) const; // Решение на месте
+
+    int size() const { return static_cast<int>(d.size()); }
+
+    // min |d_i| / (|a_ii| + |l_i-1 a_i,i-1|) последнего разложения: близость к нулю
+    // означает взаимное уничтожение при исключении и потерю значащих цифр
+    double minPivotRatio() const { return pivotRatio; }
+
+    // Предварительное выделение памяти: factor() для size <= capacity() не выделяет память
+    void reserve(int size);
+    int capacity() const { return static_cast<int>(d.capacity()); }
+
+    // y = A * x
+    static void multiply(const std::vector<double> &diag, const std::vector<double> &off,
+                         const std::vector<double> &x, std::vector<double> &y);
+
+    // Симметричное масштабирование A := S A S степенями двойки, приводящее диагональ
+    // к [0.25, 2). Умножение на степень двойки выполняется без округления, поэтому
+    // решение x = S (S A S)^-1 S b совпадает с решением исходной системы, а оценка
+    // обусловленности перестает зависеть от единиц измерения и единичных строк заделок.
+    // Возвращает false, если на диагонали есть нулевой или нечисловой элемент.
+    static bool equilibrate(std::vector<double> &diag, std::vector<double> &off,
+                            std::vector<double> &scale);
+
+    // Норма ||A||_1 трехдиагональной матрицы
+    static double norm1(const std::vector<double> &diag, const std::vector<double> &off);
+
+    // Рабочие векторы оценки обусловленности. Хранятся у вызывающей стороны
+    // (SolverWorkspace), поэтому повторные оценки того же размера не выделяют память.
+    struct EstimateBuffers {
+        std::vector<double> x, y, z;
+    };
+
+    // Оценка ||A^-1||_1 симметричной матрицы по Хейгеру - Хайэму за несколько решений
+    // с готовым разложением (обычно 2-4), то есть за O(n) для трехдиагональной матрицы.
+    // solve(v) решает систему на месте
+    template <class Solve>
+    static double inverseNorm1Estimate(int size, Solve &&solve, EstimateBuffers &buffers);
+
+    // Оценка числа обусловленности ||A||_1 ||A^-1||_1 по разложению этой же матрицы
+    double conditionEstimate(const std::vector<double> &diag, const std::vector<double> &off,
+                             EstimateBuffers &buffers) const;
+
+    // Количество отрицательных элементов D в разложении (diag - shift * mdiag, off - shift * moff)
+    static int countNegativePivots(const std::vector<double> &diag, const std::vector<double> &off,
+                                   const std::vector<double> &mdiag,
+                                   const std::vector<double> &moff, double shift);
+};
+
+template <class Solve>
+double TridiagonalSolver::inverseNorm1Estimate(int size, Solve &&solve,
+                                               EstimateBuffers &buffers) {
+    if (size <= 0) {
+        return 0.0;
+    }
+
+    auto norm = [](const std::vector<double> &v) {
+        double sum = 0.0;
+        for (double value : v) {
+            sum += std::abs(value);
+        }
+        return sum;
+    };
+
+    // Алгоритм Хейгера: максимизация ||A^-1 x||_1 на единичном шаре нормы 1.
+    // Матрица симметрична, поэтому A^-T = A^-1 и нужен только один решатель.
+    std::vector<double> &x = buffers.x;
+    std::vector<double> &y = buffers.y;
+    std::vector<double> &z = buffers.z;
+    x.assign(size, 1.0 / size);
+    y.resize(size);
+    z.resize(size);
+    double estimate = 0.0;
+
+    for (int iter = 0; iter < 5; iter++) {
+        std::copy(x.begin(), x.end(), y.begin());
+        solve(y);
+        estimate = std::max(estimate, norm(y));
+
+        for (int i = 0; i < size; i++) {
+            z[i] = y[i] >= 0.0 ? 1.0 : -1.0;
+        }
+        solve(z);
+
+        int j = 0;
+        double zx = 0.0;
+        for (int i = 0; i < size; i++) {
+            zx += z[i] * x[i];
+            if (std::abs(z[i]) > std::abs(z[j])) {
+                j = i;
+            }
+        }
+        // Локальный максимум достигнут
+        if (std::abs(z[j]) <= zx) {
+            break;
+        }
+
+        std::fill(x.begin(), x.end(), 0.0);
+        x[j] = 1.0;
+    }
+
+    // Дополнительный вектор Хайэма с чередующимися знаками страхует от неудачных случаев
+    for (int i = 0; i < size; i++) {
+        double sign = (i % 2 == 0) ? 1.0 : -1.0;
+        x[i] = sign * (1.0 + (size > 1 ? static_cast<double>(i) / (size - 1) : 0.0));
+    }
+    solve(x);
+    estimate = std::max(estimate, 2.0 * norm(x) / (3.0 * size));
+
+    return estimate;
+}
+
+#endif // TRIDIAGONALSOLVER_H
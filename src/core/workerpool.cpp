@@ -0,0 +1,64 @@
+#include "workerpool.h"
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::run(int count, void (*invoke)(void *, int), void *data) {
+    if (count <= 1) {
+        if (count == 1) {
+            invoke(data, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Новые потоки начинают со следующего задания
+        while (static_cast<int>(workers.size()) < count - 1) {
+            int id = static_cast<int>(workers.size());
+            workers.emplace_back([this, id, seen = generation] { work(id, seen); });
+        }
+        task = invoke;
+        context = data;
+        taskCount = count;
+        remaining = count - 1;
+        generation++;
+    }
+    wake.notify_all();
+
+    invoke(data, 0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return remaining == 0; });
+}
+
+void WorkerPool::work(int id, long long seen) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) {
+            return;
+        }
+        seen = generation;
+        // Поток id выполняет часть id + 1 (часть 0 - у вызывающего потока)
+        if (id + 1 >= taskCount) {
+            continue;
+        }
+        void (*invoke)(void *, int) = task;
+        void *data = context;
+        lock.unlock();
+        invoke(data, id + 1);
+        lock.lock();
+        if (--remaining == 0) {
+            done.notify_one();
+        }
+    }
+}
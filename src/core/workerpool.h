@@ -0,0 +1,44 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Постоянные рабочие потоки для коротких параллельных участков (блоки
+// ParallelTridiagonalSolver). Потоки создаются при первой необходимости и живут
+// вместе с пулом, поэтому повторные разложения и решения не создают потоков
+// и не выделяют память. Копия пула получает собственные потоки при первом запуске.
+class WorkerPool {
+public:
+    WorkerPool() = default;
+    WorkerPool(const WorkerPool &) : WorkerPool() {}
+    WorkerPool &operator=(const WorkerPool &) { return *this; }
+    ~WorkerPool();
+
+    // body(k) для k = 0..count-1: k = 0 - в вызывающем потоке, остальные - в потоках пула.
+    // Возврат после завершения всех k; вызывать из одного потока одновременно.
+    template <class Body> void run(int count, Body &body) {
+        run(count, [](void *context, int k) { (*static_cast<Body *>(context))(k); }, &body);
+    }
+
+    int threads() const { return static_cast<int>(workers.size()); }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake; // Новое задание или остановка
+    std::condition_variable done; // Все потоки задания завершили работу
+    void (*task)(void *, int) = nullptr;
+    void *context = nullptr;
+    int taskCount = 0;
+    int remaining = 0;
+    long long generation = 0; // Номер задания
+    bool stopping = false;
+
+    void run(int count, void (*invoke)(void *, int), void *data);
+    void work(int id, long long seen);
+};
+
+#endif // WORKERPOOL_H
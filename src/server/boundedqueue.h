@@ -0,0 +1,65 @@
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+// Очередь ограниченной емкости для нескольких производителей и потребителей.
+// push() ждет, пока в очереди не появится место: так переполнение очереди задач
+// останавливает чтение сокета, и клиент получает обратное давление от ядра.
+template <class T> class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : limit(capacity > 0 ? capacity : 1) {}
+
+    // false, если очередь закрыта (элемент не добавлен)
+    bool push(T &&item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [&] { return closed || items.size() < limit; });
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // false, если очередь закрыта и пуста
+    bool pop(T &item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&] { return closed || !items.empty(); });
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    // Новые элементы не принимаются; оставшиеся можно забрать через pop()
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return items.size();
+    }
+
+    size_t capacity() const { return limit; }
+
+private:
+    const size_t limit;
+    mutable std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    std::deque<T> items;
+    bool closed = false;
+};
+
+#endif // BOUNDEDQUEUE_H
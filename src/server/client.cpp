@@ -0,0 +1,183 @@
+#include "projectreader.h"
+#include "projectwriter.h"
+#include "serverprotocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Клиент mini_sapr_server для проверки и замеров: отправляет файлы .sapr (как текст или,
+// с --binary, как двоичную модель) одним потоком запросов и принимает ответы параллельно.
+// С --output результаты сохраняются в каталог в двоичном формате SolutionExporter.
+
+using namespace ServerProtocol;
+
+namespace {
+
+void printUsage() {
+    std::cerr << "Использование: sapr_client [--socket <путь>] [--binary] [--repeat N]"
+                 " [--output <каталог>] [--metrics] <файл.sapr>..."
+              << std::endl;
+}
+
+int connectTo(const std::string &path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool sendRequest(int fd, RequestKind kind, uint64_t id, const std::string &payload) {
+    Header header;
+    header.kind = static_cast<uint32_t>(kind);
+    header.id = id;
+    header.size = static_cast<uint32_t>(payload.size());
+    unsigned char raw[headerSize];
+    encodeRequest(header, raw);
+    return writeAll(fd, raw, sizeof(raw)) && writeAll(fd, payload.data(), payload.size());
+}
+
+bool receive(int fd, Header &header, std::string &payload) {
+    unsigned char raw[headerSize];
+    if (!readAll(fd, raw, sizeof(raw)) || !decodeResponse(raw, header)) {
+        return false;
+    }
+    payload.resize(header.size);
+    return header.size == 0 || readAll(fd, &payload[0], header.size);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string socketPath = "/tmp/mini_sapr_server.sock";
+    std::string outputDir;
+    bool binary = false;
+    bool showMetrics = false;
+    int repeat = 1;
+    std::vector<std::string> files;
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (size_t i = 0; i < args.size(); i++) {
+        bool hasValue = i + 1 < args.size();
+        if (args[i] == "--socket" && hasValue) {
+            socketPath = args[++i];
+        } else if (args[i] == "--output" && hasValue) {
+            outputDir = args[++i];
+        } else if (args[i] == "--repeat" && hasValue) {
+            repeat = std::max(1, std::atoi(args[++i].c_str()));
+        } else if (args[i] == "--binary") {
+            binary = true;
+        } else if (args[i] == "--metrics") {
+            showMetrics = true;
+        } else if (args[i].compare(0, 2, "--") == 0) {
+            printUsage();
+            return 2;
+        } else {
+            files.push_back(args[i]);
+        }
+    }
+    if (files.empty() && !showMetrics) {
+        printUsage();
+        return 2;
+    }
+
+    // Запросы готовятся заранее, чтобы замер включал только обмен с сервером
+    std::vector<std::string> payloads;
+    for (const std::string &name : files) {
+        std::ifstream in(std::filesystem::u8path(name), std::ios::binary);
+        if (!in) {
+            std::cerr << name << ": не удалось открыть файл" << std::endl;
+            return 1;
+        }
+        std::ostringstream content;
+        if (binary) {
+            SaprProject project;
+            std::string error;
+            if (!ProjectReader::read(in, project, &error)) {
+                std::cerr << name << ": " << error << std::endl;
+                return 1;
+            }
+            ProjectWriter::writeBinary(content, project);
+        } else {
+            content << in.rdbuf();
+        }
+        payloads.push_back(content.str());
+    }
+
+    int fd = connectTo(socketPath);
+    if (fd < 0) {
+        std::cerr << "Нет соединения с " << socketPath << std::endl;
+        return 1;
+    }
+
+    RequestKind kind = binary ? RequestKind::BinaryModel : RequestKind::SaprText;
+    uint64_t total = static_cast<uint64_t>(payloads.size()) * repeat;
+    auto start = std::chrono::steady_clock::now();
+
+    // Запросы отправляются отдельным потоком: ответы читаются, не дожидаясь конца отправки
+    std::thread sender([&] {
+        for (uint64_t id = 0; id < total; id++) {
+            if (!sendRequest(fd, kind, id, payloads[id % payloads.size()])) {
+                return;
+            }
+        }
+        if (showMetrics) {
+            sendRequest(fd, RequestKind::Metrics, total, std::string());
+        }
+    });
+
+    uint64_t expected = total + (showMetrics ? 1 : 0);
+    uint64_t ok = 0, failed = 0;
+    std::string metrics;
+    Header header;
+    std::string payload;
+    for (uint64_t received = 0; received < expected && receive(fd, header, payload); received++) {
+        ResponseStatus status = static_cast<ResponseStatus>(header.kind);
+        if (status == ResponseStatus::Metrics) {
+            metrics = payload;
+            continue;
+        }
+        const std::string &name = files[header.id % files.size()];
+        if (status != ResponseStatus::Ok) {
+            failed++;
+            std::cerr << name << ": " << payload << std::endl;
+            continue;
+        }
+        ok++;
+        if (!outputDir.empty() && header.id < files.size()) {
+            std::filesystem::path out = std::filesystem::u8path(outputDir) /
+                                        std::filesystem::u8path(name).stem();
+            std::ofstream file(out.replace_extension(".bin"), std::ios::binary);
+            file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        }
+    }
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    sender.join();
+    ::close(fd);
+
+    std::cout << "Решено: " << ok << ", ошибок: " << failed << ", без ответа: "
+              << total - ok - failed << ", " << seconds * 1000.0 << " мс, "
+              << (seconds > 0 ? total / seconds : 0.0) << " задач/с" << std::endl;
+    if (!metrics.empty()) {
+        std::cout << metrics;
+    }
+    return ok == total ? 0 : 1;
+}
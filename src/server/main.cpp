@@ -0,0 +1,73 @@
+#include "solverserver.h"
+#include <algorithm>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+SolverServer *activeServer = nullptr;
+
+void handleSignal(int) {
+    if (activeServer) {
+        activeServer->stop();
+    }
+}
+
+void printUsage() {
+    std::cerr << "Использование: mini_sapr_server [--socket <путь>] [--threads N] [--queue N]"
+                 " [--samples N] [--max-samples N]"
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    SolverServer::Settings settings;
+    settings.socketPath = "/tmp/mini_sapr_server.sock";
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (size_t i = 0; i < args.size(); i++) {
+        bool hasValue = i + 1 < args.size();
+        try {
+            if (args[i] == "--socket" && hasValue) {
+                settings.socketPath = args[++i];
+            } else if (args[i] == "--threads" && hasValue) {
+                settings.threads = std::stoi(args[++i]);
+            } else if (args[i] == "--queue" && hasValue) {
+                settings.queueCapacity = std::stoi(args[++i]);
+            } else if (args[i] == "--samples" && hasValue) {
+                settings.samples = std::max(2, std::stoi(args[++i]));
+            } else if (args[i] == "--max-samples" && hasValue) {
+                settings.maxSamples = std::max(2, std::stoi(args[++i]));
+            } else {
+                printUsage();
+                return 2;
+            }
+        } catch (const std::exception &) {
+            std::cerr << "Некорректное значение: " << args[i] << std::endl;
+            return 2;
+        }
+    }
+
+    settings.samples = std::min(settings.samples, settings.maxSamples);
+    SolverServer server(settings);
+    std::string error;
+    if (!server.start(&error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    activeServer = &server;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::cerr << "mini_sapr_server: " << settings.socketPath << std::endl;
+    server.run();
+    activeServer = nullptr;
+
+    std::cerr << server.metricsJson();
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "servermetrics.h"
+#include <algorithm>
+#include <locale>
+#include <sstream>
+
+void LatencyHistogram::add(std::chrono::steady_clock::duration duration) {
+    int64_t us = std::max<int64_t>(
+        0, std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    int bucket = 0;
+    while (bucket + 1 < bucketCount && (int64_t(1) << (bucket + 1)) <= us) {
+        bucket++;
+    }
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sumUs.fetch_add(us, std::memory_order_relaxed);
+
+    int64_t previous = maxUs.load(std::memory_order_relaxed);
+    while (us > previous && !maxUs.compare_exchange_weak(previous, us)) {
+    }
+}
+
+double LatencyHistogram::meanMs() const {
+    int64_t n = count();
+    return n > 0 ? sumUs.load(std::memory_order_relaxed) / 1000.0 / n : 0.0;
+}
+
+double LatencyHistogram::maxMs() const { return maxUs.load(std::memory_order_relaxed) / 1000.0; }
+
+double LatencyHistogram::percentileMs(double fraction) const {
+    int64_t n = count();
+    if (n == 0) {
+        return 0.0;
+    }
+    int64_t rank = static_cast<int64_t>(fraction * (n - 1)) + 1;
+    int64_t seen = 0;
+    for (int i = 0; i < bucketCount; i++) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(double(int64_t(1) << (i + 1)) / 1000.0, maxMs());
+        }
+    }
+    return maxMs();
+}
+
+void ServerMetrics::notePeak(int64_t depth) {
+    int64_t previous = queuePeak.load(std::memory_order_relaxed);
+    while (depth > previous && !queuePeak.compare_exchange_weak(previous, depth)) {
+    }
+}
+
+std::string ServerMetrics::json(int64_t queueDepth, int64_t queueCapacity, int threads) const {
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    auto histogram = [&](const char *name, const LatencyHistogram &h) {
+        out << "\"" << name << "\": {\"count\": " << h.count() << ", \"mean\": " << h.meanMs()
+            << ", \"p50\": " << h.percentileMs(0.5) << ", \"p95\": " << h.percentileMs(0.95)
+            << ", \"p99\": " << h.percentileMs(0.99) << ", \"max\": " << h.maxMs() << "}";
+    };
+
+    double uptime =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    out << "{\"uptime_s\": " << uptime << ", \"threads\": " << threads
+        << ",\n \"connections\": {\"open\": " << connectionsOpen.load()
+        << ", \"total\": " << connectionsTotal.load() << "}"
+        << ",\n \"jobs\": {\"received\": " << received.load()
+        << ", \"completed\": " << completed.load() << ", \"failed\": " << failed.load()
+        << ", \"rejected\": " << rejected.load() << "}"
+        << ",\n \"queue\": {\"depth\": " << queueDepth << ", \"peak\": " << queuePeak.load()
+        << ", \"capacity\": " << queueCapacity << "}"
+        << ",\n \"latency_ms\": {";
+    histogram("wait", wait);
+    out << ", ";
+    histogram("service", service);
+    out << ", ";
+    histogram("total", total);
+    out << "}}\n";
+    return out.str();
+}
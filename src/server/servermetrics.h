@@ -0,0 +1,49 @@
+#ifndef SERVERMETRICS_H
+#define SERVERMETRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Распределение задержек без блокировок: корзины по степеням двойки в микросекундах
+// (корзина i - от 2^i до 2^(i+1) мкс). Процентили оцениваются верхней границей корзины.
+class LatencyHistogram {
+public:
+    void add(std::chrono::steady_clock::duration duration);
+
+    int64_t count() const { return total.load(std::memory_order_relaxed); }
+    double meanMs() const;
+    double maxMs() const;
+    double percentileMs(double fraction) const;
+
+private:
+    static constexpr int bucketCount = 40;
+    std::array<std::atomic<int64_t>, bucketCount> buckets{};
+    std::atomic<int64_t> total{0};
+    std::atomic<int64_t> sumUs{0};
+    std::atomic<int64_t> maxUs{0};
+};
+
+// Показатели сервера: соединения, задачи, глубина очереди и задержки
+struct ServerMetrics {
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+
+    std::atomic<int64_t> connectionsOpen{0};
+    std::atomic<int64_t> connectionsTotal{0};
+    std::atomic<int64_t> received{0};  // Задачи, принятые в очередь
+    std::atomic<int64_t> completed{0}; // Решенные успешно
+    std::atomic<int64_t> failed{0};    // Ошибки разбора или расчета
+    std::atomic<int64_t> rejected{0};  // Неверный заголовок или слишком большой запрос
+    std::atomic<int64_t> queuePeak{0};
+
+    LatencyHistogram wait;    // От постановки в очередь до начала расчета
+    LatencyHistogram service; // Разбор, расчет и формирование результата
+    LatencyHistogram total;   // От постановки в очередь до отправки ответа
+
+    void notePeak(int64_t depth);
+    std::string json(int64_t queueDepth, int64_t queueCapacity, int threads) const;
+};
+
+#endif // SERVERMETRICS_H
@@ -0,0 +1,105 @@
+#include "serverprotocol.h"
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ServerProtocol {
+
+namespace {
+
+void putU32(unsigned char *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+void putU64(unsigned char *out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+uint32_t getU32(const unsigned char *in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t getU64(const unsigned char *in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+void encode(const char *magic, const Header &header, unsigned char *out) {
+    std::memcpy(out, magic, 4);
+    putU32(out + 4, header.kind);
+    putU64(out + 8, header.id);
+    putU32(out + 16, header.size);
+    putU32(out + 20, header.samples);
+}
+
+bool decode(const char *magic, const unsigned char *in, Header &header) {
+    if (std::memcmp(in, magic, 4) != 0) {
+        return false;
+    }
+    header.kind = getU32(in + 4);
+    header.id = getU64(in + 8);
+    header.size = getU32(in + 16);
+    header.samples = getU32(in + 20);
+    return true;
+}
+
+} // namespace
+
+void encodeRequest(const Header &header, unsigned char *out) { encode("SAPQ", header, out); }
+
+void encodeResponse(const Header &header, unsigned char *out) { encode("SAPS", header, out); }
+
+bool decodeRequest(const unsigned char *in, Header &header) { return decode("SAPQ", in, header); }
+
+bool decodeResponse(const unsigned char *in, Header &header) { return decode("SAPS", in, header); }
+
+bool readAll(int fd, void *data, size_t size) {
+    char *bytes = static_cast<char *>(data);
+    while (size > 0) {
+        ssize_t count = ::read(fd, bytes, size);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        bytes += count;
+        size -= static_cast<size_t>(count);
+    }
+    return true;
+}
+
+bool writeAll(int fd, const void *data, size_t size) {
+    const char *bytes = static_cast<const char *>(data);
+    while (size > 0) {
+        // MSG_NOSIGNAL: закрытый клиентом сокет не завершает процесс сигналом SIGPIPE
+#ifdef MSG_NOSIGNAL
+        ssize_t count = ::send(fd, bytes, size, MSG_NOSIGNAL);
+#else
+        ssize_t count = ::send(fd, bytes, size, 0);
+#endif
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        bytes += count;
+        size -= static_cast<size_t>(count);
+    }
+    return true;
+}
+
+} // namespace ServerProtocol
@@ -0,0 +1,49 @@
+#ifndef SERVERPROTOCOL_H
+#define SERVERPROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Протокол mini_sapr_server поверх потокового Unix-сокета. Клиент отправляет запросы
+// подряд, не дожидаясь ответов; ответы приходят по мере готовности, в любом порядке,
+// и сопоставляются с запросами по номеру id. Все числа заголовка little-endian.
+//
+// Запрос:  "SAPQ", uint32 вид, uint64 id, uint32 длина данных, uint32 сечений на стержень
+//          (0 - по умолчанию), затем данные.
+// Ответ:   "SAPS", uint32 состояние, uint64 id, uint32 длина данных, uint32 0, затем данные:
+//          Ok - результат в двоичном формате SolutionExporter, Error - текст ошибки (UTF-8),
+//          Metrics - показатели сервера в JSON.
+namespace ServerProtocol {
+
+enum class RequestKind : uint32_t {
+    SaprText = 1,    // Содержимое файла .sapr
+    BinaryModel = 2, // Двоичная модель ProjectWriter::writeBinary
+    Metrics = 3      // Запрос показателей (без данных, в очередь не ставится)
+};
+
+enum class ResponseStatus : uint32_t { Ok = 0, Error = 1, Metrics = 2 };
+
+constexpr size_t headerSize = 24;
+constexpr uint32_t maxPayload = 256u << 20; // Запросы больше отклоняются вместе с соединением
+
+struct Header {
+    uint32_t kind = 0; // RequestKind или ResponseStatus
+    uint64_t id = 0;
+    uint32_t size = 0;
+    uint32_t samples = 0;
+};
+
+void encodeRequest(const Header &header, unsigned char *out);
+void encodeResponse(const Header &header, unsigned char *out);
+// false, если сигнатура не совпадает
+bool decodeRequest(const unsigned char *in, Header &header);
+bool decodeResponse(const unsigned char *in, Header &header);
+
+// Полные чтение и запись с повтором после прерывания сигналом; false - соединение закрыто
+bool readAll(int fd, void *data, size_t size);
+bool writeAll(int fd, const void *data, size_t size);
+
+} // namespace ServerProtocol
+
+#endif // SERVERPROTOCOL_H
@@ -0,0 +1,272 @@
+#include "solverserver.h"
+#include "projectreader.h"
+#include "rodsystembatch.h"
+#include "rodsystemcalculator.h"
+#include "solutionexporter.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace ServerProtocol;
+
+struct SolverServer::Connection {
+    explicit Connection(int fd) : fd(fd) {}
+    // Сокет закрывается, когда отправлен ответ на последнюю задачу соединения
+    ~Connection() { ::close(fd); }
+
+    int fd;
+    std::mutex writeMutex; // Ответы разных рабочих потоков не перемешиваются
+    bool broken = false;   // Клиент отключился: ответы больше не отправляются
+    std::atomic<bool> finished{false}; // Чтение запросов завершено
+};
+
+SolverServer::SolverServer(const Settings &settings)
+    : settings(settings), queue(static_cast<size_t>(std::max(1, settings.queueCapacity))) {
+    threadCount = settings.threads > 0
+                      ? settings.threads
+                      : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+SolverServer::~SolverServer() {
+    stop();
+    reapReaders(true);
+    queue.close();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    for (int fd : {listenFd, wakeFds[0], wakeFds[1]}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+bool SolverServer::start(std::string *error) {
+    auto fail = [&](const std::string &message) {
+        if (error) {
+            *error = message + ": " + std::strerror(errno);
+        }
+        return false;
+    };
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (settings.socketPath.empty() || settings.socketPath.size() >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return fail("Некорректный путь сокета");
+    }
+    std::memcpy(address.sun_path, settings.socketPath.c_str(), settings.socketPath.size() + 1);
+
+    if (::pipe(wakeFds) != 0) {
+        return fail("Не удалось создать канал");
+    }
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        return fail("Не удалось создать сокет");
+    }
+    // Сокет, оставшийся от прежнего запуска, заменяется
+    ::unlink(settings.socketPath.c_str());
+    if (::bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        return fail("Не удалось открыть " + settings.socketPath);
+    }
+    if (::listen(listenFd, SOMAXCONN) != 0) {
+        return fail("Не удалось открыть " + settings.socketPath);
+    }
+
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([this] { work(); });
+    }
+    return true;
+}
+
+void SolverServer::stop() {
+    if (wakeFds[1] >= 0) {
+        char byte = 0;
+        ssize_t ignored = ::write(wakeFds[1], &byte, 1);
+        (void)ignored;
+    }
+}
+
+void SolverServer::run() {
+    pollfd fds[2] = {{listenFd, POLLIN, 0}, {wakeFds[0], POLLIN, 0}};
+    while (true) {
+        int ready = ::poll(fds, 2, -1);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready < 0 || (fds[1].revents & POLLIN)) {
+            break;
+        }
+        if (!(fds[0].revents & POLLIN)) {
+            continue;
+        }
+
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        reapReaders(false);
+        metrics.connectionsOpen++;
+        metrics.connectionsTotal++;
+
+        auto connection = std::make_shared<Connection>(fd);
+        readers.push_back({connection, std::thread()});
+        readers.back().thread = std::thread([this, connection] { readRequests(connection); });
+    }
+
+    // Новые соединения и запросы не принимаются; принятые задачи дорешиваются
+    ::close(listenFd);
+    listenFd = -1;
+    ::unlink(settings.socketPath.c_str());
+    for (Reader &reader : readers) {
+        ::shutdown(reader.connection->fd, SHUT_RD);
+    }
+    reapReaders(true);
+    queue.close();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+void SolverServer::reapReaders(bool all) {
+    for (auto it = readers.begin(); it != readers.end();) {
+        if (all || it->connection->finished) {
+            it->thread.join();
+            it = readers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::string SolverServer::metricsJson() const {
+    return metrics.json(static_cast<int64_t>(queue.size()),
+                        static_cast<int64_t>(queue.capacity()), threadCount);
+}
+
+void SolverServer::readRequests(const std::shared_ptr<Connection> &connection) {
+    unsigned char raw[headerSize];
+    while (readAll(connection->fd, raw, sizeof(raw))) {
+        Header header;
+        if (!decodeRequest(raw, header) || header.size > maxPayload) {
+            // После неверного заголовка границы следующих запросов неизвестны
+            metrics.rejected++;
+            respond(*connection, ResponseStatus::Error, header.id,
+                    "Неверный заголовок или слишком большой запрос");
+            break;
+        }
+
+        Job job;
+        job.header = header;
+        job.payload.resize(header.size);
+        if (header.size > 0 && !readAll(connection->fd, &job.payload[0], header.size)) {
+            break;
+        }
+
+        RequestKind kind = static_cast<RequestKind>(header.kind);
+        if (kind == RequestKind::Metrics) {
+            respond(*connection, ResponseStatus::Metrics, header.id, metricsJson());
+            continue;
+        }
+        if (kind != RequestKind::SaprText && kind != RequestKind::BinaryModel) {
+            metrics.rejected++;
+            respond(*connection, ResponseStatus::Error, header.id, "Неизвестный вид запроса");
+            continue;
+        }
+        if (header.samples > static_cast<uint32_t>(std::max(2, settings.maxSamples))) {
+            metrics.rejected++;
+            respond(*connection, ResponseStatus::Error, header.id,
+                    "Слишком много сечений на стержень");
+            continue;
+        }
+
+        job.connection = connection;
+        job.enqueued = std::chrono::steady_clock::now();
+        metrics.received++;
+        // При заполненной очереди поток ждет здесь и не читает сокет
+        if (!queue.push(std::move(job))) {
+            break;
+        }
+        metrics.notePeak(static_cast<int64_t>(queue.size()));
+    }
+    metrics.connectionsOpen--;
+    connection->finished = true;
+}
+
+bool SolverServer::respond(Connection &connection, ResponseStatus status, uint64_t id,
+                           const std::string &payload) {
+    Header header;
+    header.kind = static_cast<uint32_t>(status);
+    header.id = id;
+    header.size = static_cast<uint32_t>(payload.size());
+    unsigned char raw[headerSize];
+    encodeResponse(header, raw);
+
+    std::lock_guard<std::mutex> lock(connection.writeMutex);
+    if (connection.broken) {
+        return false;
+    }
+    if (!writeAll(connection.fd, raw, sizeof(raw)) ||
+        !writeAll(connection.fd, payload.data(), payload.size())) {
+        connection.broken = true;
+    }
+    return !connection.broken;
+}
+
+void SolverServer::work() {
+    // Рабочая область калькулятора и буфер результата живут все время работы потока
+    RodSystemCalculator calculator(1);
+    calculator.setLogging(false);
+    calculator.setThreads(1); // Иначе каждый рабочий поток запускал бы потоки по числу ядер
+    std::ostringstream result;
+    SaprProject project;
+
+    Job job;
+    while (queue.pop(job)) {
+        auto started = std::chrono::steady_clock::now();
+        metrics.wait.add(started - job.enqueued);
+
+        ResponseStatus status = ResponseStatus::Error;
+        std::string payload;
+        try {
+            std::istringstream in(job.payload);
+            std::string error;
+            bool parsed = static_cast<RequestKind>(job.header.kind) == RequestKind::BinaryModel
+                              ? ProjectReader::readBinary(in, project, &error)
+                              : ProjectReader::read(in, project, &error);
+            if (parsed) {
+                error = RodSystemBatch::validate(project);
+            }
+            if (!error.empty()) {
+                payload = error;
+            } else {
+                calculator.load(project);
+                Solution solution = calculator.solve(project.leftAnchor, project.rightAnchor);
+                int samples = job.header.samples >= 2 ? static_cast<int>(job.header.samples)
+                                                      : settings.samples;
+                result.str(std::string());
+                SolutionExporter::write(solution, result, SolutionExporter::Format::Binary,
+                                        samples);
+                payload = result.str();
+                status = ResponseStatus::Ok;
+            }
+        } catch (const std::exception &e) {
+            payload = e.what();
+        }
+        (status == ResponseStatus::Ok ? metrics.completed : metrics.failed)++;
+        metrics.service.add(std::chrono::steady_clock::now() - started);
+
+        respond(*job.connection, status, job.header.id, payload);
+        metrics.total.add(std::chrono::steady_clock::now() - job.enqueued);
+        job = Job(); // Соединение не удерживается до следующей задачи
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef SOLVERSERVER_H
+#define SOLVERSERVER_H
+
+#include "boundedqueue.h"
+#include "servermetrics.h"
+#include "serverprotocol.h"
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Долгоживущий сервер расчета на Unix-сокете (протокол в serverprotocol.h).
+// Каждое соединение читает свой поток запросов и ставит задачи в общую очередь
+// ограниченной емкости; рабочие потоки решают их, каждый своим RodSystemCalculator,
+// буферы которого переиспользуются от задачи к задаче, и сразу отправляют ответ.
+// При заполненной очереди чтение запросов приостанавливается (обратное давление).
+// Калькуляторы рабочих потоков однопоточные: параллельность сервера - по задачам.
+class SolverServer {
+public:
+    struct Settings {
+        std::string socketPath;
+        int threads = 0;          // 0 - по числу ядер
+        int queueCapacity = 1024; // Задач в очереди, не считая решаемых
+        int samples = 11;         // Сечений на стержень, если запрос не задает свое
+        // Наибольшее число сечений в запросе: размер ответа растет с ним линейно,
+        // запросы с большим значением отклоняются
+        int maxSamples = 1001;
+    };
+
+    explicit SolverServer(const Settings &settings);
+    ~SolverServer();
+
+    // Создание сокета и запуск рабочих потоков
+    bool start(std::string *error = nullptr);
+    // Прием соединений до вызова stop(); затем дорешиваются задачи из очереди
+    void run();
+    // Можно вызывать из обработчика сигнала
+    void stop();
+
+    std::string metricsJson() const;
+
+private:
+    struct Connection;
+    struct Job {
+        std::shared_ptr<Connection> connection;
+        ServerProtocol::Header header;
+        std::string payload;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+    struct Reader {
+        std::shared_ptr<Connection> connection;
+        std::thread thread;
+    };
+
+    Settings settings;
+    int threadCount = 1;
+    int listenFd = -1;
+    int wakeFds[2] = {-1, -1}; // Канал пробуждения цикла приема из stop()
+    BoundedQueue<Job> queue;
+    std::vector<std::thread> workers;
+    std::list<Reader> readers;
+    ServerMetrics metrics;
+
+    void readRequests(const std::shared_ptr<Connection> &connection);
+    void work();
+    bool respond(Connection &connection, ServerProtocol::ResponseStatus status, uint64_t id,
+                 const std::string &payload);
+    void reapReaders(bool all);
+};
+
+#endif // SOLVERSERVER_H
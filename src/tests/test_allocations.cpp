@@ -0,0 +1,124 @@
+#include "rodsystemcalculator.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Повторные расчеты системы того же размера не должны выделять память в куче.
+// Считаются настоящие выделения: глобальный operator new заменен счетчиком,
+// а не SolverWorkspace::allocations(), который видит только рост своих буферов.
+
+namespace {
+
+std::atomic<long long> allocations{0};
+
+SaprProject chain(int bars, double scale) {
+    SaprProject project;
+    for (int i = 0; i < bars; i++) {
+        SaprProject::Bar bar;
+        bar.L = 1.0 + 0.01 * i;
+        bar.A = 1e-3 * scale;
+        bar.E = 2e11;
+        project.bars.push_back(bar);
+        project.barForces.push_back(10.0 * scale);
+    }
+    for (int i = 0; i <= bars; i++) {
+        project.nodeForces.push_back(100.0 * i);
+    }
+    return project;
+}
+
+int failures = 0;
+
+// Первый расчет выделяет буферы, следующие repeats - не должны
+template <class Body> void expectNoAllocations(const char *name, Body &&body, int repeats = 10) {
+    body();
+    long long before = allocations.load();
+    for (int r = 0; r < repeats; r++) {
+        body();
+    }
+    long long count = allocations.load() - before;
+    if (count != 0) {
+        std::fprintf(stderr, "%s: %lld выделений памяти за %d расчетов\n", name, count, repeats);
+        failures++;
+    } else {
+        std::printf("%s: без выделений памяти\n", name);
+    }
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    allocations++;
+    if (void *pointer = std::malloc(size > 0 ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { std::free(pointer); }
+
+int main() {
+    using SolverMode = RodSystemCalculator::SolverMode;
+    SaprProject project = chain(100, 1.0);
+    SaprProject other = chain(100, 2.0);
+
+    struct Case {
+        const char *name;
+        SolverMode mode;
+        bool diagnostics;
+    };
+    const Case cases[] = {{"прямой, без диагностики", SolverMode::Direct, false},
+                          {"прямой, с диагностикой", SolverMode::Direct, true},
+                          {"смешанная точность", SolverMode::MixedPrecision, true}};
+
+    for (const Case &c : cases) {
+        RodSystemCalculator calculator(project);
+        calculator.setLogging(false);
+        calculator.setSolverMode(c.mode);
+        calculator.setDiagnostics(c.diagnostics);
+        std::vector<double> u, forces, stresses;
+
+        expectNoAllocations(c.name, [&]() {
+            calculator.calculate(u, forces, stresses, true, false);
+        });
+
+        // Поочередный расчет двух моделей одного размера одним калькулятором
+        bool first = true;
+        expectNoAllocations("  load() другой модели", [&]() {
+            calculator.load(first ? other : project);
+            first = !first;
+            calculator.calculate(u, forces, stresses, true, true);
+        });
+    }
+
+    // Выборка RodSystemStochastic: расчет и проверка прочности в буферы потока
+    {
+        RodSystemCalculator calculator(project);
+        calculator.setLogging(false);
+        calculator.setDiagnostics(false);
+        calculator.setThreads(1);
+        std::vector<double> u, forces, stresses;
+        std::vector<RodSystemCalculator::StrengthCheck> checks;
+        expectNoAllocations("выборка с проверкой прочности", [&]() {
+            calculator.calculate(u, forces, stresses, true, false);
+            calculator.checkStrength(u, checks);
+        });
+    }
+
+    // Параллельный решатель: потоки блоков создаются при первом расчете и затем
+    // используются повторно, в том числе оценкой обусловленности
+    {
+        RodSystemCalculator calculator(chain(4 * ParallelTridiagonalSolver::minBlockSize, 1.0));
+        calculator.setLogging(false);
+        calculator.setThreads(4);
+        calculator.setParallelThreshold(0);
+        std::vector<double> u, forces, stresses;
+        expectNoAllocations("параллельный, с диагностикой", [&]() {
+            calculator.calculate(u, forces, stresses, true, false);
+        }, 3);
+    }
+
+    return failures == 0 ? 0 : 1;
+}
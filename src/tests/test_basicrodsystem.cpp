@@ -0,0 +1,110 @@
+#include "basicrodsystem.h"
+#include "rodsystemcalculator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+// BasicRodSystem<double> должен совпадать с прямым расчетом RodSystemCalculator побитово,
+// а производные BasicRodSystem<Dual<1>> - с сопряженной чувствительностью калькулятора.
+
+namespace {
+
+int failures = 0;
+
+void fail(const char *what, int model) {
+    std::fprintf(stderr, "модель %d: %s\n", model, what);
+    failures++;
+}
+
+bool sameBits(const std::vector<double> &a, const std::vector<double> &b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+} // namespace
+
+int main() {
+    using Response = RodSystemCalculator::Response;
+    using Parameter = RodSystemCalculator::Parameter;
+
+    std::mt19937_64 random(7);
+    std::uniform_real_distribution<double> factor(0.5, 2.0);
+    const int models = 120;
+    double maxDerivativeError = 0.0;
+    for (int t = 0; t < models; t++) {
+        int bars = 1 + t % 37;
+        SaprProject project;
+        for (int i = 0; i < bars; i++) {
+            SaprProject::Bar bar;
+            bar.L = factor(random);
+            bar.A = 1e-3 * factor(random);
+            bar.E = 2e11 * factor(random);
+            project.bars.push_back(bar);
+            project.barForces.push_back(1e3 * (factor(random) - 1.0));
+        }
+        for (int i = 0; i <= bars; i++) {
+            project.nodeForces.push_back(1e4 * (factor(random) - 1.0));
+        }
+        bool leftAnchor = true;
+        bool rightAnchor = t % 2 == 1;
+
+        RodSystemCalculator calculator(project);
+        calculator.setLogging(false);
+        calculator.setDiagnostics(false);
+        std::vector<double> u, forces, stresses;
+        calculator.calculate(u, forces, stresses, leftAnchor, rightAnchor);
+
+        BasicRodSystem<double> system(project);
+        system.solve(leftAnchor, rightAnchor);
+        if (!sameBits(u, system.getDisplacements())) {
+            fail("перемещения отличаются от RodSystemCalculator", t);
+        }
+        if (!sameBits(forces, system.getForces())) {
+            fail("усилия отличаются от RodSystemCalculator", t);
+        }
+        if (!sameBits(stresses, system.getStresses())) {
+            fail("напряжения отличаются от RodSystemCalculator", t);
+        }
+        double uMax = 0.0;
+        for (double x : u) {
+            uMax = std::max(uMax, std::abs(x));
+        }
+        for (size_t i = 0; i < u.size(); i++) {
+            double reaction = calculator.getReactions()[i];
+            if (std::abs(reaction - system.getReactions()[i]) > 1e-9 * (1.0 + std::abs(reaction))) {
+                fail("реакции отличаются от RodSystemCalculator", t);
+                break;
+            }
+        }
+
+        // du/dE_j: прямое дифференцирование против сопряженного метода
+        auto jacobian =
+            calculator.sensitivityJacobian(Response::Displacement, Parameter::ElasticModulus);
+        for (int j = 0; j < bars; j++) {
+            BasicRodSystem<Dual<1>> dual(project);
+            dual.elasticModulus(j) = Dual<1>::variable(project.bars[j].E, 0);
+            dual.solve(leftAnchor, rightAnchor);
+            // Масштаб производной: |u| / E_j
+            double unit = uMax / project.bars[j].E;
+            for (int i = 0; i <= bars; i++) {
+                double expected = jacobian[i][j];
+                double actual = dual.getDisplacements()[i].d[0];
+                double error = std::abs(actual - expected) / std::max(std::abs(expected), unit);
+                maxDerivativeError = std::max(maxDerivativeError, error);
+            }
+        }
+    }
+
+    if (!(maxDerivativeError <= 1e-10)) {
+        std::fprintf(stderr, "производные Dual<1> расходятся с sensitivityJacobian: %g\n",
+                     maxDerivativeError);
+        failures++;
+    }
+    if (failures == 0) {
+        std::printf("%d моделей: BasicRodSystem<double> совпадает с RodSystemCalculator побитово, "
+                    "погрешность производных %g\n",
+                    models, maxDerivativeError);
+    }
+    return failures == 0 ? 0 : 1;
+}
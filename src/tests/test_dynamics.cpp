@@ -0,0 +1,78 @@
+#include "rodsystemdynamics.h"
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+
+// Некорректные параметры integrateNewmark отвергаются исключением до начала расчета,
+// а не превращаются в историю из inf/NaN.
+
+namespace {
+
+int failures = 0;
+
+SaprProject chain(int bars) {
+    SaprProject project;
+    for (int i = 0; i < bars; i++) {
+        SaprProject::Bar bar;
+        bar.L = 1.0;
+        bar.A = 1e-3;
+        bar.E = 2e11;
+        bar.rho = 7800.0;
+        project.bars.push_back(bar);
+        project.barForces.push_back(0.0);
+    }
+    for (int i = 0; i <= bars; i++) {
+        project.nodeForces.push_back(i == bars ? 1000.0 : 0.0);
+    }
+    return project;
+}
+
+void expectRejected(const char *name, const RodSystemDynamics &dynamics, double dt, int steps,
+                    int outputEvery, double beta, double gamma) {
+    std::ostringstream out;
+    try {
+        dynamics.integrateNewmark(dt, steps, [](double) { return 1.0; }, out, outputEvery, beta,
+                                  gamma);
+    } catch (const std::runtime_error &) {
+        if (!out.str().empty()) {
+            std::fprintf(stderr, "%s: исключение после вывода\n", name);
+            failures++;
+        }
+        return;
+    }
+    std::fprintf(stderr, "%s: параметры не отвергнуты\n", name);
+    failures++;
+}
+
+} // namespace
+
+int main() {
+    RodSystemCalculator calculator(chain(10));
+    calculator.setLogging(false);
+    RodSystemDynamics dynamics(calculator, true, false);
+    const double dt = 1e-5;
+
+    expectRejected("dt = 0", dynamics, 0.0, 10, 1, 0.25, 0.5);
+    expectRejected("dt = NaN", dynamics, std::nan(""), 10, 1, 0.25, 0.5);
+    expectRejected("steps = 0", dynamics, dt, 0, 1, 0.25, 0.5);
+    expectRejected("outputEvery = 0", dynamics, dt, 10, 0, 0.25, 0.5);
+    expectRejected("beta = 0", dynamics, dt, 10, 1, 0.0, 0.5);
+    expectRejected("beta < 0", dynamics, dt, 10, 1, -0.25, 0.5);
+    expectRejected("gamma < 0.5", dynamics, dt, 10, 1, 0.25, 0.4);
+
+    // Допустимые параметры: конечная история
+    std::ostringstream out;
+    dynamics.integrateNewmark(dt, 10, [](double) { return 1.0; }, out, 1, 0.25, 0.5);
+    std::string text = out.str();
+    if (text.empty() || text.find("nan") != std::string::npos ||
+        text.find("inf") != std::string::npos) {
+        std::fprintf(stderr, "допустимые параметры: история пуста или не конечна\n");
+        failures++;
+    }
+
+    if (failures == 0) {
+        std::printf("integrateNewmark: некорректные параметры отвергаются\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
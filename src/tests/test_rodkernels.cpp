@@ -0,0 +1,119 @@
+#include "rodkernels.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Векторные ядра RodKernels каждого уровня, поддерживаемого процессором, сравниваются
+// побитово со скалярной эталонной таблицей на случайных массивах. Длины включают
+// хвосты от 1 до 15 элементов после целых векторов любой ширины (2, 4, 8).
+
+namespace {
+
+int failures = 0;
+
+void expectSame(const char *level, const char *kernel, int count, const std::vector<double> &a,
+                const std::vector<double> &b) {
+    if (std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) != 0) {
+        std::fprintf(stderr, "%s, %s, длина %d: результат отличается от скалярного\n", level,
+                     kernel, count);
+        failures++;
+    }
+}
+
+struct Data {
+    std::vector<double> E, A, L, q, F, u;
+};
+
+Data randomData(int count, std::mt19937_64 &random) {
+    std::uniform_real_distribution<double> factor(0.5, 2.0);
+    std::uniform_real_distribution<double> sign(-1.0, 1.0);
+    Data data;
+    for (int p = 0; p < count; p++) {
+        data.E.push_back(2e11 * factor(random));
+        data.A.push_back(1e-3 * factor(random));
+        data.L.push_back(factor(random));
+        data.q.push_back(1e3 * sign(random));
+    }
+    for (int i = 0; i <= count; i++) {
+        data.F.push_back(1e4 * sign(random));
+        data.u.push_back(1e-4 * sign(random));
+    }
+    return data;
+}
+
+// Результаты всех ядер таблицы на одних данных
+struct Results {
+    std::vector<double> k, Q, diag, off, b, N, sigma, stresses;
+};
+
+Results run(const RodKernels::Table &table, const Data &data) {
+    int count = static_cast<int>(data.E.size());
+    int nodes = count + 1;
+    Results r;
+    r.k.resize(count);
+    r.Q.resize(count);
+    r.diag.resize(nodes);
+    r.off.resize(count);
+    r.b.resize(nodes);
+    r.N.resize(count);
+    r.sigma.resize(count);
+    r.stresses.resize(nodes);
+
+    table.elementStiffness(data.E.data(), data.A.data(), data.L.data(), r.k.data(), count);
+    table.elementLoads(data.q.data(), data.L.data(), r.Q.data(), count);
+    table.assemble(r.k.data(), r.Q.data(), data.F.data(), r.diag.data(), r.off.data(),
+                   r.b.data(), nodes);
+    table.elementForces(r.k.data(), r.Q.data(), data.u.data(), r.N.data(), count);
+    table.elementStresses(r.N.data(), data.A.data(), r.sigma.data(), count);
+    table.nodalStresses(r.sigma.data(), r.stresses.data(), nodes);
+    return r;
+}
+
+} // namespace
+
+int main() {
+    using Level = RodKernels::Level;
+    std::mt19937_64 random(2024);
+
+    RodKernels::setLevel(Level::Scalar);
+    const RodKernels::Table scalar = RodKernels::table();
+
+    std::vector<int> lengths;
+    for (int count = 1; count <= 48; count++) {
+        lengths.push_back(count);
+    }
+    for (int tail = 0; tail < 16; tail++) {
+        lengths.push_back(1024 + tail);
+    }
+
+    for (Level level : {Level::SSE2, Level::AVX2, Level::AVX512}) {
+        const char *name = RodKernels::levelName(level);
+        if (static_cast<int>(level) > static_cast<int>(RodKernels::detectedLevel())) {
+            std::printf("%s: не поддерживается процессором, пропущен\n", name);
+            continue;
+        }
+        RodKernels::setLevel(level);
+        const RodKernels::Table table = RodKernels::table();
+
+        int before = failures;
+        for (int count : lengths) {
+            Data data = randomData(count, random);
+            Results expected = run(scalar, data);
+            Results actual = run(table, data);
+            expectSame(name, "elementStiffness", count, actual.k, expected.k);
+            expectSame(name, "elementLoads", count, actual.Q, expected.Q);
+            expectSame(name, "assemble (diag)", count, actual.diag, expected.diag);
+            expectSame(name, "assemble (off)", count, actual.off, expected.off);
+            expectSame(name, "assemble (b)", count, actual.b, expected.b);
+            expectSame(name, "elementForces", count, actual.N, expected.N);
+            expectSame(name, "elementStresses", count, actual.sigma, expected.sigma);
+            expectSame(name, "nodalStresses", count, actual.stresses, expected.stresses);
+        }
+        if (failures == before) {
+            std::printf("%s: совпадает со скалярной реализацией\n", name);
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}